@@ -691,6 +691,9 @@ void TierAssessmentXML(MSEBoxModel *bm, FILE *fp, char *fileName, xmlDocPtr doc,
 
     Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "UseAtlantisPGMSY", "Flag indicating whether using Atlantis version of PGMSY (1) or R version (0)", "", XML_TYPE_BOOLEAN, "0");
     Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "UseSS", "Flag indicating whether using SS for Tier 1 (1) or if using perfect info + error (0)", "", XML_TYPE_BOOLEAN, "0");
+    set_keyprm_errfn(quiet);
+    Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "SS3BinaryDump", "Flag indicating whether to also write the generated SS3 data as compact binary files each year (1) or not (0). Defaults to 0 if not given.", "", XML_TYPE_BOOLEAN, "0");
+    set_keyprm_errfn(quit);
     Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "AssessDelay", "Length of delay in the assessment process (years from data collection to RBC setting)", "", XML_TYPE_INTEGER, "2");
     Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "UseTierBuffers", "Flag indicating whether using US tier scalars (1) or not (0)", "", XML_TYPE_BOOLEAN, "0");
     Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "myTACbuffer", "Scalar applied to RBC in subsequent years of MYTAC multiyear TAC", "", XML_TYPE_FLOAT, "0");
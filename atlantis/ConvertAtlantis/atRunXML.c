@@ -79,6 +79,10 @@ void Convert_Run_To_XML(MSEBoxModel *bm, char *fileName, char *outputFileName) {
     Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "flag_pollutant_impacts", "Whether including noise and light pollution", "", XML_TYPE_BOOLEAN,"0");
 
 	Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "fishmove", "Set to 0 to turn vertebrate movement off for debugging purposes", "", XML_TYPE_BOOLEAN,"1");
+	set_keyprm_errfn(quiet);
+	Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "nthreads", "Number of threads to use in the parallelised submodels (only used if built with --enable-openmp). Defaults to 1 if not given.", "", XML_TYPE_INTEGER,"1");
+	Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "rand_seed", "Seed for the named random number streams used by each submodel (ecology, recruitment, sampling, assessment, management, economics). 0 (the default) keeps the original single random number sequence.", "", XML_TYPE_INTEGER,"0");
+	set_keyprm_errfn(quit);
 	Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "flaghemisphere", "Flag for hemisphere model is in (0 = southern; 1 = northern).", "", XML_TYPE_BOOLEAN,"0");
 
 	Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "trackAtomicRatio", "Flag to turn on tracking atomic ratios.", "", XML_TYPE_BOOLEAN,"0");
@@ -163,6 +167,10 @@ void Convert_Run_To_XML(MSEBoxModel *bm, char *fileName, char *outputFileName) {
 	Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "flagchecksize", "Periodically list relative size (tuning diagnostic)", "", XML_TYPE_BOOLEAN,"0");
 	Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "flagagecheck", "Periodically list age structure per cohort (tuning diagnostic)", "", XML_TYPE_BOOLEAN,"0");
     Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "flagdietcheck", "Whether want detailed diet output", "", XML_TYPE_BOOLEAN,"0");
+    set_keyprm_errfn(quiet);
+    Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "flagdietoutput", "Write the DietCheck output file: 0=no, 1=yes. Defaults to 1 if not given.", "", XML_TYPE_BOOLEAN,"1");
+    Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "flagmortoutput", "Write the mortality estimate output files (Mort, SpecificMort, per predator mortality and PredPropCheck): 0=no, 1=yes. Defaults to 1 if not given.", "", XML_TYPE_BOOLEAN,"1");
+    set_keyprm_errfn(quit);
     Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "flagenviro_warn", "Whether want earnings anout environmental constraints on movement recorded to the logfile ", "", XML_TYPE_BOOLEAN,"0");
    
     Util_XML_Parse_Create_Node(fp, fileName, groupingNode, "flag_mig_in_bioindx", "Whether to include biomass from migration arrays ", "", XML_TYPE_BOOLEAN,"0");
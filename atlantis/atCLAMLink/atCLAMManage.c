@@ -608,7 +608,7 @@ static void Determine_Indicator_Weightings(MSEBoxModel *bm) {
 
 		switch (CLAMManagerType) {
 		case RANDOM_MANAGER:
-			indicatorWeightings[indicatorIndex] = drandom(0.0, 1.0);
+			indicatorWeightings[indicatorIndex] = Util_Random(bm, rand_manage_id, 0.0, 1.0);
 
 			break;
 		case REACTIVE_MANAGER:
@@ -34,7 +34,8 @@ FILE * initCloseKinHSFile(MSEBoxModel *bm);
 void writeCloseKinSampFile(MSEBoxModel *bm, int year, int sp, FILE *fid);
 void writeCloseKinNcompsfiles(MSEBoxModel *bm, int year, int sp, FILE *fidPO, FILE *fidHS, double *****sim_nkin_HS, double *****sim_nkin_PO, double ****ncomps_HS_yaya, double *****ncomps_PO_syaya);
 
-int poissonRandom(double lambda);
+int poissonRandom(MSEBoxModel *bm, RandStream *rs, double lambda);
+static void CKsimulator_Work_Arrays(MSEBoxModel *bm, int sp);
 
 /******************************************************************************
 
@@ -69,37 +70,36 @@ void CKsimulator(MSEBoxModel *bm, int sp, int year){
     int nLinesCompPO = 0, nLinesCompHS = 0;
     double comps = 0, nsamps1 = 0, nsamps2 = 0;
     int nLinesKinPO = 0, nLinesKinHS = 0;
+    unsigned int rand_pass;
+    RandStream kin_rand;
     int this_min = (int)(bm->RBCestimation.RBCspeciesParam[sp][HistYrMin_id]);
     int this_maxage = (int)(bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id]);
         
-    /* Leave here for now */
-    //TODO: CHECK ORDER OF DIMENSIONS IN THESE DECLARARIONS VS THEIR USE
-    double *nsamps_y = Util_Alloc_Init_1D_Double(nsampy, 0.0);
-    double ***nsamps_sya = Util_Alloc_Init_3D_Double(bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id], nsampy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], 0.0);
+#ifdef _OPENMP
+    int ck_threads = Util_Get_Num_Threads(bm);
+#endif
+
+    /* Work arrays persist between calls (see CKsimulator_Work_Arrays), they are indexed [s][y][a][y2][a2] */
+    double *nsamps_y, ***nsamps_sya, *x, *sx, **inv_totfec_sy, ***n_sya, ****psurv_syay;
+    double *****Pr_PO_syaya, *****Pr_HS_syaya, ****Pr_HS_yaya, *****ncomps_PO_syaya, ****ncomps_HS_yaya;
+    double *****sim_nkin_PO, *****sim_nkin_HS;
+
+    CKsimulator_Work_Arrays(bm, sp);
+    nsamps_y = bm->CloseKinEst[sp].nsamps_y;
+    nsamps_sya = bm->CloseKinEst[sp].nsamps_sya;
+    x = bm->CloseKinEst[sp].x;
+    sx = bm->CloseKinEst[sp].sx;
+    inv_totfec_sy = bm->CloseKinEst[sp].inv_totfec_sy;
+    n_sya = bm->CloseKinEst[sp].n_sya;
+    psurv_syay = bm->CloseKinEst[sp].psurv_syay;
+    Pr_PO_syaya = bm->CloseKinEst[sp].Pr_PO_syaya;
+    Pr_HS_syaya = bm->CloseKinEst[sp].Pr_HS_syaya;
+    Pr_HS_yaya = bm->CloseKinEst[sp].Pr_HS_yaya;
+    ncomps_PO_syaya = bm->CloseKinEst[sp].ncomps_PO_syaya;
+    ncomps_HS_yaya = bm->CloseKinEst[sp].ncomps_HS_yaya;
+    sim_nkin_PO = bm->CloseKinEst[sp].sim_nkin_PO;
+    sim_nkin_HS = bm->CloseKinEst[sp].sim_nkin_HS;
 
-    double *x = Util_Alloc_Init_1D_Double(bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], 0.0);
-    double *sx = Util_Alloc_Init_1D_Double(bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id], 0.0);
-    double **inv_totfec_sy = Util_Alloc_Init_2D_Double(bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id], last_dy, 0.0);
-
-    double ***n_sya = Util_Alloc_Init_3D_Double(bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id], last_dy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], 0.0);
-    double ****psurv_syay = Util_Alloc_Init_4D_Double(bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id], last_dy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], last_dy, 0.0);
-    
-    double *****Pr_PO_syaya = Util_Alloc_Init_5D_Double(bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], 0.0);
-    double *****Pr_HS_syaya = Util_Alloc_Init_5D_Double(bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], 0.0);
-
-    double ****Pr_GG_yaya = Util_Alloc_Init_4D_Double(bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], 0.0);
-    double ****Pr_HS_yaya = Util_Alloc_Init_4D_Double(bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], 0.0);
-
-    double *****ncomps_PO_syaya = Util_Alloc_Init_5D_Double(bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], 0.0);
-    double ****ncomps_HS_yaya = Util_Alloc_Init_4D_Double(bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], 0.0);
-    
-    double *****Ekin_HS_syaya = Util_Alloc_Init_5D_Double(bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], 0.0);
-    double *****Ekin_PO_syaya = Util_Alloc_Init_5D_Double(bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], 0.0);
-    
-    double *****sim_nkin_PO = Util_Alloc_Init_5D_Double(bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], 0.0);
-    double *****sim_nkin_HS = Util_Alloc_Init_5D_Double(bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], bm->CloseKinEst[sp].last_sy, bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id], 0.0);
-
-    
     Util_Init_1D_Double(bm->CloseKinEst[sp].fec_expo_s, bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id], 1.0);
     Util_Init_2D_Double(bm->CloseKinEst[sp].fec_sa, bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id], bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id],  0.0);
     Util_Init_1D_Double(bm->CloseKinEst[sp].mature, bm->RBCestimation.RBCspeciesParam[sp][Nlen_id], 0.0);
@@ -320,8 +320,14 @@ void CKsimulator(MSEBoxModel *bm, int sp, int year){
     }
 
     /*** HS **/
-    for (s = 0; s < bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id]; s++){
-        for (y = bm->CloseKinEst[sp].first_sy; y < bm->CloseKinEst[sp].last_sy; y++){
+    /* Each sample year only writes its own Pr_HS_syaya[s][y] and Pr_HS_yaya[y] entries (accumulating over
+     sex in the same order as before) so the sample years are spread across threads */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(ck_threads) if(ck_threads > 1) \
+    private(s, a, b1, y2, a2, b2, demog_Pr_HSP, ap_b1, Pr_par1_was_ap_b1, Pr_par2_is_par1_if_alive)
+#endif
+    for (y = bm->CloseKinEst[sp].first_sy; y < bm->CloseKinEst[sp].last_sy; y++){
+        for (s = 0; s < bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id]; s++){
             for (a = amat; a < bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id]; a++){
                 b1 = y - a;
                 if ((b1 >= bm->CloseKinEst[sp].first_dy) && (b1 < last_dy)) {
@@ -436,19 +442,9 @@ void CKsimulator(MSEBoxModel *bm, int sp, int year){
     } // y1
         
     /*** calc_exp_kin **/
-    // Multiply probabilities by ncomps
-    for (y = bm->CloseKinEst[sp].first_sy; y < bm->CloseKinEst[sp].last_sy; y++) {    // NB skip plus-group since its earlier age is uncertain
-        for (a = 0; a < bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id]; a++) {
-            for (y2 = bm->CloseKinEst[sp].first_sy; y2 < bm->CloseKinEst[sp].last_sy; y2++) {
-                for (a2 = 0; a2 < bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id]; a2++) {
-                    for (s = 0; s < bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id]; s++) {
-                        Ekin_HS_syaya[s][y][a][y2][a2] = Pr_HS_syaya[s][y][a][y2][a2] * ncomps_HS_yaya[y][a][y2][a2]; // s is s_parent
-                        Ekin_PO_syaya[s][y][a][y2][a2] = Pr_PO_syaya[s][y][a][y2][a2] * ncomps_PO_syaya[s][y][a][y2][a2];  // s is s1, the candidate parent
-                    } // s1
-                } // a2
-            } // y2
-        } // a1
-    } // y1
+    /* Expected kin are the probabilities multiplied by ncomps. They are formed where they are used below
+     (Ekin_HS = Pr_HS_syaya * ncomps_HS_yaya, s is s_parent; Ekin_PO = Pr_PO_syaya * ncomps_PO_syaya, s is s1,
+     the candidate parent) rather than being stored as two more full size arrays */
 
     //fprintf(bm->logFile, "Time: %e %s ", bm->dayt, FunctGroupArray[sp].groupCode);
     for (s = 0; s < bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id]; s++) {
@@ -456,7 +452,7 @@ void CKsimulator(MSEBoxModel *bm, int sp, int year){
             for (a = 0; a < bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id]; a++) {
                 for (y2 = bm->CloseKinEst[sp].first_sy; y2 < bm->CloseKinEst[sp].last_sy; y2++) {
                     for (a2 = 0; a2 < bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id]; a2++) {
-                        fprintf(bm->logFile, "Ekin_HS_syaya[%d][%d][%d][%d][%d] %e ", s, y, a, y2, a2, Ekin_HS_syaya[s][y][a][y2][a2]);
+                        fprintf(bm->logFile, "Ekin_HS_syaya[%d][%d][%d][%d][%d] %e ", s, y, a, y2, a2, Pr_HS_syaya[s][y][a][y2][a2] * ncomps_HS_yaya[y][a][y2][a2]);
                     }
                     fprintf(bm->logFile, "\n");
                 }
@@ -464,19 +460,27 @@ void CKsimulator(MSEBoxModel *bm, int sp, int year){
         }
     }
     
-    /*** Draw kin pairs **/
+    /*** Draw kin pairs - with a run seed each sample year draws from its own substream of the close kin stream,
+     so the sample years are spread across threads and the draws don't depend on the thread count. Without one
+     the draws come from rand() so are kept serial and the random number sequence is unchanged **/
     nLinesKinPO = 0;
     nLinesKinHS = 0;
+    rand_pass = Util_Rand_New_Pass(bm, rand_closekin_id);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(ck_threads) if((ck_threads > 1) && (bm->rand_seed > 0)) \
+    private(s, a, y2, a2, kin_rand) reduction(+:nLinesKinPO, nLinesKinHS)
+#endif
     for (y = bm->CloseKinEst[sp].first_sy; y < bm->CloseKinEst[sp].last_sy; y++) {    // NB skip plus-group since its earlier age is uncertain
+        Util_Rand_Substream(bm, rand_closekin_id, rand_pass, (unsigned int)(y - bm->CloseKinEst[sp].first_sy), &kin_rand);
         for (a = 0; a < bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id]; a++) {
             for (y2 = bm->CloseKinEst[sp].first_sy; y2 < bm->CloseKinEst[sp].last_sy; y2++) {
                 for (a2 = 0; a2 < bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id]; a2++) {
                     for (s = 0; s < bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id]; s++) {
-                        sim_nkin_PO[s][y][a][y2][a2] = poissonRandom(Ekin_PO_syaya[s][y][a][y2][a2]);
+                        sim_nkin_PO[s][y][a][y2][a2] = poissonRandom(bm, &kin_rand, Pr_PO_syaya[s][y][a][y2][a2] * ncomps_PO_syaya[s][y][a][y2][a2]);
                         if((int) sim_nkin_PO[s][y][a][y2][a2]) {
                             nLinesKinPO++;
                         }
-                        sim_nkin_HS[s][y][a][y2][a2] = poissonRandom(Ekin_HS_syaya[s][y][a][y2][a2]);
+                        sim_nkin_HS[s][y][a][y2][a2] = poissonRandom(bm, &kin_rand, Pr_HS_syaya[s][y][a][y2][a2] * ncomps_HS_yaya[y][a][y2][a2]);
                         if((int) sim_nkin_HS[s][y][a][y2][a2]) {
                             nLinesKinHS++;
                         }
@@ -497,25 +501,85 @@ void CKsimulator(MSEBoxModel *bm, int sp, int year){
     Util_Close_Output_File(bm->CloseKinPOFile);
     Util_Close_Output_File(bm->CloseKinHSFile);
     
-    /* Clean up */
-    free1d(nsamps_y);
-    free3d(nsamps_sya);
-    free1d(x);
-    free1d(sx);
-    free2d(inv_totfec_sy);
-    free3d(n_sya);
-    free4d(psurv_syay);
-    free5d(Pr_PO_syaya);
-    free5d(Pr_HS_syaya);
-    free4d(Pr_GG_yaya);
-    free4d(Pr_HS_yaya);
-    free5d(ncomps_PO_syaya);
-    free4d(ncomps_HS_yaya);
-    free5d(Ekin_HS_syaya);
-    free5d(Ekin_PO_syaya);
-    free5d(sim_nkin_PO);
-    free5d(sim_nkin_HS);
-   
+    return;
+}
+
+/******************************************************************************
+
+CKsimulator_Work_Arrays - create the CKsimulator work arrays on the first call
+for a species and reset them on later calls, rather than allocating and freeing
+a set of sexes x years x ages x years x ages arrays every time
+
+******************************************************************************/
+static void CKsimulator_Work_Arrays(MSEBoxModel *bm, int sp) {
+    int nsexes = (int)(bm->RBCestimation.RBCspeciesParam[sp][Nsexes_id]);
+    int maxage = (int)(bm->RBCestimation.RBCspeciesParam[sp][MaxAge_id]);
+    int nyears = bm->CloseKinEst[sp].last_sy;
+    CloseKinstructure *ck = &bm->CloseKinEst[sp];
+
+    if (!ck->nsamps_y) {
+        ck->nsamps_y = Util_Alloc_Init_1D_Double(nyears, 0.0);
+        ck->nsamps_sya = Util_Alloc_Init_3D_Double(maxage, nyears, nsexes, 0.0);
+        ck->x = Util_Alloc_Init_1D_Double(maxage, 0.0);
+        ck->sx = Util_Alloc_Init_1D_Double(nsexes, 0.0);
+        ck->inv_totfec_sy = Util_Alloc_Init_2D_Double(nyears, nsexes, 0.0);
+        ck->n_sya = Util_Alloc_Init_3D_Double(maxage + 1, nyears, nsexes, 0.0);
+        ck->psurv_syay = Util_Alloc_Init_4D_Double(nyears, maxage + 1, nyears, nsexes, 0.0);
+        ck->Pr_PO_syaya = Util_Alloc_Init_5D_Double(maxage, nyears, maxage, nyears, nsexes, 0.0);
+        ck->Pr_HS_syaya = Util_Alloc_Init_5D_Double(maxage, nyears, maxage, nyears, nsexes, 0.0);
+        ck->Pr_HS_yaya = Util_Alloc_Init_4D_Double(maxage, nyears, maxage, nyears, 0.0);
+        ck->ncomps_PO_syaya = Util_Alloc_Init_5D_Double(maxage, nyears, maxage, nyears, nsexes, 0.0);
+        ck->ncomps_HS_yaya = Util_Alloc_Init_4D_Double(maxage, nyears, maxage, nyears, 0.0);
+        ck->sim_nkin_PO = Util_Alloc_Init_5D_Double(maxage, nyears, maxage, nyears, nsexes, 0.0);
+        ck->sim_nkin_HS = Util_Alloc_Init_5D_Double(maxage, nyears, maxage, nyears, nsexes, 0.0);
+        return;
+    }
+
+    Util_Init_1D_Double(ck->nsamps_y, nyears, 0.0);
+    Util_Init_3D_Double(ck->nsamps_sya, nsexes, nyears, maxage, 0.0);
+    Util_Init_1D_Double(ck->x, maxage, 0.0);
+    Util_Init_1D_Double(ck->sx, nsexes, 0.0);
+    Util_Init_2D_Double(ck->inv_totfec_sy, nsexes, nyears, 0.0);
+    Util_Init_3D_Double(ck->n_sya, nsexes, nyears, maxage + 1, 0.0);
+    Util_Init_4D_Double(ck->psurv_syay, nsexes, nyears, maxage + 1, nyears, 0.0);
+    Util_Init_5D_Double(ck->Pr_PO_syaya, nsexes, nyears, maxage, nyears, maxage, 0.0);
+    Util_Init_5D_Double(ck->Pr_HS_syaya, nsexes, nyears, maxage, nyears, maxage, 0.0);
+    Util_Init_4D_Double(ck->Pr_HS_yaya, nyears, maxage, nyears, maxage, 0.0);
+    Util_Init_5D_Double(ck->ncomps_PO_syaya, nsexes, nyears, maxage, nyears, maxage, 0.0);
+    Util_Init_4D_Double(ck->ncomps_HS_yaya, nyears, maxage, nyears, maxage, 0.0);
+    Util_Init_5D_Double(ck->sim_nkin_PO, nsexes, nyears, maxage, nyears, maxage, 0.0);
+    Util_Init_5D_Double(ck->sim_nkin_HS, nsexes, nyears, maxage, nyears, maxage, 0.0);
+
+    return;
+}
+
+/******************************************************************************
+
+CKsimulator_Free - free the CKsimulator work arrays (if the species used them)
+
+******************************************************************************/
+void CKsimulator_Free(MSEBoxModel *bm, int sp) {
+    CloseKinstructure *ck = &bm->CloseKinEst[sp];
+
+    if (!ck->nsamps_y)
+        return;
+
+    free1d(ck->nsamps_y);
+    free3d(ck->nsamps_sya);
+    free1d(ck->x);
+    free1d(ck->sx);
+    free2d(ck->inv_totfec_sy);
+    free3d(ck->n_sya);
+    free4d(ck->psurv_syay);
+    free5d(ck->Pr_PO_syaya);
+    free5d(ck->Pr_HS_syaya);
+    free4d(ck->Pr_HS_yaya);
+    free5d(ck->ncomps_PO_syaya);
+    free4d(ck->ncomps_HS_yaya);
+    free5d(ck->sim_nkin_PO);
+    free5d(ck->sim_nkin_HS);
+    ck->nsamps_y = NULL;
+
     return;
 }
 
@@ -665,18 +729,25 @@ void writeCloseKinNcompsfiles(MSEBoxModel *bm, int year, int sp, FILE *fidPO, FI
 // called by: CKSimulator()
 // created  :
 // based on: https://en.wikipedia.org/wiki/Poisson_distribution#Generating_Poisson-distributed_random_variables
+// Draws from rs (a substream of the close kin random number stream) if rand_seed is set, otherwise rand() as before.
 //
 //******************************************************************************
-int poissonRandom(double lambda) {
+int poissonRandom(MSEBoxModel *bm, RandStream *rs, double lambda) {
   int n = 0; //counter of iteration
   double limit;
   double x;  //pseudo random number
     
   limit = exp(-lambda);
-  x = (double) rand() / RAND_MAX;
+  if (bm->rand_seed > 0)
+    x = Util_Random_Substream(bm, rs, 0.0, 1.0);
+  else
+    x = (double) rand() / RAND_MAX;
   while (x > limit) {
     n++;
-    x *= (double) rand() / RAND_MAX;
+    if (bm->rand_seed > 0)
+      x *= Util_Random_Substream(bm, rs, 0.0, 1.0);
+    else
+      x *= (double) rand() / RAND_MAX;
   }
   return n;
 }
@@ -0,0 +1,198 @@
+/**
+ * \ingroup atSS3Link
+ * \file atSS3Binary.c
+ * \brief Compact binary dump of the generated SS3 data sets
+ *
+ * The data generated for SS3 (catches, discards, effort, CPUE, spawning biomass and the
+ * length and age compositions with their sample sizes) already lives in memory in
+ * bm->RBCestimation.RBCspeciesArray. When SS3BinaryDump is set in the assessment
+ * parameters a copy of it is written once a year, one file per species, so that local
+ * tools can read the data directly rather than parsing the SS3 .dat files.
+ *
+ * File layout (native byte order, all integers int32_t):
+ *
+ *   char magic[8]       "ATSS3BIN"
+ *   int32 version, year
+ *   char groupCode[32]
+ *   int32 nfleet, nreg, nstock, nyears, nsex, nlen, nage, ncomp, histYrMin, reserved
+ *   double CatchData[nfleet][nreg][nyears]
+ *   double DiscData[nfleet][nreg][nyears]
+ *   double EffortData[nfleet][nreg][nyears]
+ *   double CPUEgen[nfleet][nreg][nyears]
+ *   double SpawnBio[nstock][nreg][nyears]
+ *   int32 LFss[nfleet][nsex][nyears][ncomp]
+ *   int32 LenComp[nfleet][nsex][nyears][ncomp][nlen]
+ *   int32 AFss[nfleet][nsex][nyears][ncomp]
+ *   int32 AgeComp[nfleet][nsex][nyears][ncomp][nage]
+ *
+ * nreg and nstock include the extra "all regions"/"all stocks" entry.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sjwlib.h>
+#include <atlantisboxmodel.h>
+#include <atUtilLib.h>
+
+#define SS3_BINARY_MAGIC "ATSS3BIN"
+#define SS3_BINARY_VERSION 1
+#define SS3_BINARY_CODE_LEN 32
+#define SS3_BINARY_NCOMP 4
+
+/**
+ * Copy a [n1][n2][n3] double array into out, returning the number of values copied.
+ */
+static size_t SS3_Binary_Pack_3D_Double(double ***values, int n1, int n2, int n3, double *out) {
+	size_t k = 0;
+	int i, j;
+
+	for (i = 0; i < n1; i++) {
+		for (j = 0; j < n2; j++) {
+			memcpy(&out[k], values[i][j], sizeof(double) * (size_t) n3);
+			k += (size_t) n3;
+		}
+	}
+	return k;
+}
+
+static size_t SS3_Binary_Pack_4D_Int(int ****values, int n1, int n2, int n3, int n4, int32_t *out) {
+	size_t k = 0;
+	int i, j, l, m;
+
+	for (i = 0; i < n1; i++)
+		for (j = 0; j < n2; j++)
+			for (l = 0; l < n3; l++)
+				for (m = 0; m < n4; m++)
+					out[k++] = (int32_t) values[i][j][l][m];
+	return k;
+}
+
+static size_t SS3_Binary_Pack_5D_Int(int *****values, int n1, int n2, int n3, int n4, int n5, int32_t *out) {
+	size_t k = 0;
+	int i, j, l, m, n;
+
+	for (i = 0; i < n1; i++)
+		for (j = 0; j < n2; j++)
+			for (l = 0; l < n3; l++)
+				for (m = 0; m < n4; m++)
+					for (n = 0; n < n5; n++)
+						out[k++] = (int32_t) values[i][j][l][m][n];
+	return k;
+}
+
+/**
+ * Write the binary dump for one species. The whole file is assembled in memory and
+ * written with a single fwrite. Returns non zero on failure.
+ */
+static int Write_SS3_Binary_Species(MSEBoxModel *bm, int sp, int year) {
+	RBCarrays *data = &bm->RBCestimation.RBCspeciesArray[sp];
+	char fileName[BMSLEN];
+	char groupCode[SS3_BINARY_CODE_LEN];
+	int32_t header[12];
+	int nfleet = bm->K_num_fisheries;
+	int nreg = bm->K_num_reg + 1;
+	int nstock = bm->K_num_stocks_per_sp + 1;
+	int nyears = (int) bm->RBCestimation.RBCspeciesParam[sp][Nyears_id];
+	int nsex = bm->K_num_sexes;
+	int nlen = (int) bm->RBCestimation.RBCspeciesParam[sp][Nlen_id];
+	int nage = bm->RBCestimation.OverallMaxAge;
+	size_t nfleetSeries = (size_t) nfleet * (size_t) nreg * (size_t) nyears;
+	size_t nstockSeries = (size_t) nstock * (size_t) nreg * (size_t) nyears;
+	size_t nss = (size_t) nfleet * (size_t) nsex * (size_t) nyears * SS3_BINARY_NCOMP;
+	size_t ndouble = 4 * nfleetSeries + nstockSeries;
+	size_t nint = 2 * nss + nss * (size_t) nlen + nss * (size_t) nage;
+	size_t headerSize = sizeof(SS3_BINARY_MAGIC) - 1 + sizeof(header) + SS3_BINARY_CODE_LEN;
+	size_t totalSize = headerSize + sizeof(double) * ndouble + sizeof(int32_t) * nint;
+	unsigned char *buffer, *pos;
+	double *dvals;
+	int32_t *ivals;
+	FILE *fp;
+	int failed;
+
+	buffer = (unsigned char *) malloc(totalSize);
+	if (buffer == NULL) {
+		fprintf(stderr, "Write_SS3_Binary_Data: unable to allocate %lu bytes for %s\n", (unsigned long) totalSize, FunctGroupArray[sp].groupCode);
+		return 1;
+	}
+
+	header[0] = SS3_BINARY_VERSION;
+	header[1] = year;
+	header[2] = nfleet;
+	header[3] = nreg;
+	header[4] = nstock;
+	header[5] = nyears;
+	header[6] = nsex;
+	header[7] = nlen;
+	header[8] = nage;
+	header[9] = SS3_BINARY_NCOMP;
+	header[10] = bm->RBCestimation.HistYrMin;
+	header[11] = 0;
+
+	memset(groupCode, 0, SS3_BINARY_CODE_LEN);
+	strncpy(groupCode, FunctGroupArray[sp].groupCode, SS3_BINARY_CODE_LEN - 1);
+
+	/* Magic, then version and year, then the group code and the remaining dimensions */
+	pos = buffer;
+	memcpy(pos, SS3_BINARY_MAGIC, sizeof(SS3_BINARY_MAGIC) - 1);
+	pos += sizeof(SS3_BINARY_MAGIC) - 1;
+	memcpy(pos, header, 2 * sizeof(int32_t));
+	pos += 2 * sizeof(int32_t);
+	memcpy(pos, groupCode, SS3_BINARY_CODE_LEN);
+	pos += SS3_BINARY_CODE_LEN;
+	memcpy(pos, &header[2], sizeof(header) - 2 * sizeof(int32_t));
+	pos += sizeof(header) - 2 * sizeof(int32_t);
+
+	/* The data blocks. The header is 88 bytes so the doubles stay aligned */
+	dvals = (double *) pos;
+	dvals += SS3_Binary_Pack_3D_Double(data->CatchData, nfleet, nreg, nyears, dvals);
+	dvals += SS3_Binary_Pack_3D_Double(data->DiscData, nfleet, nreg, nyears, dvals);
+	dvals += SS3_Binary_Pack_3D_Double(data->EffortData, nfleet, nreg, nyears, dvals);
+	dvals += SS3_Binary_Pack_3D_Double(data->CPUEgen, nfleet, nreg, nyears, dvals);
+	dvals += SS3_Binary_Pack_3D_Double(data->SpawnBio, nstock, nreg, nyears, dvals);
+
+	ivals = (int32_t *) dvals;
+	ivals += SS3_Binary_Pack_4D_Int(data->LFss, nfleet, nsex, nyears, SS3_BINARY_NCOMP, ivals);
+	ivals += SS3_Binary_Pack_5D_Int(data->LenComp, nfleet, nsex, nyears, SS3_BINARY_NCOMP, nlen, ivals);
+	ivals += SS3_Binary_Pack_4D_Int(data->AFss, nfleet, nsex, nyears, SS3_BINARY_NCOMP, ivals);
+	SS3_Binary_Pack_5D_Int(data->AgeComp, nfleet, nsex, nyears, SS3_BINARY_NCOMP, nage, ivals);
+
+	sprintf(fileName, "%s_SS3_year_%d.ss3b", FunctGroupArray[sp].groupCode, year);
+	if ((fp = Util_fopen(bm, fileName, "wb")) == NULL) {
+		fprintf(stderr, "Write_SS3_Binary_Data: unable to open %s\n", fileName);
+		free(buffer);
+		return 1;
+	}
+	failed = (fwrite(buffer, 1, totalSize, fp) != totalSize);
+	if (fclose(fp) != 0)
+		failed = 1;
+	if (failed)
+		fprintf(stderr, "Write_SS3_Binary_Data: error writing %s\n", fileName);
+
+	free(buffer);
+	return failed;
+}
+
+/**
+ * Write the compact binary dump of the generated SS3 data for every assessed species.
+ * The species are independent so the files are built and written in parallel.
+ */
+void Write_SS3_Binary_Data(MSEBoxModel *bm, int year) {
+	int sp, nfailed = 0;
+#ifdef _OPENMP
+	int nthreads = Util_Get_Num_Threads(bm);
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads) if(nthreads > 1) reduction(+:nfailed)
+#endif
+	for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
+		if (FunctGroupArray[sp].speciesParams[assess_flag_id] == FALSE)
+			continue;
+		nfailed += Write_SS3_Binary_Species(bm, sp, year);
+	}
+
+	if (nfailed)
+		fprintf(bm->logFile, "Time: %e Write_SS3_Binary_Data - %d species could not be written\n", bm->dayt, nfailed);
+}
@@ -1203,7 +1203,7 @@ void GetAgeProps(MSEBoxModel *bm, int groupIndex, int id, int itype, int f, int
 //*****************************************************************************
 void GetCloseKinNum(MSEBoxModel *bm, int groupIndex, int iyr) {
     double samplesize = FunctGroupArray[groupIndex].speciesParams[samplesize_id];
-    double sexratio_var = drandom(-bm->RBCestimation.sexratio_cv, bm->RBCestimation.sexratio_cv);
+    double sexratio_var = Util_Random(bm, rand_closekin_id, -bm->RBCestimation.sexratio_cv, bm->RBCestimation.sexratio_cv);
     double sex_ratio = bm->RBCestimation.RBCspeciesParam[groupIndex][femsexratio_id] * (1.0 + sexratio_var);
     int ns, a;
     
@@ -1344,7 +1344,8 @@ void GenSample(MSEBoxModel *bm, int groupIndex, int vecsize, int nf, int r_id, i
     int Ncohorts = FunctGroupArray[groupIndex].numCohortsXnumGenes;
     int bin_size = (int)(FunctGroupArray[groupIndex].speciesParams[allometic_bin_size_id]);
     double this_totsum = 0.0;
-    double p_a, sum_p, li;
+    double p_a, li;
+    double *cumprops;
     
     Util_Init_1D_Double(bm->RBCestimation.RBCspeciesArray[groupIndex].props, (FunctGroupArray[groupIndex].numCohortsXnumGenes), 0.0);
     Util_Init_1D_Double(comp, vecsize, 0.0);
@@ -1364,6 +1365,10 @@ void GenSample(MSEBoxModel *bm, int groupIndex, int vecsize, int nf, int r_id, i
         return;
     }
     
+    // Cumulative proportions so each draw can be located by bisection
+    cumprops = Util_Alloc_Init_1D_Double(Ncohorts, 0.0);
+    Util_Cumulative_Probs(bm->RBCestimation.RBCspeciesArray[groupIndex].props, cumprops, Ncohorts);
+
     // Need samples per fishery, regions and sexes
     ns  = 0;
     l = 0;
@@ -1372,28 +1377,24 @@ void GenSample(MSEBoxModel *bm, int groupIndex, int vecsize, int nf, int r_id, i
         //printf("ns %d vs sample_size %d\n", ns, sample_size);
         
         p_a = ran3(iseed);
-        sum_p = 0.0;
-        
-        for (nc = 0; nc < Ncohorts; nc++) {
-            sum_p += bm->RBCestimation.RBCspeciesArray[groupIndex].props[nc];
-            
-             //printf("Doing cohort %d p_a %e sum_p %e\n", nc, p_a, sum_p);
 
-            if (sum_p > p_a) {
-                // assign sample to the composition results
-                li = rawsizedata[nf][r_id][s][nc][itype];
-                l = (int)floor(li / bin_size);
-                
-                // sanity check
-                if(l >= vecsize)
-                    l = vecsize - 1;
-                
-                comp[l] += 1;
-                ns++;
-               
-                break;
-            }
-        }
+        // First cohort with cumulative proportion > p_a - if none (rounding) draw again
+        nc = Util_Sample_Cumulative(cumprops, Ncohorts, p_a);
+        if (nc < 0)
+            continue;
+
+        // assign sample to the composition results
+        li = rawsizedata[nf][r_id][s][nc][itype];
+        l = (int)floor(li / bin_size);
+
+        // sanity check
+        if(l >= vecsize)
+            l = vecsize - 1;
+
+        comp[l] += 1;
+        ns++;
     }
+
+    free1d(cumprops);
 }
 
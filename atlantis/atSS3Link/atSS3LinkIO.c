@@ -25,6 +25,9 @@
 #define maxConvergCritIndex 16
 #define startOfFleetData 10
 
+/* Stdio buffer for the generated SS3 input files, large enough that each is written in one go */
+#define SS3_WRITE_BUFFER (1 << 20)
+
 static void WriteSSDat(MSEBoxModel *bm, FILE *fid, int sp, int maxyr);
 /**
  *	Read in the output from the SS3 run. Will read in the RBC (recommended biological catch) and B estimate values.
@@ -1137,12 +1140,20 @@ void WriteSS330Files(MSEBoxModel *bm, int sp, int maxyr, char *baseFolder, char
     
     char outputFileName[STRLEN];
     int versionID = 0;
+    char *writeBuffer;
+    
+    /* The files are written one after the other, so they share one stdio buffer. The many
+     * small fprintf calls then land in memory and each file reaches the disk in a single pass.
+     */
+    writeBuffer = (char *) malloc(SS3_WRITE_BUFFER);
     
     // SS dat file
     sprintf(outputFileName, "%s/%s%s.dat", baseFolder, FunctGroupArray[sp].groupCode, fileName);
     if ((fiddat = fopen(outputFileName, "w")) == NULL) {
         quit("Error opening dat file for  %s\n", FunctGroupArray[sp].groupCode);
     }
+    if (writeBuffer != NULL)
+        setvbuf(fiddat, writeBuffer, _IOFBF, SS3_WRITE_BUFFER);
 
     WriteSSDat(bm, fiddat, sp, maxyr);
     fclose(fiddat);
@@ -1152,6 +1163,8 @@ void WriteSS330Files(MSEBoxModel *bm, int sp, int maxyr, char *baseFolder, char
     if ((fidctl = fopen(outputFileName, "w")) == NULL) {
         quit("Error opening ctl control file for  %s\n", FunctGroupArray[sp].groupCode);
     }
+    if (writeBuffer != NULL)
+        setvbuf(fidctl, writeBuffer, _IOFBF, SS3_WRITE_BUFFER);
     WriteSSCtl(bm, fidctl, sp, maxyr);
     fclose(fidctl);
 
@@ -1161,8 +1174,12 @@ void WriteSS330Files(MSEBoxModel *bm, int sp, int maxyr, char *baseFolder, char
     if ((fidss = fopen(outputFileName, "w")) == NULL) {
         quit("Error opening forecast file for  %s\n", FunctGroupArray[sp].groupCode);
     }
+    if (writeBuffer != NULL)
+        setvbuf(fidss, writeBuffer, _IOFBF, SS3_WRITE_BUFFER);
     WriteSSFor(bm, fidss, sp, maxyr);
     fclose(fidss);
+    
+    free(writeBuffer);
 
     // SS starter file
     Create_Starter_File(bm, baseFolder, sp, versionID);
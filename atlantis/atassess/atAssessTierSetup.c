@@ -272,6 +272,7 @@ int Tier_Assessment_Allocate(MSEBoxModel *bm) {
         bm->CloseKinEst[groupIndex].mature = Util_Alloc_Init_1D_Double(bm->RBCestimation.RBCspeciesParam[groupIndex][Nlen_id], 0.0);
         bm->CloseKinEst[groupIndex].lengths = Util_Alloc_Init_1D_Double(bm->RBCestimation.RBCspeciesParam[groupIndex][Nlen_id], 0.0);
         bm->CloseKinEst[groupIndex].samp_prop_to = Util_Alloc_Init_3D_Double(bm->RBCestimation.RBCspeciesParam[groupIndex][MaxAge_id], bm->CloseKinEst->last_sy, bm->RBCestimation.RBCspeciesParam[groupIndex][Nsexes_id], 0.0);
+        bm->CloseKinEst[groupIndex].nsamps_y = NULL;   // CKsimulator work arrays are created on first use
         
         bm->RBCestimation.RBCspeciesArray[groupIndex].SlopeMat = Util_Alloc_Init_1D_Double(FunctGroupArray[groupIndex].numStocks, 0.0);
         bm->RBCestimation.RBCspeciesArray[groupIndex].Mat50 = Util_Alloc_Init_1D_Double(FunctGroupArray[groupIndex].numStocks, 0.0);
@@ -825,6 +826,7 @@ int Tier_Assessment_Free(MSEBoxModel *bm) {
             free1d(bm->CloseKinEst[groupIndex].lengths);
         if(bm->CloseKinEst[groupIndex].samp_prop_to)
             free3d(bm->CloseKinEst[groupIndex].samp_prop_to);
+        CKsimulator_Free(bm, groupIndex);
 
         if (bm->RBCestimation.RBCspeciesArray[groupIndex].TSbiomass) {
             free1d(bm->RBCestimation.RBCspeciesArray[groupIndex].TSbiomass);
@@ -963,6 +963,7 @@ void readKeyTierParamXML(MSEBoxModel *bm, char *fileName, xmlNodePtr rootnode) {
 	/* Now allocate the rest of the memory */
     bm->RBCestimation.UseAtlantisPGMSY = (int) (Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 1, groupingNode, binary_check, "UseAtlantisPGMSY"));
 	bm->RBCestimation.UseSS = (int) (Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 1, groupingNode, binary_check, "UseSS"));
+    bm->RBCestimation.SS3BinaryDump = (int) (Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 0, groupingNode, binary_check, "SS3BinaryDump"));
     bm->RBCestimation.AssessDelay = (int) (Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 1, groupingNode, integer_check, "AssessDelay"));
     bm->RBCestimation.UseTierBuffers = (int) (Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 1, groupingNode, binary_check, "UseTierBuffers"));
     bm->RBCestimation.myTACbuffer = (int) (Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 1, groupingNode, no_checking, "myTACbuffer"));
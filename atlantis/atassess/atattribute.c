@@ -460,7 +460,7 @@ void Charismatic_Attributes(MSEBoxModel *bm, FILE *ofp) {
                     if (nsubages < 1)
                         nsubages = 1;
 					for (naa = 0; naa < nsubages; naa++) {
-						double v = drandom(0.0, 1.0);
+						double v = Util_Random(bm, rand_survey_id, 0.0, 1.0);
 						/* Assume animal uniformly distributed in age class - may not be right! */
 						//cage = (int) (floor((chrt + v) * FunctGroupArray[sp].ageClassSize + 0.5));
 
@@ -854,7 +854,7 @@ void Fish_Attributes(MSEBoxModel *bm, FILE *ofp) {
 					for (naa = 0; naa < nsubages; naa++) {
 						/* Assume animal uniformly distributed in age class - may not be right! */
 						//TODO Check with beth about changing to a round instead of a floor.
-						cage = (int) (round((chrt + drandom(0.0, 1.0)) * FunctGroupArray[sp].ageClassSize + 0.5));
+						cage = (int) (round((chrt + Util_Random(bm, rand_survey_id, 0.0, 1.0)) * FunctGroupArray[sp].ageClassSize + 0.5));
 						ninsubage = nraw / nsubages;
 						Length_Age_Key(bm, z, indx, cmaxsize, lngth, cage, cmaxage, ninsubage, attrib_id);
 
@@ -67,7 +67,8 @@ static void PerfectKnowSummary(MSEBoxModel *bm, int sp, double assess_flag_sp, d
 static void CalculateFref(MSEBoxModel *bm, int sp, FILE *ofp, int typecall);
 
 /* Percentile calculation */
-static void Calc_Percentile(double *EstToSort, double *SortedResults, int *SortRank, int nbs, int nchrt, int YrMax, FILE *ofp);
+static void Calc_Percentile(double *EstToSort, double *SortedResults, int nbs, int nchrt, int YrMax, FILE *ofp);
+static int Compare_Descending(const void *a, const void *b);
 
 /**
  * \brief This routine calls the appropriate classical assessment method (if there is one) for each fished species
@@ -80,7 +81,7 @@ void Classical_Assessment(MSEBoxModel *bm, FILE *ofp) {
 		if (FunctGroupArray[sp].isFished == TRUE) {
 
 			/* Initialise sums of squares */
-			SSmin = MAXDOUBLE;
+			bm->assessFit->SSmin = MAXDOUBLE;
 
 			flag_sp = (int) (FunctGroupArray[sp].speciesParams[flag_id]);
 
@@ -155,10 +156,13 @@ void Schafer_Production_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bo
 	/* Sums of squares */
 	double SS = MAXDOUBLE;
 	double GRD = 1.2;
+	AssessFitStruct *fit = bm->assessFit;
+	FunkArgs args;
+	void *userdata = &args;
 	/* Current year since assessment started */
 	int YrMax = (int) floor(ROUNDGUARD + ((bm->dayt - bm->tassessstart) / 365.0));
-	CTData = Util_Alloc_Init_1D_Double(YrMax + 1, 0.0);
-	ITData = Util_Alloc_Init_1D_Double(YrMax + 1, 0.0);
+	fit->CTData = Util_Alloc_Init_1D_Double(YrMax + 1, 0.0);
+	fit->ITData = Util_Alloc_Init_1D_Double(YrMax + 1, 0.0);
 
 	//fprintf(ofp,"Doing %s with YrMax: %d, ROUNDGUARD: %e, dayt: %e, tassessstart: %e, bracket: %e\n", FunctGroupArray[sp].groupCode, YrMax, ROUNDGUARD, bm->dt, bm->tassessstart, ((bm->dt - bm->tassessstart)/365.0));
 
@@ -179,18 +183,29 @@ void Schafer_Production_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bo
 	 FIX -- At present uses commerical cpue at age, when should really use survey
 	 cpue at age, but how to define survey effort so can get cpue?? */
 	for (Yr = 0; Yr < YrMax + 1; Yr++) {
-		CTData[Yr] = 0;
-		ITData[Yr] = 0;
+		fit->CTData[Yr] = 0;
+		fit->ITData[Yr] = 0;
 		yr_effort = bm->EffortRecord[Yr][sp][dataid];
 		for (age = 0; age < FunctGroupArray[sp].numCohortsXnumGenes; age++) {
-			CTData[Yr] += bm->CatchRecord[Yr][sp][age][dataid];
-			ITData[Yr] += bm->CatchRecord[Yr][sp][age][dataid] / (yr_effort + small_num);
+			fit->CTData[Yr] += bm->CatchRecord[Yr][sp][age][dataid];
+			fit->ITData[Yr] += bm->CatchRecord[Yr][sp][age][dataid] / (yr_effort + small_num);
 
-			fprintf(ofp, "Time: %e, Yr: %d, CTData: %e, ITData: %e, Catch-%s-%d: %e, yr_effort: %e\n", bm->dayt, Yr, CTData[Yr], ITData[Yr],
+			fprintf(ofp, "Time: %e, Yr: %d, CTData: %e, ITData: %e, Catch-%s-%d: %e, yr_effort: %e\n", bm->dayt, Yr, fit->CTData[Yr], fit->ITData[Yr],
 					FunctGroupArray[sp].groupCode, age, bm->CatchRecord[Yr][sp][age][dataid], yr_effort);
 		}
 	}
 
+	/* Everything the fit reads and writes is reached through args */
+	args.bm = bm;
+	args.fit = fit;
+	args.funkflag = funkflag;
+	args.sp = sp;
+	args.nchrt = FunctGroupArray[sp].numCohortsXnumGenes;
+	args.YrMax = YrMax;
+	args.prm_sp = prm_sp;
+	args.ofp = ofp;
+	args.xpar = NULL;
+
 	/* Bootstrap loop - nbs set to -1 so get one assessment loop even when not
 	 bootstrapping */
 	for (nbs = -1; nbs < bootstrap; nbs++) {
@@ -205,34 +220,28 @@ void Schafer_Production_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bo
 		 back to correct magnitudes when used in ProdCalc()
 		 */
 		for (i = est_r_id; i < est_B0_id + 1; i++) {
-			X[i] = 20.0;
+			fit->X[i] = 20.0;
 		}
 
 		/** Fit the model using Amoeba **/
 		/* Set up tolerances and gridding */
 		for (i = 0; i < Ndim; i++) {
 			for (j = 0; j < Ndim; j++) {
-				P[i][j] = X[j];
+				fit->P[i][j] = fit->X[j];
 				if (i - 1 == j)
-					P[i][j] *= GRD;
+					fit->P[i][j] *= GRD;
 			}
 		}
 
-		for (i = 0; i < Ndim; i++) {
-			for (j = 0; j < Ndim; j++) {
-				X[j] = P[i][j];
-			}
-			Y[i] = Funk(bm, funkflag, sp, (FunctGroupArray[sp].numCohortsXnumGenes), Ndim, YrMax, prm_sp, X, ofp, NULL);
-		}
+		Solve_Evaluate_Points(fit->P, fit->Y, Ndim, Ndim, Funk, &userdata, 1);
 
-		Amoeba(bm, 1, sp, bm->dayt, FunctGroupArray[sp].groupCode, P, Y, Ndim, bm->Assess_Tol, bm->Assess_Max_Int, funkflag, (FunctGroupArray[sp].numCohortsXnumGenes), YrMax,
-				prm_sp, &nfunk, &Ilow, ofp, NULL);
+		Amoeba(1, bm->dayt, FunctGroupArray[sp].groupCode, fit->P, fit->Y, Ndim, bm->Assess_Tol, bm->Assess_Max_Int, &args, &nfunk, &Ilow);
 
 		if (nfunk <= bm->Assess_Max_Int) {
 			for (j = 0; j < Ndim; j++) {
-				X[j] = P[Ilow][j];
+				fit->X[j] = fit->P[Ilow][j];
 			}
-			SS = Funk(bm, funkflag, sp, (FunctGroupArray[sp].numCohortsXnumGenes), Ndim, YrMax, prm_sp, X, ofp, NULL);
+			SS = Funk(fit->X, Ndim, &args);
 		} else
 			SS = MAXDOUBLE;
 
@@ -243,40 +252,40 @@ void Schafer_Production_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bo
 			for (i = 0; i < est_msy_id; i++) {
 				if (i == est_B_id) {
 					for (Yr = 0; Yr < YrMax + 1; Yr++) {
-						NResult[Yr][i][nbs + 1] = NEst[Yr][i];
+						fit->NResult[Yr][i][nbs + 1] = fit->NEst[Yr][i];
 
-						fprintf(ofp, "Time: %e, i: %d, nbs: %d, NEst-%d: %e\n", bm->dayt, i, nbs, Yr, NEst[Yr][i]);
+						fprintf(ofp, "Time: %e, i: %d, nbs: %d, NEst-%d: %e\n", bm->dayt, i, nbs, Yr, fit->NEst[Yr][i]);
 					}
 				} else {
-					NResult[YrMax][i][nbs + 1] = NEst[YrMax][i];
+					fit->NResult[YrMax][i][nbs + 1] = fit->NEst[YrMax][i];
 
-					fprintf(ofp, "Time: %e, i: %d, nbs: %d, NEst-YrMax: %e\n", bm->dayt, i, nbs, NEst[YrMax][i]);
+					fprintf(ofp, "Time: %e, i: %d, nbs: %d, NEst-YrMax: %e\n", bm->dayt, i, nbs, fit->NEst[YrMax][i]);
 				}
 			}
 		} else {
 			/* Assessment fails - identify this via MAXDOUBLE do can trap below */
 			for (i = 0; i < est_msy_id; i++) {
-				NResult[YrMax][i][nbs + 1] = MAXDOUBLE;
+				fit->NResult[YrMax][i][nbs + 1] = MAXDOUBLE;
 			}
 		}
 
 		/* Store residuals - as no age structure carried, store results in entry zero (0) */
 		icnt = 0;
 		for (Yr = 0; Yr < YrMax + 1; Yr++) {
-			BootResu[icnt] = Resu[Yr][0];
+			fit->BootResu[icnt] = fit->Resu[Yr][0];
 			icnt++;
 		}
 
 		/* Set up next round of bootstrap data */
 		for (Yr = 0; Yr < YrMax + 1; Yr++) {
-			ITData[Yr] = 0;
+			fit->ITData[Yr] = 0;
 			yr_effort = bm->EffortRecord[Yr][sp][dataid];
-			ipnt = (int) floor(ROUNDGUARD + (icnt * drandom(0.0, 1.0) + 1.0));
+			ipnt = (int) floor(ROUNDGUARD + (icnt * Util_Random(bm, rand_assess_id, 0.0, 1.0) + 1.0));
 			for (age = 0; age < FunctGroupArray[sp].numCohortsXnumGenes; age++) {
-				ITData[Yr] += (bm->CatchRecord[Yr][sp][age][dataid] / (yr_effort + small_num)) * exp(BootResu[ipnt]);
+				fit->ITData[Yr] += (bm->CatchRecord[Yr][sp][age][dataid] / (yr_effort + small_num)) * exp(fit->BootResu[ipnt]);
 
-				fprintf(ofp, "Time: %e, Yr: %d, NewITData: %e, Catch-%s-%d: %e, yr_effort: %e, exp: %e, BootResu: %e\n", bm->dayt, Yr, ITData[Yr],
-						FunctGroupArray[sp].groupCode, age, bm->CatchRecord[Yr][sp][age][dataid], yr_effort, (double)exp(BootResu[ipnt]), BootResu[ipnt]);
+				fprintf(ofp, "Time: %e, Yr: %d, NewITData: %e, Catch-%s-%d: %e, yr_effort: %e, exp: %e, BootResu: %e\n", bm->dayt, Yr, fit->ITData[Yr],
+						FunctGroupArray[sp].groupCode, age, bm->CatchRecord[Yr][sp][age][dataid], yr_effort, (double)exp(fit->BootResu[ipnt]), fit->BootResu[ipnt]);
 
 			}
 		}
@@ -291,11 +300,11 @@ void Schafer_Production_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bo
 	if (bootstrap > 0) {
 		/* Bootstraps to chose between */
 		for (i = 0; i < est_msy_id; i++) {
-			if ((NResult[YrMax][i][nbs + 1] < MAXDOUBLE) && ((i == est_r_id) || (i == est_K_id) || (i == est_B_id))) {
+			if ((fit->NResult[YrMax][i][nbs + 1] < MAXDOUBLE) && ((i == est_r_id) || (i == est_K_id) || (i == est_B_id))) {
 				for (j = 0; j < bootstrap; j++) {
-					ResultToSort[j] = NResult[YrMax][i][j];
+					fit->ResultToSort[j] = fit->NResult[YrMax][i][j];
 				}
-				Calc_Percentile(ResultToSort, ResultSorted, nbsSort, nbs, (FunctGroupArray[sp].numCohortsXnumGenes), YrMax, ofp);
+				Calc_Percentile(fit->ResultToSort, fit->ResultSorted, nbs, (FunctGroupArray[sp].numCohortsXnumGenes), YrMax, ofp);
 
 				/* Save the estimates for r, K, stock biomass estimate */
 				/* Get index */
@@ -321,15 +330,15 @@ void Schafer_Production_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bo
 				}
 
 				/* Median */
-				bm->NAssess[sp][indxm] = ResultSorted[med_p];
+				bm->NAssess[sp][indxm] = fit->ResultSorted[med_p];
 
 				/* Lower x percentile */
-				bm->NAssess[sp][indxb] = ResultSorted[low_p];
+				bm->NAssess[sp][indxb] = fit->ResultSorted[low_p];
 
 				/* Upper x percentile */
-				bm->NAssess[sp][indxt] = ResultSorted[high_p];
+				bm->NAssess[sp][indxt] = fit->ResultSorted[high_p];
 
-				fprintf(ofp, "Time %e, %s (i: %d vs est_B: %d) indxm: %d (%e), indxb: %d (%e), indxt: %d (%e)\n", bm->dayt, FunctGroupArray[sp].groupCode, i, est_B_id, indxm, ResultSorted[med_p], indxb, ResultSorted[low_p], indxt, ResultSorted[high_p]);
+				fprintf(ofp, "Time %e, %s (i: %d vs est_B: %d) indxm: %d (%e), indxb: %d (%e), indxt: %d (%e)\n", bm->dayt, FunctGroupArray[sp].groupCode, i, est_B_id, indxm, fit->ResultSorted[med_p], indxb, fit->ResultSorted[low_p], indxt, fit->ResultSorted[high_p]);
 			}
 
 			/* If Assessment failed don't update the values - use last valid set */
@@ -338,22 +347,22 @@ void Schafer_Production_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bo
 		/* Single estimate - if Assessment failed don't	update the values,
 		 but use last valid set */
 		/* Recruitment */
-		if (NResult[YrMax][est_r_id][0] < MAXDOUBLE) {
-			bm->NAssess[sp][est_med_recruit_id] = NResult[YrMax][est_r_id][0];
-			bm->NAssess[sp][est_top_recruit_id] = NResult[YrMax][est_r_id][0];
-			bm->NAssess[sp][est_bot_recruit_id] = NResult[YrMax][est_r_id][0];
+		if (fit->NResult[YrMax][est_r_id][0] < MAXDOUBLE) {
+			bm->NAssess[sp][est_med_recruit_id] = fit->NResult[YrMax][est_r_id][0];
+			bm->NAssess[sp][est_top_recruit_id] = fit->NResult[YrMax][est_r_id][0];
+			bm->NAssess[sp][est_bot_recruit_id] = fit->NResult[YrMax][est_r_id][0];
 		}
 		/* Carrying capacity */
-		if (NResult[YrMax][est_K_id][0] < MAXDOUBLE) {
-			bm->NAssess[sp][est_med_prm2_id] = NResult[YrMax][est_K_id][0];
-			bm->NAssess[sp][est_top_prm2_id] = NResult[YrMax][est_K_id][0];
-			bm->NAssess[sp][est_bot_prm2_id] = NResult[YrMax][est_K_id][0];
+		if (fit->NResult[YrMax][est_K_id][0] < MAXDOUBLE) {
+			bm->NAssess[sp][est_med_prm2_id] = fit->NResult[YrMax][est_K_id][0];
+			bm->NAssess[sp][est_top_prm2_id] = fit->NResult[YrMax][est_K_id][0];
+			bm->NAssess[sp][est_bot_prm2_id] = fit->NResult[YrMax][est_K_id][0];
 		}
 		/* Total biomass */
-		if (NResult[YrMax][est_B_id][0] < MAXDOUBLE) {
-			bm->NAssess[sp][est_med_stock_id] = NResult[YrMax][est_B_id][0];
-			bm->NAssess[sp][est_top_stock_id] = NResult[YrMax][est_B_id][0];
-			bm->NAssess[sp][est_bot_stock_id] = NResult[YrMax][est_B_id][0];
+		if (fit->NResult[YrMax][est_B_id][0] < MAXDOUBLE) {
+			bm->NAssess[sp][est_med_stock_id] = fit->NResult[YrMax][est_B_id][0];
+			bm->NAssess[sp][est_top_stock_id] = fit->NResult[YrMax][est_B_id][0];
+			bm->NAssess[sp][est_bot_stock_id] = fit->NResult[YrMax][est_B_id][0];
 		}
 
 		fprintf(ofp, "Time %e, %s r %e, K %e, B %e\n", bm->dayt, FunctGroupArray[sp].groupCode, bm->NAssess[sp][est_med_recruit_id],
@@ -361,7 +370,7 @@ void Schafer_Production_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bo
 
 	}
 
-	bm->NAssess[sp][est_SS_id] = SSmin;
+	bm->NAssess[sp][est_SS_id] = fit->SSmin;
 
 	/* Assessment indices of interest */
 	/*
@@ -379,8 +388,8 @@ void Schafer_Production_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bo
 
 	/* FIX - Repeat for bot and top estimates */
 
-	free1d(CTData);
-	free1d(ITData);
+	free1d(fit->CTData);
+	free1d(fit->ITData);
 	return;
 }
 
@@ -401,6 +410,9 @@ void VPA_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bootstrap, double
 	/* Sums of squares */
 	double SS = MAXDOUBLE;
 	double GRD = 1.2;
+	AssessFitStruct *fit = bm->assessFit;
+	FunkArgs args;
+	void *userdata = &args;
 	/* Number of dimensions in data arrays to be solved */
 	int Ndim = FunctGroupArray[sp].numCohortsXnumGenes;
 	/* Current year since assessment started */
@@ -419,48 +431,53 @@ void VPA_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bootstrap, double
 	for (Yr = 0; Yr < YrMax + 1; Yr++) {
 		yr_effort = bm->EffortRecord[Yr][sp][dataid];
 		for (age = 0; age < FunctGroupArray[sp].numCohortsXnumGenes; age++) {
-			CData[Yr][age] = bm->CatchRecord[Yr][sp][age][dataid];
-			IData[Yr][age] = bm->CatchRecord[Yr][sp][age][dataid] / (yr_effort + small_num);
+			fit->CData[Yr][age] = bm->CatchRecord[Yr][sp][age][dataid];
+			fit->IData[Yr][age] = bm->CatchRecord[Yr][sp][age][dataid] / (yr_effort + small_num);
 
-			fprintf(ofp, "Time: %e, Yr: %d, CData: %e, IData: %e, Catch-%s-%d: %e, yr_effort: %e\n", bm->dayt, Yr, CData[Yr][age], IData[Yr][age],
+			fprintf(ofp, "Time: %e, Yr: %d, CData: %e, IData: %e, Catch-%s-%d: %e, yr_effort: %e\n", bm->dayt, Yr, fit->CData[Yr][age], fit->IData[Yr][age],
 					FunctGroupArray[sp].groupCode, age, bm->CatchRecord[Yr][sp][age][dataid], yr_effort);
 
 		}
 	}
 
+	/* Everything the fit reads and writes is reached through args */
+	args.bm = bm;
+	args.fit = fit;
+	args.funkflag = funkflag;
+	args.sp = sp;
+	args.nchrt = FunctGroupArray[sp].numCohortsXnumGenes;
+	args.YrMax = YrMax;
+	args.prm_sp = prm_sp;
+	args.ofp = ofp;
+	args.xpar = NULL;
+
 	/* Bootstrap loop - nbs set to -1 so get one assessment loop even when not
 	 bootstrapping */
 	for (nbs = -1; nbs < bootstrap; nbs++) {
 		/* Do projections and minimise sums of squares using amoeba */
 		for (chrt = 0; chrt < FunctGroupArray[sp].numCohortsXnumGenes; chrt++) {
-			X[chrt] = 5;
+			fit->X[chrt] = 5;
 		}
 
 		/** Fit the model using Amoeba **/
 		/* Set up tolerances and gridding */
 		for (i = 0; i < Ndim; i++) {
 			for (j = 0; j < Ndim; j++) {
-				P[i][j] = X[j];
+				fit->P[i][j] = fit->X[j];
 				if (i - 1 == j)
-					P[i][j] *= GRD;
+					fit->P[i][j] *= GRD;
 			}
 		}
 
-		for (i = 0; i < Ndim; i++) {
-			for (j = 0; j < Ndim; j++) {
-				X[j] = P[i][j];
-			}
-			Y[i] = Funk(bm, funkflag, sp, (FunctGroupArray[sp].numCohortsXnumGenes), Ndim, YrMax, prm_sp, X, ofp, NULL);
-		}
+		Solve_Evaluate_Points(fit->P, fit->Y, Ndim, Ndim, Funk, &userdata, 1);
 
-		Amoeba(bm, 1, sp, bm->dayt, FunctGroupArray[sp].groupCode, P, Y, Ndim, bm->Assess_Tol, bm->Assess_Max_Int, funkflag, (FunctGroupArray[sp].numCohortsXnumGenes), YrMax,
-				prm_sp, &nfunk, &Ilow, ofp, NULL);
+		Amoeba(1, bm->dayt, FunctGroupArray[sp].groupCode, fit->P, fit->Y, Ndim, bm->Assess_Tol, bm->Assess_Max_Int, &args, &nfunk, &Ilow);
 
 		if (nfunk <= bm->Assess_Max_Int) {
 			for (j = 0; j < Ndim; j++) {
-				X[j] = P[Ilow][j];
+				fit->X[j] = fit->P[Ilow][j];
 			}
-			SS = Funk(bm, funkflag, sp, (FunctGroupArray[sp].numCohortsXnumGenes), Ndim, YrMax, prm_sp, X, ofp, NULL);
+			SS = Funk(fit->X, Ndim, &args);
 		} else
 			SS = MAXDOUBLE;
 
@@ -471,14 +488,14 @@ void VPA_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bootstrap, double
 			 management calculations and decisions */
 			for (Yr = 0; Yr < YrMax + 1; Yr++) {
 				for (age = 0; age < FunctGroupArray[sp].numCohortsXnumGenes; age++) {
-					NResult[Yr][age][nbs + 1] = NEst[Yr][age];
+					fit->NResult[Yr][age][nbs + 1] = fit->NEst[Yr][age];
 				}
 			}
 		} else {
 			/* Assessment fails - use MAXDOUBLE to indicate this so can trap for it
 			 in percentile calculation section */
 			for (age = 0; age < FunctGroupArray[sp].numCohortsXnumGenes; age++) {
-				NResult[YrMax][age][nbs + 1] = MAXDOUBLE;
+				fit->NResult[YrMax][age][nbs + 1] = MAXDOUBLE;
 			}
 		}
 
@@ -486,7 +503,7 @@ void VPA_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bootstrap, double
 		icnt = 0;
 		for (Yr = 0; Yr < YrMax + 1; Yr++) {
 			for (age = 0; age < FunctGroupArray[sp].numCohortsXnumGenes; age++) {
-				BootResu[icnt] = Resu[Yr][age];
+				fit->BootResu[icnt] = fit->Resu[Yr][age];
 				icnt++;
 			}
 		}
@@ -495,11 +512,11 @@ void VPA_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bootstrap, double
 		for (Yr = 0; Yr < YrMax + 1; Yr++) {
 			yr_effort = bm->EffortRecord[Yr][sp][dataid];
 			for (age = 0; age < FunctGroupArray[sp].numCohortsXnumGenes; age++) {
-				ipnt = (int) floor(ROUNDGUARD + (icnt * drandom(0.0, 1.0) + 1.0));
-				IData[Yr][age] = (bm->CatchRecord[Yr][sp][age][dataid] / (yr_effort + small_num)) * exp(BootResu[ipnt]);
+				ipnt = (int) floor(ROUNDGUARD + (icnt * Util_Random(bm, rand_assess_id, 0.0, 1.0) + 1.0));
+				fit->IData[Yr][age] = (bm->CatchRecord[Yr][sp][age][dataid] / (yr_effort + small_num)) * exp(fit->BootResu[ipnt]);
 
-				fprintf(ofp, "Time: %e, Yr: %d, NewIData: %e, Catch-%s-%d: %e, yr_effort: %e, exp: %e, BootResu: %e\n", bm->dayt, Yr, IData[Yr][age],
-						FunctGroupArray[sp].groupCode, age, bm->CatchRecord[Yr][sp][age][dataid], yr_effort, (double)exp(BootResu[ipnt]), BootResu[ipnt]);
+				fprintf(ofp, "Time: %e, Yr: %d, NewIData: %e, Catch-%s-%d: %e, yr_effort: %e, exp: %e, BootResu: %e\n", bm->dayt, Yr, fit->IData[Yr][age],
+						FunctGroupArray[sp].groupCode, age, bm->CatchRecord[Yr][sp][age][dataid], yr_effort, (double)exp(fit->BootResu[ipnt]), fit->BootResu[ipnt]);
 
 			}
 		}
@@ -521,12 +538,12 @@ void VPA_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bootstrap, double
 		for (i = 0; i < FunctGroupArray[sp].numCohortsXnumGenes; i++) {
 
 			/* FIX -- Only want latest estimates or over the entire assessment period ?*/
-			if (NResult[YrMax][i][nbs + 1] < MAXDOUBLE) {
+			if (fit->NResult[YrMax][i][nbs + 1] < MAXDOUBLE) {
 				for (j = 0; j < bootstrap; j++) {
-					ResultToSort[j] = NResult[YrMax][i][j];
+					fit->ResultToSort[j] = fit->NResult[YrMax][i][j];
 				}
 
-				Calc_Percentile(ResultToSort, ResultSorted, nbsSort, nbs, (FunctGroupArray[sp].numCohortsXnumGenes), YrMax, ofp);
+				Calc_Percentile(fit->ResultToSort, fit->ResultSorted, nbs, (FunctGroupArray[sp].numCohortsXnumGenes), YrMax, ofp);
 
 				/* Save the estimates for r, K, stock biomass estimate */
 				if ((i == 0) || (i == pchrt)) {
@@ -542,18 +559,18 @@ void VPA_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bootstrap, double
 					}
 
 					/* Median */
-					bm->NAssess[sp][indxm] = ResultSorted[med_p];
+					bm->NAssess[sp][indxm] = fit->ResultSorted[med_p];
 
 					/* Lower x percentile */
-					bm->NAssess[sp][indxb] = ResultSorted[low_p];
+					bm->NAssess[sp][indxb] = fit->ResultSorted[low_p];
 
 					/* Upper x percentile */
-					bm->NAssess[sp][indxt] = ResultSorted[high_p];
+					bm->NAssess[sp][indxt] = fit->ResultSorted[high_p];
 				}
 
-				top_biom += ResultSorted[high_p];
-				med_biom += ResultSorted[med_p];
-				bot_biom += ResultSorted[low_p];
+				top_biom += fit->ResultSorted[high_p];
+				med_biom += fit->ResultSorted[med_p];
+				bot_biom += fit->ResultSorted[low_p];
 			} else
 				assess_failed = 1;
 
@@ -576,21 +593,21 @@ void VPA_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bootstrap, double
 		/* Single estimate - if Assessment failed don't	update the values,
 		 but use last valid set */
 		/* Recruitment */
-		if (NResult[YrMax][est_r_id][0] < MAXDOUBLE) {
-			bm->NAssess[sp][est_med_recruit_id] = NResult[YrMax][est_r_id][0];
-			bm->NAssess[sp][est_top_recruit_id] = NResult[YrMax][est_r_id][0];
-			bm->NAssess[sp][est_bot_recruit_id] = NResult[YrMax][est_r_id][0];
+		if (fit->NResult[YrMax][est_r_id][0] < MAXDOUBLE) {
+			bm->NAssess[sp][est_med_recruit_id] = fit->NResult[YrMax][est_r_id][0];
+			bm->NAssess[sp][est_top_recruit_id] = fit->NResult[YrMax][est_r_id][0];
+			bm->NAssess[sp][est_bot_recruit_id] = fit->NResult[YrMax][est_r_id][0];
 		}
 		/* Plus group */
-		if (NResult[YrMax][pchrt][0] < MAXDOUBLE) {
-			bm->NAssess[sp][est_med_prm2_id] = NResult[YrMax][pchrt][0];
-			bm->NAssess[sp][est_top_prm2_id] = NResult[YrMax][pchrt][0];
-			bm->NAssess[sp][est_bot_prm2_id] = NResult[YrMax][pchrt][0];
+		if (fit->NResult[YrMax][pchrt][0] < MAXDOUBLE) {
+			bm->NAssess[sp][est_med_prm2_id] = fit->NResult[YrMax][pchrt][0];
+			bm->NAssess[sp][est_top_prm2_id] = fit->NResult[YrMax][pchrt][0];
+			bm->NAssess[sp][est_bot_prm2_id] = fit->NResult[YrMax][pchrt][0];
 		}
 		/* Total biomass */
 		top_biom = 0;
 		for (i = 0; i < FunctGroupArray[sp].numCohortsXnumGenes; i++) {
-			top_biom += NResult[YrMax][i][0];
+			top_biom += fit->NResult[YrMax][i][0];
 		}
 		if (top_biom < MAXDOUBLE) {
 			bm->NAssess[sp][est_med_stock_id] = top_biom;
@@ -602,7 +619,7 @@ void VPA_Assessment(MSEBoxModel *bm, int sp, int funkflag, int bootstrap, double
 	fprintf(ofp, "Time %e, %s r %e, p %e, B %e\n", bm->dayt, FunctGroupArray[sp].groupCode, bm->NAssess[sp][est_med_recruit_id],
 			bm->NAssess[sp][est_med_prm2_id], bm->NAssess[sp][est_med_stock_id]);
 
-	bm->NAssess[sp][est_SS_id] = SSmin;
+	bm->NAssess[sp][est_SS_id] = fit->SSmin;
 
 	return;
 }
@@ -1334,11 +1351,11 @@ void CalculateFref(MSEBoxModel *bm, int sp, FILE *ofp, int typecall) {
 		bm->NAssess[sp][est_CPUEnow_id] = this_CPUE;
 		bm->NAssess[sp][est_Cslope_id] = 0;
 		bm->NAssess[sp][est_numyr_id] = 1;
-		CPUEtrend[sp][0] = this_CPUE;
+		bm->assessFit->CPUEtrend[sp][0] = this_CPUE;
 	} else {
 		bm->NAssess[sp][est_CPUEnow_id] = this_CPUE;
 		ny = (int) (bm->NAssess[sp][est_numyr_id]);
-		CPUEtrend[sp][ny] = this_CPUE;
+		bm->assessFit->CPUEtrend[sp][ny] = this_CPUE;
 		bm->NAssess[sp][est_numyr_id]++;
         
 		/* Estimate slope of CPUE trend - FIX enable linear regression (check how to initialise it)
@@ -1362,30 +1379,25 @@ void CalculateFref(MSEBoxModel *bm, int sp, FILE *ofp, int typecall) {
 }
 
 /**************/
-void Calc_Percentile(double *EstToSort, double *SortedResults, int *SortRank, int nbs, int nchrt, int YrMax, FILE *ofp) {
-	int i, j, rank, indx;
-
-	/* Sort in descending order */
-	/* Initialise the sort */
-	for (j = 0; j < nbs; j++) {
-		SortRank[j] = 0;
-	}
+static int Compare_Descending(const void *a, const void *b) {
+	double da = *(const double *) a;
+	double db = *(const double *) b;
+
+	if (da > db)
+		return -1;
+	if (da < db)
+		return 1;
+	return 0;
+}
 
-	/* Do the sort */
-	for (j = 0; j < nbs; j++) {
-		rank = 0;
-		for (i = 0; i < nbs; i++) {
-			if (EstToSort[j] > EstToSort[i])
-				rank++;
-		}
-		SortRank[j] = nbs - 1 - rank;
-	}
+void Calc_Percentile(double *EstToSort, double *SortedResults, int nbs, int nchrt, int YrMax, FILE *ofp) {
+	int j;
 
-	/* Save sorted results */
+	/* Sort in descending order - copy first so EstToSort is left as is */
 	for (j = 0; j < nbs; j++) {
-		indx = SortRank[j];
-		SortedResults[indx] = EstToSort[j];
+		SortedResults[j] = EstToSort[j];
 	}
+	qsort(SortedResults, (size_t) nbs, sizeof(double), Compare_Descending);
 
 	return;
 }
@@ -1722,11 +1734,11 @@ void Assess_Pseudo_Estimate_Prm(MSEBoxModel *bm, int sp, FILE *ofp) {
 		bm->NAssess[nid][est_CPUEnow_id] = this_CPUE;
 		bm->NAssess[nid][est_Cslope_id] = 0;
 		bm->NAssess[nid][est_numyr_id] = 1;
-		CPUEtrend[nid][0] = this_CPUE;
+		bm->assessFit->CPUEtrend[nid][0] = this_CPUE;
 	} else {
 		bm->NAssess[nid][est_CPUEnow_id] = this_CPUE;
 		ny = (int) (bm->NAssess[nid][est_numyr_id]);
-		CPUEtrend[nid][ny] = this_CPUE;
+		bm->assessFit->CPUEtrend[nid][ny] = this_CPUE;
 		bm->NAssess[nid][est_numyr_id]++;
 
 		/* Estimate slope of CPUE trend */
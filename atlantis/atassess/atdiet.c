@@ -524,33 +524,34 @@ void Setup_Avail_Food(MSEBoxModel *bm, int b, FILE *ofp) {
 
 static void Multinomial(MSEBoxModel *bm, int n, double **p, int **count, int m, int numStages) {
 
-	int i, bin, j;
-	double u, lower, upper;
-
+	int i, bin, j, cell;
+	double u;
+	double *cumprob = Util_Alloc_Init_1D_Double(m * numStages, 0.0);
+
+	/* Cumulative probabilities over the bins (in the same bin then stage order as the
+	 subintervals were laid out in) so each variate can be located by bisection */
+	for (bin = 0; bin < m; bin++) {
+		for (j = 0; j < numStages; j++) {
+			cumprob[bin * numStages + j] = p[bin][j];
+		}
+	}
+	Util_Cumulative_Probs(cumprob, cumprob, m * numStages);
 
 	/* Generate n uniform variates in the interval [0,1] */
 	for (i = 0; i < n; i++) {
 
-		u = drandom(0.0, 1.0);
-
-		lower = upper = 0.0;
-
-		for(bin = 0 ; bin < m; bin++ ){
-			for (j = 0; j < numStages; j++) {
+		u = Util_Random(bm, rand_survey_id, 0.0, 1.0);
 
-			/* Locate subinterval, of length p[bin], that contains the variate
-				and increment the number in that bin */
-				lower = upper;
-				upper += p[bin][j];
-
-				if ((lower <= u) && (u < upper)){
-					count[bin][j]++;
-					break;
-				}
-			}
+		/* Locate subinterval, of length p[bin], that contains the variate
+		 and increment the number in that bin */
+		cell = Util_Sample_Cumulative(cumprob, m * numStages, u);
+		if (cell >= 0) {
+			count[cell / numStages][cell % numStages]++;
 		}
 	}
 
+	free1d(cumprob);
+
 	return;
 }
 
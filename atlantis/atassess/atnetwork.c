@@ -87,7 +87,7 @@ void Calc_Network_Info(MSEBoxModel *bm, int z, int id) {
 
 						eatnetwk[sp + 1][stage][z] = stockinfo[seat_id][sp][z][id] * aprop;
 						prodnetwk[sp + 1][stage][z] = stockinfo[sprod_id][sp][z][id] * aprop;
-						u = drandom(1.0, 3.0);
+						u = Util_Random(bm, rand_assess_id, 1.0, 3.0);
 						ge = u / 10.0;
 						pcalc = ge * eatnetwk[sp + 1][stage][z];
 						if (pcalc < prodnetwk[sp + 1][stage][z])
@@ -130,7 +130,7 @@ void Calc_Network_Info(MSEBoxModel *bm, int z, int id) {
 							case LG_ZOO: /* Zooplankton */
 								eatnetwk[sp + 1][stage][z] = sampleeat[sp][z][id];
 								prodnetwk[sp + 1][stage][z] = sampleprod[sp][z][id];
-								u = drandom(1.0, 3.0);
+								u = Util_Random(bm, rand_assess_id, 1.0, 3.0);
 								ge = u / 10.0;
 								pcalc = ge * eatnetwk[sp + 1][stage][z];
 								if (pcalc < prodnetwk[sp + 1][stage][z])
@@ -151,7 +151,7 @@ void Calc_Network_Info(MSEBoxModel *bm, int z, int id) {
 							case MOB_EP_OTHER: /* and benthos */
 								eatnetwk[sp + 1][stage][z] = sampleeat[sp][z][id];
 								prodnetwk[sp + 1][stage][z] = sampleprod[sp][z][id];
-								u = drandom(1.0, 3.0);
+								u = Util_Random(bm, rand_assess_id, 1.0, 3.0);
 								ge = u / 10.0;
 								pcalc = ge * eatnetwk[sp + 1][stage][z];
 								if (pcalc < prodnetwk[sp + 1][stage][z])
@@ -113,7 +113,7 @@ static void Setup_Biased_Sample_Values(MSEBoxModel *bm, FILE *llogfp);
  */
 void Assess_Init(MSEBoxModel *bm, FILE *llogfp) {
 
-	int i, b, nk, nyr, max_nbs, nkk, numageclass, maxageclass, nsp, numyears, numsamples, sp, nf;
+	int i, b, nyr, numageclass, maxageclass, nsp, numyears, numsamples, sp, nf;
 	double max_avail = 0;
 	char convertedXMLFileName[STRLEN];
 
@@ -359,47 +359,7 @@ void Assess_Init(MSEBoxModel *bm, FILE *llogfp) {
     	quit("");
     }
 
-	CPUEtrend = (double **) alloc2d(nyr, bm->K_num_tot_sp);
-
-	nk = bm->K_num_max_cohort * bm->K_num_max_genetypes * nyr + 1;
-	BootResu = (double *) alloc1d(nk);
-	CData = (double **) alloc2d(bm->K_num_max_cohort * bm->K_num_max_genetypes, nyr);
-	IData = (double **) alloc2d(bm->K_num_max_cohort * bm->K_num_max_genetypes, nyr);
-	IDatahat = (double **) alloc2d(bm->K_num_max_cohort * bm->K_num_max_genetypes, nyr);
-
-	if (bm->K_num_max_cohort * bm->K_num_max_genetypes > num_est_prm)
-		nk = bm->K_num_max_cohort * bm->K_num_max_genetypes;
-	else
-		nk = num_est_prm;
-
-	NEst = (double **) alloc2d(nk, nyr);
-	Resu = (double **) alloc2d(nk, nyr);
-	F = (double **) alloc2d(nk, nyr);
-	P = (double **) alloc2d(nk, nk);
-	X = (double *) alloc1d(nk);
-	Y = (double *) alloc1d(nk);
-
-	nkk = (int) floor(ROUNDGUARD + (floor(bm->tstop / 365.0)));
-	if (nkk < 1)
-		nkk = 1;
-	XX = (double *) alloc1d(nkk);
-	YY = (double *) alloc1d(nkk);
-
-	max_nbs = 0;
-	for (i = 0; i < bm->K_num_tot_sp; i++) {
-		if (FunctGroupArray[i].isFished == TRUE) {
-			if ((int) (FunctGroupArray[i].speciesParams[assess_bootstrap_id]) > max_nbs)
-				max_nbs = (int) (FunctGroupArray[i].speciesParams[assess_bootstrap_id]);
-		}
-	}
-
-	nk = max_nbs + 2; // One spare in case of overlaps
-	NResult = (double ***) alloc3d(nk, bm->K_num_max_cohort * bm->K_num_max_genetypes, nyr);
-	ResultToSort = (double *) alloc1d(nk);
-	ResultSorted = (double *) alloc1d(nk);
-	nbsSort = (int *) i_alloc1d(nk);
-
-	//fprintf(llogfp, "nk: %d\n", nk);
+	bm->assessFit = Assess_Alloc_Fit(bm, nyr);
 
 	/* Determine maximum vertebrate ageclass size */
 	zoneVERTpopratio = (double ****) alloc4d(bm->nfzones, bm->maxspage, bm->K_num_max_cohort * bm->K_num_max_genetypes, bm->K_num_tot_sp);
@@ -468,8 +428,8 @@ void Assess_Init(MSEBoxModel *bm, FILE *llogfp) {
 		if (bm->flaggen == 1) {
 			/* Generate and record random numbers */
 			for (b = 0; b < numsamples; b++) {
-				bm->tassPatchy[b][tass_id] = bm->tassessinc / drandom(bm->minfreq, bm->maxfreq);
-				bm->tassPatchy[b][tasseat_id] = bm->teatassessinc / drandom(bm->minfreq, bm->maxfreq);
+				bm->tassPatchy[b][tass_id] = bm->tassessinc / Util_Random(bm, rand_assess_id, bm->minfreq, bm->maxfreq);
+				bm->tassPatchy[b][tasseat_id] = bm->teatassessinc / Util_Random(bm, rand_assess_id, bm->minfreq, bm->maxfreq);
 			}
 			for (i = 0; i < bm->K_num_tot_sp; i++) {
 				if (FunctGroupArray[i].isFished == TRUE) {
@@ -670,27 +630,11 @@ void Assess_Free(MSEBoxModel *bm) {
     free1d(soi);
 	free3d(trophspect);
 	free2d(max_lngth);
-	free1d(BootResu);
-	free2d(CData);
-	free2d(IData);
-	free2d(IDatahat);
-	free2d(NEst);
-	free2d(Resu);
-	free2d(F);
-	free2d(P);
-	free1d(X);
-	free1d(Y);
-    
-    free3d(NResult);
-	free1d(ResultToSort);
-	free1d(ResultSorted);
-	i_free1d(nbsSort);
+	Assess_Free_Fit(bm->assessFit);
+
 	free4d(zoneVERTpopratio);
 	i_free1d(checkedz);
-	free2d(CPUEtrend);
 	free2d(num_nyr);
-	free1d(XX);
-	free1d(YY);
 
 	free3d(bm->rand);
 	free2d(bm->tassPatchy);
@@ -706,6 +650,91 @@ void Assess_Free(MSEBoxModel *bm) {
 	return;
 }
 
+/**
+ * \brief Allocate a workspace for the classical assessment fits covering nyr years.
+ *
+ * bm->assessFit is the one the assessments use. Further workspaces can be made for fits that
+ * are run side by side (e.g. through Solve_Simplex_Multistart), as each fit must have its own.
+ */
+AssessFitStruct *Assess_Alloc_Fit(MSEBoxModel *bm, int nyr) {
+	int i, nk, nkk, max_nbs;
+	AssessFitStruct *fit = (AssessFitStruct *) malloc(sizeof(AssessFitStruct));
+
+	fit->SSmin = MAXDOUBLE;
+	fit->CTData = NULL;
+	fit->ITData = NULL;
+
+	fit->CPUEtrend = (double **) alloc2d(nyr, bm->K_num_tot_sp);
+
+	nk = bm->K_num_max_cohort * bm->K_num_max_genetypes * nyr + 1;
+	fit->BootResu = (double *) alloc1d(nk);
+	fit->CData = (double **) alloc2d(bm->K_num_max_cohort * bm->K_num_max_genetypes, nyr);
+	fit->IData = (double **) alloc2d(bm->K_num_max_cohort * bm->K_num_max_genetypes, nyr);
+	fit->IDatahat = (double **) alloc2d(bm->K_num_max_cohort * bm->K_num_max_genetypes, nyr);
+
+	if (bm->K_num_max_cohort * bm->K_num_max_genetypes > num_est_prm)
+		nk = bm->K_num_max_cohort * bm->K_num_max_genetypes;
+	else
+		nk = num_est_prm;
+
+	fit->NEst = (double **) alloc2d(nk, nyr);
+	fit->Resu = (double **) alloc2d(nk, nyr);
+	fit->F = (double **) alloc2d(nk, nyr);
+	fit->P = (double **) alloc2d(nk, nk);
+	fit->X = (double *) alloc1d(nk);
+	fit->Y = (double *) alloc1d(nk);
+
+	/* The catchability regression is fitted with the production model's simplex size */
+	fit->PP = (double **) alloc2d(nk, nk);
+	nkk = (int) floor(ROUNDGUARD + (floor(bm->tstop / 365.0)));
+	if (nkk < nk)
+		nkk = nk;
+	fit->XX = (double *) alloc1d(nkk);
+	fit->YY = (double *) alloc1d(nkk);
+
+	max_nbs = 0;
+	for (i = 0; i < bm->K_num_tot_sp; i++) {
+		if (FunctGroupArray[i].isFished == TRUE) {
+			if ((int) (FunctGroupArray[i].speciesParams[assess_bootstrap_id]) > max_nbs)
+				max_nbs = (int) (FunctGroupArray[i].speciesParams[assess_bootstrap_id]);
+		}
+	}
+
+	nk = max_nbs + 2; // One spare in case of overlaps
+	fit->NResult = (double ***) alloc3d(nk, bm->K_num_max_cohort * bm->K_num_max_genetypes, nyr);
+	fit->ResultToSort = (double *) alloc1d(nk);
+	fit->ResultSorted = (double *) alloc1d(nk);
+
+	return fit;
+}
+
+/**
+ * \brief Free a workspace made by Assess_Alloc_Fit().
+ */
+void Assess_Free_Fit(AssessFitStruct *fit) {
+
+	free1d(fit->BootResu);
+	free2d(fit->CData);
+	free2d(fit->IData);
+	free2d(fit->IDatahat);
+	free2d(fit->NEst);
+	free2d(fit->Resu);
+	free2d(fit->F);
+	free2d(fit->P);
+	free1d(fit->X);
+	free1d(fit->Y);
+	free2d(fit->PP);
+	free1d(fit->XX);
+	free1d(fit->YY);
+	free3d(fit->NResult);
+	free1d(fit->ResultToSort);
+	free1d(fit->ResultSorted);
+	free2d(fit->CPUEtrend);
+	free(fit);
+
+	return;
+}
+
 /**
  * \brief Populate the ErrorStructure for the given invert_type with the given values.
  */
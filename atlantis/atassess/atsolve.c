@@ -44,55 +44,99 @@
 
 #define SWAP(a,b) swap=(a);(a)=(b);(b)=swap;
 
+/* Powell line search constants (Numerical Recipes) */
+#define powell_tiny 1.0e-20
+#define powell_line_tol 2.0e-4
+#define powell_gold 1.618034
+#define powell_glimit 100.0
+#define powell_cgold 0.3819660
+#define powell_zeps 1.0e-10
+#define powell_brent_itmax 100
+
 
 /* VPA specific routines */
-static void Back_Calc(int ndim, int nchrt, int YrMax, double prm_sp);
-static void VPA_Funk_Val(int ndim, int nchrt, int YrMax, double *SS);
-static void Solve_Back(int Yr, int age, int ndim, double M_sp);
-static void Solve_Plus(int Yr, int nchrt, int ndim, double M_sp);
+static void Back_Calc(AssessFitStruct *fit, int ndim, int nchrt, int YrMax, double prm_sp);
+static void VPA_Funk_Val(AssessFitStruct *fit, int ndim, int nchrt, int YrMax, double *SS);
+static void Solve_Back(AssessFitStruct *fit, int Yr, int age, int ndim, double M_sp);
+static void Solve_Plus(AssessFitStruct *fit, int Yr, int nchrt, int ndim, double M_sp);
 
 /* Production model routines */
-static void Prod_Calc(MSEBoxModel *bm,int ndim, int sp, int nchrt, int YrMax, double prm_sp, FILE *ofp);
-static void Prod_Funk_Val(int ndim, int sp, int nchrt, int YrMax, double *SS);
+static void Prod_Calc(MSEBoxModel *bm, AssessFitStruct *fit, int ndim, int sp, int nchrt, int YrMax, double prm_sp, FILE *ofp);
+static void Prod_Funk_Val(AssessFitStruct *fit, int ndim, int sp, int nchrt, int YrMax, double *SS);
 
 /* Linear regression routines */
-static void Linear_Regression(MSEBoxModel *bm, int funkflag, int sp, double *X, int ndim, double **P, double *Y, int YrMax, int ESTQ, FILE *ofp);
-static void Regression_CPUE_Funk_Val(int ndim, int nid, int YrMax, double *X, double *SS);
-static void Regression_Funk_Val(int ndim, int YrMax, double *X, double *SS);
+static void Linear_Regression(MSEBoxModel *bm, AssessFitStruct *fit, int funkflag, int sp, double *X, int ndim, double **P, double *Y, int YrMax, int ESTQ, FILE *ofp);
+static void Regression_CPUE_Funk_Val(AssessFitStruct *fit, int ndim, int nid, int YrMax, double *X, double *SS);
+static void Regression_Funk_Val(AssessFitStruct *fit, int ndim, int YrMax, double *X, double *SS);
 
 /**
  * static function definitions
  */
-static double Amotry(MSEBoxModel *bm, double **p, double *y, double *psum, int ndim, int funkflag, int ihi,
-		int *nfunk, double fac, int nchrt, int YrMax, double prm_sp, int sp, FILE *ofp, double *xpar);
-
-void AmoebaL(MSEBoxModel *bm, double **p, double *y, int ndim, double ftol, int itmax, int funkflag, int nchrt, int YrMax, double prm_sp,
-		int sp, int *nfunk, int *ilow, FILE *ofp, double *xpar) {
+static double Amotry(double **p, double *y, double *psum, int ndim, int ihi, int *nfunk, double fac, SolveObjective funk, void *userdata);
+
+/* Powell line minimisation - the line being searched and the objective to call */
+typedef struct {
+	SolveObjective funk;
+	void *userdata;
+	int ndim;
+	double *p; /* Point the line goes through */
+	double *xi; /* Direction of the line */
+	double *xt; /* Point on the line being evaluated */
+} PowellLine;
+
+static double Powell_Line_Value(double x, PowellLine *line);
+static void Powell_Linmin(double *p, double *xi, PowellLine *line, double *fret);
+static void Powell_Bracket(double *ax, double *bx, double *cx, double *fa, double *fb, double *fc, PowellLine *line);
+static double Powell_Brent(double ax, double bx, double cx, double tol, double *xmin, PowellLine *line);
+
+void AmoebaL(double **p, double *y, int ndim, double ftol, int itmax, FunkArgs *args, int *nfunk, int *ilow) {
 	/* Not all calls to Amoeba will have the extra info needed by the Assessment model calls
 	 so reflect this in the two step call */
 
 	char *dummyname = "blank";
 
-	Amoeba(bm, 0, sp, 1.0, dummyname, p, y, ndim, ftol, itmax, funkflag, nchrt, YrMax, prm_sp, nfunk, ilow, ofp, NULL);
+	Amoeba(0, 1.0, dummyname, p, y, ndim, ftol, itmax, args, nfunk, ilow);
 
 	return;
 }
 
-void Amoeba(MSEBoxModel *bm, int assessing, int sp, double dayt, char* speciesname, double **p, double *y, int ndim, double ftol,
-		int itmax, int funkflag, int nchrt, int YrMax, double prm_sp, int *nfunk, int *ilow, FILE *ofp, double *xpar)
-/* Downhill Simplex (amoeba) routine from Numerical Recipes second edition pg 308 */
+/**
+ * \brief Downhill simplex using the funkflag selected model fitting function in Funk().
+ *
+ * Kept for the assessment code - the search itself is done by Solve_Simplex.
+ */
+void Amoeba(int assessing, double dayt, char* speciesname, double **p, double *y, int ndim, double ftol, int itmax, FunkArgs *args, int *nfunk, int *ilow)
 {
-	/* Multidimensional minimisation  of the function funk(x) where x is an ndim
-	 dimensional vector by the downhill simplex method of Nelder and Mead 1965. The matrix
-	 P[1..ndim+1][1..ndim] is input, the ndim+1 rows are ndim vectors defining the
-	 vertices of the starting simplex. Also input is the ndim+1 vector Y, whose
-	 components must be pre-initialised to the values of funk() evaluated at the ndim+1
-	 vetrices of P; and ftol the fractional convergence tolerance to be achieved in the
-	 function value. On output p and y will have been reset to ndim+1 new points all
-	 within ftol of a minimum function value, and nfunk gives the number of function
-	 evaluations taken.
-	 */
+	if (!Solve_Simplex(p, y, ndim, ftol, itmax, Funk, args, nfunk, ilow)) {
+		if (assessing)
+			fprintf(args->ofp, "Time: %e assessment of %s has failed to converge\n ", dayt, speciesname);
+		else
+			fprintf(args->ofp, "Time %e downhill_simplex (amoeba) failed to converge\n", dayt);
+	}
 
+	return;
+}
+
+/**
+ * \brief Downhill Simplex (amoeba) routine from Numerical Recipes second edition pg 308
+ *
+ * Multidimensional minimisation of the function funk(x, ndim, userdata) where x is an ndim
+ * dimensional vector by the downhill simplex method of Nelder and Mead 1965. The matrix
+ * P[1..ndim+1][1..ndim] is input, the ndim+1 rows are ndim vectors defining the
+ * vertices of the starting simplex. Also input is the ndim+1 vector Y, whose
+ * components must be pre-initialised to the values of funk() evaluated at the ndim+1
+ * vetrices of P; and ftol the fractional convergence tolerance to be achieved in the
+ * function value. On output p and y will have been reset to ndim+1 new points all
+ * within ftol of a minimum function value, and nfunk gives the number of function
+ * evaluations taken.
+ *
+ * All the search state is local or handed in, so the routine is reentrant as long as
+ * funk() only touches what it is given through userdata.
+ *
+ * Returns TRUE if converged, FALSE if itmax evaluations were used up first.
+ */
+int Solve_Simplex(double **p, double *y, int ndim, double ftol, int itmax, SolveObjective funk, void *userdata, int *nfunk, int *ilow)
+{
 	int i, j, ilo, ihi, inhi;
 	//int mpts=ndim+1;
 	int mpts = ndim;
@@ -142,26 +186,23 @@ void Amoeba(MSEBoxModel *bm, int assessing, int sp, double dayt, char* speciesna
 		}
 		if (*nfunk >= itmax) {
 			*ilow = ilo;
-			if (assessing)
-				fprintf(ofp, "Time: %e assessment of %s has failed to converge\n ", dayt, speciesname);
-			else
-				fprintf(ofp, "Time %e downhill_simplex (amoeba) failed to converge\n", dayt);
-			return;
+			free1d(psum);
+			return FALSE;
 		}
 		*nfunk += 2;				// Added this line to be in line with Numerical Recipes
 
 		/* Begin a new iteration */
 		/* First extrapolate by a factor alpha through the face of the simplex
 		 across from the high point (i.e. reflect the simplex from the high point) */
-		ytry = Amotry(bm, p, y, psum, ndim, funkflag, ihi, nfunk, -alpha, nchrt, YrMax, prm_sp, sp, ofp, xpar);
+		ytry = Amotry(p, y, psum, ndim, ihi, nfunk, -alpha, funk, userdata);
 		if (ytry <= y[ilo]) {
 			/* Gives a result better than the best point, so try an additional extrapolation by a factor gamma */
-			ytry = Amotry(bm, p, y, psum, ndim, funkflag, ihi, nfunk, gamma, nchrt, YrMax, prm_sp, sp, ofp, xpar);
+			ytry = Amotry(p, y, psum, ndim, ihi, nfunk, gamma, funk, userdata);
 		} else if (ytry >= y[inhi]) {
 			/* The reflected point is worse then the second highest, so look for
 			 an intermediate lower point (i.e. do a 1-dimensional contraction). */
 			ysave = y[ihi];
-			ytry = Amotry(bm, p, y, psum, ndim, funkflag, ihi, nfunk, beta, nchrt, YrMax, prm_sp, sp, ofp, xpar);
+			ytry = Amotry(p, y, psum, ndim, ihi, nfunk, beta, funk, userdata);
 			if (ytry >= ysave) {
 				/* Can't seem to get rid of that high point. Better contract
 				 around the lowest (best) point */
@@ -171,7 +212,7 @@ void Amoeba(MSEBoxModel *bm, int assessing, int sp, double dayt, char* speciesna
 							psum[j] = 0.5 * (p[i][j] + p[ilo][j]);
 							p[i][j] = psum[j];
 						}
-						y[i] = Funk(bm, funkflag, sp, nchrt, ndim, YrMax, prm_sp, psum, ofp, xpar);
+						y[i] = funk(psum, ndim, userdata);
 					}
 				}
 				/* Keep track of function evaluations */
@@ -195,15 +236,14 @@ void Amoeba(MSEBoxModel *bm, int assessing, int sp, double dayt, char* speciesna
 	/* Free local array */
 	free1d(psum);
 
-	return;
+	return TRUE;
 }
 
 /**
  * \brief Extrapolates by a factor fac through the face of the simplex across from the high point,
  * tries it, and replaces the high point if the new point is better
  */
-double Amotry(MSEBoxModel *bm, double **p, double *y, double *psum, int ndim, int funkflag, int ihi,
-		int *nfunk, double fac, int nchrt, int YrMax, double prm_sp, int sp, FILE *ofp, double *xpar)
+double Amotry(double **p, double *y, double *psum, int ndim, int ihi, int *nfunk, double fac, SolveObjective funk, void *userdata)
 {
 	int j;
 	double fac1, fac2, ytry;
@@ -216,7 +256,7 @@ double Amotry(MSEBoxModel *bm, double **p, double *y, double *psum, int ndim, in
 	}
 
 	/* Evaluate the function at the trial point */
-	ytry = Funk(bm, funkflag, sp, nchrt, ndim, YrMax, prm_sp, ptry, ofp, xpar);
+	ytry = funk(ptry, ndim, userdata);
 
 	(*nfunk)++;
 
@@ -237,46 +277,424 @@ double Amotry(MSEBoxModel *bm, double **p, double *y, double *psum, int ndim, in
 
 }
 
+/**
+ * \brief Evaluate funk() at each of the npts points in p, storing the answers in y.
+ *
+ * Used to fill in the starting simplex. The points are evaluated on nthreads threads
+ * (when built with OpenMP), each using its own entry in userdata, so userdata must have
+ * nthreads entries that don't share any state. With nthreads of 1 only userdata[0] is used
+ * and the points are evaluated in order.
+ */
+void Solve_Evaluate_Points(double **p, double *y, int npts, int ndim, SolveObjective funk, void **userdata, int nthreads)
+{
+	int i;
+
+	if (nthreads < 1)
+		nthreads = 1;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic) if(nthreads > 1)
+#endif
+	for (i = 0; i < npts; i++) {
+		y[i] = funk(p[i], ndim, userdata[Util_Get_Thread_Num()]);
+	}
+
+	return;
+}
+
+/**
+ * \brief Run nstart independent simplex searches and return the index of the best one.
+ *
+ * Start s uses the simplex p[s], its pre-evaluated values y[s] and userdata[s], so each
+ * start needs its own objective state (for the assessment fits a FunkArgs with its own
+ * Assess_Alloc_Fit() workspace). The starts are run on nthreads threads when built
+ * with OpenMP. nfunk[s] and ilow[s] are filled in as for Solve_Simplex and converged[s]
+ * flags whether that start converged. The best start is the one with the lowest value left
+ * in its simplex - starts that failed to converge are only picked if none converged.
+ */
+int Solve_Simplex_Multistart(double ***p, double **y, int nstart, int ndim, double ftol, int itmax, SolveObjective funk, void **userdata,
+		int nthreads, int *nfunk, int *ilow, int *converged)
+{
+	int s, i, best = -1;
+	double ybest = 0.0, ymin;
+
+	if (nthreads < 1)
+		nthreads = 1;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic) if(nthreads > 1)
+#endif
+	for (s = 0; s < nstart; s++) {
+		converged[s] = Solve_Simplex(p[s], y[s], ndim, ftol, itmax, funk, userdata[s], &nfunk[s], &ilow[s]);
+	}
+
+	/* Pick the best in start order so the answer doesn't depend on the threading */
+	for (s = 0; s < nstart; s++) {
+		ymin = y[s][0];
+		for (i = 1; i < ndim; i++) {
+			if (y[s][i] < ymin)
+				ymin = y[s][i];
+		}
+
+		if ((best < 0) || (converged[s] && !converged[best]) || ((converged[s] == converged[best]) && (ymin < ybest))) {
+			best = s;
+			ybest = ymin;
+		}
+	}
+
+	return best;
+}
+
+/**
+ * \brief Powell's direction set method - Numerical Recipes second edition pg 417
+ *
+ * Minimisation of funk(x, ndim, userdata) starting at p[0..ndim-1]. xi[0..ndim-1][0..ndim-1]
+ * holds the initial set of directions (usually the unit vectors), one per column. ftol is the
+ * fractional tolerance in the function value - failure to decrease by more than this in one
+ * iteration signals that the search is done. On output p is the best point found, xi is
+ * the current direction set, fret the value of funk() at p and iter the number of iterations
+ * taken.
+ *
+ * As with Solve_Simplex all the search state is local or handed in, so the routine is
+ * reentrant as long as funk() only touches what it is given through userdata.
+ *
+ * Returns TRUE if converged, FALSE if itmax iterations were used up first.
+ */
+int Solve_Powell(double *p, double **xi, int ndim, double ftol, int itmax, SolveObjective funk, void *userdata, int *iter, double *fret)
+{
+	int i, ibig, j;
+	double del, fp, fptt, t;
+	double *pt = alloc1d(ndim); /* Point at the start of the iteration */
+	double *ptt = alloc1d(ndim); /* Extrapolated point */
+	double *xit = alloc1d(ndim); /* Direction being minimised along */
+	PowellLine line;
+
+	line.funk = funk;
+	line.userdata = userdata;
+	line.ndim = ndim;
+	line.xt = alloc1d(ndim);
+
+	*fret = funk(p, ndim, userdata);
+	for (j = 0; j < ndim; j++)
+		pt[j] = p[j];
+
+	for (*iter = 1;; ++(*iter)) {
+		fp = *fret;
+		ibig = 0;
+		del = 0.0; /* Will be the biggest function decrease */
+
+		/* Loop over all directions in the set, minimising along each in turn */
+		for (i = 0; i < ndim; i++) {
+			for (j = 0; j < ndim; j++)
+				xit[j] = xi[j][i];
+			fptt = *fret;
+			Powell_Linmin(p, xit, &line, fret);
+
+			/* Record it if it is the largest decrease so far */
+			if (fptt - (*fret) > del) {
+				del = fptt - (*fret);
+				ibig = i;
+			}
+		}
+
+		/* Termination criterion */
+		if (2.0 * (fp - (*fret)) <= ftol * (fabs(fp) + fabs(*fret)) + powell_tiny) {
+			free1d(pt);
+			free1d(ptt);
+			free1d(xit);
+			free1d(line.xt);
+			return TRUE;
+		}
+		if (*iter >= itmax) {
+			free1d(pt);
+			free1d(ptt);
+			free1d(xit);
+			free1d(line.xt);
+			return FALSE;
+		}
+
+		/* Construct the extrapolated point and the average direction moved. Save the old starting point */
+		for (j = 0; j < ndim; j++) {
+			ptt[j] = 2.0 * p[j] - pt[j];
+			xit[j] = p[j] - pt[j];
+			pt[j] = p[j];
+		}
+
+		fptt = funk(ptt, ndim, userdata);
+		if (fptt < fp) {
+			t = 2.0 * (fp - 2.0 * (*fret) + fptt) * (fp - (*fret) - del) * (fp - (*fret) - del) - del * (fp - fptt) * (fp - fptt);
+			if (t < 0.0) {
+				/* Move to the minimum of the new direction and save it in place of the direction of largest decrease */
+				Powell_Linmin(p, xit, &line, fret);
+				for (j = 0; j < ndim; j++) {
+					xi[j][ibig] = xi[j][ndim - 1];
+					xi[j][ndim - 1] = xit[j];
+				}
+			}
+		}
+	}
+}
+
+/**
+ * \brief funk() evaluated along the line through line->p in direction line->xi
+ */
+static double Powell_Line_Value(double x, PowellLine *line)
+{
+	int j;
+
+	for (j = 0; j < line->ndim; j++)
+		line->xt[j] = line->p[j] + x * line->xi[j];
+
+	return line->funk(line->xt, line->ndim, line->userdata);
+}
 
 /**
- * \brief Powell routine - Numerical recipes
+ * \brief Line minimisation - moves p to the minimum of funk() along direction xi, replaces xi by the
+ * actual displacement and sets fret to the value at the new p. Numerical Recipes pg 419.
  */
-void powell(MSEBoxModel *bm, int sp, double *xf, double **xunit, int npar, double ftol, int *iter, double *ss, int funkflag) {
+static void Powell_Linmin(double *p, double *xi, PowellLine *line, double *fret)
+{
+	int j;
+	double xx, xmin, fx, fb, fa, bx, ax;
+
+	line->p = p;
+	line->xi = xi;
+
+	/* Initial guess for the bracket */
+	ax = 0.0;
+	xx = 1.0;
+	Powell_Bracket(&ax, &xx, &bx, &fa, &fx, &fb, line);
+	*fret = Powell_Brent(ax, xx, bx, powell_line_tol, &xmin, line);
+
+	for (j = 0; j < line->ndim; j++) {
+		xi[j] *= xmin;
+		p[j] += xi[j];
+	}
 
 	return;
 }
 
+/**
+ * \brief Given the points ax and bx, search downhill for new points ax, bx, cx that bracket
+ * a minimum along the line. Numerical Recipes pg 400.
+ */
+static void Powell_Bracket(double *ax, double *bx, double *cx, double *fa, double *fb, double *fc, PowellLine *line)
+{
+	double ulim, u, r, q, fu, swap, denom;
+
+	*fa = Powell_Line_Value(*ax, line);
+	*fb = Powell_Line_Value(*bx, line);
+
+	/* Switch roles of a and b so can go downhill from a to b */
+	if (*fb > *fa) {
+		SWAP(*ax, *bx)
+		SWAP(*fb, *fa)
+	}
+
+	/* First guess for c */
+	*cx = (*bx) + powell_gold * (*bx - *ax);
+	*fc = Powell_Line_Value(*cx, line);
+
+	/* Keep returning here until bracketed */
+	while (*fb > *fc) {
+		/* Compute u by parabolic extrapolation from a, b, c */
+		r = (*bx - *ax) * (*fb - *fc);
+		q = (*bx - *cx) * (*fb - *fa);
+		denom = max(fabs(q - r), powell_tiny);
+		if (q - r < 0.0)
+			denom = -denom;
+		u = (*bx) - ((*bx - *cx) * q - (*bx - *ax) * r) / (2.0 * denom);
+		ulim = (*bx) + powell_glimit * (*cx - *bx);
+
+		if ((*bx - u) * (u - *cx) > 0.0) {
+			/* Parabolic u is between b and c - try it */
+			fu = Powell_Line_Value(u, line);
+			if (fu < *fc) {
+				/* Got a minimum between b and c */
+				*ax = (*bx);
+				*bx = u;
+				*fa = (*fb);
+				*fb = fu;
+				return;
+			} else if (fu > *fb) {
+				/* Got a minimum between a and u */
+				*cx = u;
+				*fc = fu;
+				return;
+			}
+			/* Parabolic fit was no use, use default magnification */
+			u = (*cx) + powell_gold * (*cx - *bx);
+			fu = Powell_Line_Value(u, line);
+		} else if ((*cx - u) * (u - ulim) > 0.0) {
+			/* Parabolic fit is between c and its allowed limit */
+			fu = Powell_Line_Value(u, line);
+			if (fu < *fc) {
+				*bx = *cx;
+				*cx = u;
+				u = (*cx) + powell_gold * (*cx - *bx);
+				*fb = *fc;
+				*fc = fu;
+				fu = Powell_Line_Value(u, line);
+			}
+		} else if ((u - ulim) * (ulim - *cx) >= 0.0) {
+			/* Limit parabolic u to maximum allowed value */
+			u = ulim;
+			fu = Powell_Line_Value(u, line);
+		} else {
+			/* Reject parabolic u, use default magnification */
+			u = (*cx) + powell_gold * (*cx - *bx);
+			fu = Powell_Line_Value(u, line);
+		}
+
+		/* Eliminate oldest point and continue */
+		*ax = *bx;
+		*bx = *cx;
+		*cx = u;
+		*fa = *fb;
+		*fb = *fc;
+		*fc = fu;
+	}
+
+	return;
+}
+
+/**
+ * \brief Brent's method - given a bracketing triplet ax, bx, cx isolate the minimum along the line
+ * to a fractional precision of about tol. The abscissa of the minimum is returned as xmin and
+ * the minimum function value as the returned value. Numerical Recipes pg 404.
+ */
+static double Powell_Brent(double ax, double bx, double cx, double tol, double *xmin, PowellLine *line)
+{
+	int iter;
+	double a, b, d = 0.0, etemp, fu, fv, fw, fx, p, q, r, tol1, tol2, u, v, w, x, xm;
+	double e = 0.0; /* Distance moved on the step before last */
+
+	/* a and b must be in ascending order */
+	a = (ax < cx ? ax : cx);
+	b = (ax > cx ? ax : cx);
+	x = w = v = bx;
+	fw = fv = fx = Powell_Line_Value(x, line);
+
+	for (iter = 0; iter < powell_brent_itmax; iter++) {
+		xm = 0.5 * (a + b);
+		tol2 = 2.0 * (tol1 = tol * fabs(x) + powell_zeps);
+
+		/* Test for done here */
+		if (fabs(x - xm) <= (tol2 - 0.5 * (b - a))) {
+			break;
+		}
+
+		if (fabs(e) > tol1) {
+			/* Construct a trial parabolic fit */
+			r = (x - w) * (fx - fv);
+			q = (x - v) * (fx - fw);
+			p = (x - v) * q - (x - w) * r;
+			q = 2.0 * (q - r);
+			if (q > 0.0)
+				p = -p;
+			q = fabs(q);
+			etemp = e;
+			e = d;
+
+			if (fabs(p) >= fabs(0.5 * q * etemp) || p <= q * (a - x) || p >= q * (b - x)) {
+				/* Not acceptable so take the golden section step into the larger of the two segments */
+				e = (x >= xm ? a - x : b - x);
+				d = powell_cgold * e;
+			} else {
+				/* Take the parabolic step */
+				d = p / q;
+				u = x + d;
+				if (u - a < tol2 || b - u < tol2)
+					d = (xm - x >= 0.0 ? fabs(tol1) : -fabs(tol1));
+			}
+		} else {
+			e = (x >= xm ? a - x : b - x);
+			d = powell_cgold * e;
+		}
+
+		u = (fabs(d) >= tol1 ? x + d : x + (d >= 0.0 ? fabs(tol1) : -fabs(tol1)));
+
+		/* The one function evaluation per iteration */
+		fu = Powell_Line_Value(u, line);
+
+		/* Now decide what to do with the function evaluation */
+		if (fu <= fx) {
+			if (u >= x)
+				a = x;
+			else
+				b = x;
+			v = w;
+			w = x;
+			x = u;
+			fv = fw;
+			fw = fx;
+			fx = fu;
+		} else {
+			if (u < x)
+				a = u;
+			else
+				b = u;
+			if (fu <= fw || w == x) {
+				v = w;
+				w = u;
+				fv = fw;
+				fw = fu;
+			} else if (fu <= fv || v == x || v == w) {
+				v = u;
+				fv = fu;
+			}
+		}
+	}
+
+	/* If run out of iterations take the best found so far */
+	*xmin = x;
+
+	return fx;
+}
+
 
 /********************** Model fitting function (funk) **************************/
-double Funk(MSEBoxModel *bm, int funkflag, int sp, int nchrt, int ndim, int YrMax, double prm_sp, double *X, FILE *ofp, double *xpar) {
+/**
+ * \brief Objective for Solve_Simplex - the funkflag in the FunkArgs handed in as userdata picks the model,
+ * and all the data and estimates are read from and written to its fit workspace.
+ */
+double Funk(double *X, int ndim, void *userdata) {
+	FunkArgs *args = (FunkArgs *) userdata;
+	AssessFitStruct *fit = args->fit;
+	MSEBoxModel *bm = args->bm;
+	int sp = args->sp;
+	int nchrt = args->nchrt;
+	int YrMax = args->YrMax;
+	double prm_sp = args->prm_sp;
+	FILE *ofp = args->ofp;
 	int age, i;
 	double SS = 0;
 	double ans = 0;
 
-	switch (funkflag) {
+	switch (args->funkflag) {
 	case no_assess: /* No assessment */
 		break;
 	case schafer_model: /* Schafer production model assessment function */
 		for (i = 0; i < est_B0_id + 1; i++) {
-			NEst[YrMax][i] = exp(X[i]);
+			fit->NEst[YrMax][i] = exp(X[i]);
 		}
-		Prod_Calc(bm, ndim, sp, nchrt, YrMax, prm_sp, ofp);
-		Prod_Funk_Val(ndim, sp, nchrt, YrMax, &SS);
+		Prod_Calc(bm, fit, ndim, sp, nchrt, YrMax, prm_sp, ofp);
+		Prod_Funk_Val(fit, ndim, sp, nchrt, YrMax, &SS);
 
-		if (SS < SSmin)
-			SSmin = SS;
+		if (SS < fit->SSmin)
+			fit->SSmin = SS;
 		ans = SS;
 
 		break;
 	case VPA_model: /* ADAPT VPA assessment functions */
 		for (age = 0; age < nchrt; age++) {
-			NEst[YrMax][age] = exp(X[age]);
+			fit->NEst[YrMax][age] = exp(X[age]);
 		}
-		Back_Calc(ndim, nchrt, YrMax, prm_sp);
-		VPA_Funk_Val(ndim, nchrt, YrMax, &SS);
+		Back_Calc(fit, ndim, nchrt, YrMax, prm_sp);
+		VPA_Funk_Val(fit, ndim, nchrt, YrMax, &SS);
 
-		if (SS < SSmin)
-			SSmin = SS;
+		if (SS < fit->SSmin)
+			fit->SSmin = SS;
 
 		ans = SS;
 		break;
@@ -286,18 +704,18 @@ double Funk(MSEBoxModel *bm, int funkflag, int sp, int nchrt, int ndim, int YrMa
     case SS3_model: /* SS3 assessment called directly */
 		break;
 	case qlinear_regress: /* Linear regression */
-		Regression_Funk_Val(ndim, YrMax, X, &SS);
+		Regression_Funk_Val(fit, ndim, YrMax, X, &SS);
 		ans = SS;
 		break;
 	case CPUE_linear_regress: /* Linear regression */
-		Regression_CPUE_Funk_Val(ndim, sp, YrMax, X, &SS);
+		Regression_CPUE_Funk_Val(fit, ndim, sp, YrMax, X, &SS);
 		ans = SS;
 		break;
 	case EquilF_Funk_model:
-		EquilF_Funk(bm, sp, xpar, ofp);
+		EquilF_Funk(bm, sp, args->xpar, ofp);
 		break;
 	case SurplusProduction_model:
-		SurplusProduction(bm, sp, xpar, ofp);
+		SurplusProduction(bm, sp, args->xpar, ofp);
 		break;
 	default:
 		quit("No such function flag defined - how did it get here?\n");
@@ -311,39 +729,39 @@ double Funk(MSEBoxModel *bm, int funkflag, int sp, int nchrt, int ndim, int YrMa
 /**
  * \brief For VPA assessment, back project for all ages and years
  */
-void Back_Calc(int ndim, int nchrt, int YrMax, double prm_sp) {
+void Back_Calc(AssessFitStruct *fit, int ndim, int nchrt, int YrMax, double prm_sp) {
 	int Yr, age;
 
 	for (Yr = YrMax; Yr > 0; Yr--) {
 		for (age = 1; age < nchrt - 1; age++) {
-			Solve_Back(Yr, age, ndim, prm_sp);
+			Solve_Back(fit, Yr, age, ndim, prm_sp);
 		}
-		Solve_Plus(Yr - 1, nchrt, ndim, prm_sp);
+		Solve_Plus(fit, Yr - 1, nchrt, ndim, prm_sp);
 	}
 
 	return;
 
 }
 
-void Solve_Plus(int Yr, int nchrt, int ndim, double M_sp) {
+void Solve_Plus(AssessFitStruct *fit, int Yr, int nchrt, int ndim, double M_sp) {
 	double Fmin, Fmax, Nmax1, Nmax2, Nproj, Nhit, FF, ZZ;
 	int II;
 
 	Fmin = 0;
 	Fmax = 3;
-	Nhit = NEst[Yr + 1][nchrt - 1];
+	Nhit = fit->NEst[Yr + 1][nchrt - 1];
 
 	for (II = 0; II < ndim; II++) {
 		FF = (Fmin + Fmax) / 2.0;
 		ZZ = FF + M_sp;
-		Nmax1 = (CData[Yr][nchrt - 2] * ZZ / FF) / (1.0 - exp(-ZZ));
-		Nmax2 = (CData[Yr][nchrt - 1] * ZZ / FF) / (1.0 - exp(-ZZ));
+		Nmax1 = (fit->CData[Yr][nchrt - 2] * ZZ / FF) / (1.0 - exp(-ZZ));
+		Nmax2 = (fit->CData[Yr][nchrt - 1] * ZZ / FF) / (1.0 - exp(-ZZ));
 		Nproj = (Nmax1 + Nmax2) * exp(-ZZ);
 		if (fabs(Nproj - Nhit) < 0.01) {
-			F[Yr][nchrt - 2] = FF;
-			NEst[Yr][nchrt - 2] = Nmax1;
-			F[Yr][nchrt - 1] = FF;
-			NEst[Yr][nchrt - 1] = Nmax2;
+			fit->F[Yr][nchrt - 2] = FF;
+			fit->NEst[Yr][nchrt - 2] = Nmax1;
+			fit->F[Yr][nchrt - 1] = FF;
+			fit->NEst[Yr][nchrt - 1] = Nmax2;
 		}
 		if (Nproj > Nhit)
 			Fmin = FF;
@@ -357,21 +775,21 @@ void Solve_Plus(int Yr, int nchrt, int ndim, double M_sp) {
 /**
  * \brief Back projection
  */
-void Solve_Back(int Yr, int age, int ndim, double M_sp) {
+void Solve_Back(AssessFitStruct *fit, int Yr, int age, int ndim, double M_sp) {
 	double ZZ, FF, Fmin, Fmax, Nback, CTarg, CProj;
 	int II;
 
 	Fmin = 0;
 	Fmax = 3;
-	CTarg = CData[Yr - 1][age - 1];
+	CTarg = fit->CData[Yr - 1][age - 1];
 	for (II = 0; II < ndim; II++) {
 		FF = (Fmin + Fmax) / 2.0;
 		ZZ = M_sp + FF;
-		Nback = NEst[Yr][age] * exp(ZZ);
+		Nback = fit->NEst[Yr][age] * exp(ZZ);
 		CProj = (FF / ZZ) * Nback * (1.0 - exp(-ZZ));
 		if (fabs(CProj - CTarg) < 0.001) {
-			F[Yr - 1][age - 1] = FF;
-			NEst[Yr - 1][age - 1] = Nback;
+			fit->F[Yr - 1][age - 1] = FF;
+			fit->NEst[Yr - 1][age - 1] = Nback;
 		}
 		if (CProj > CTarg)
 			Fmax = FF;
@@ -385,7 +803,7 @@ void Solve_Back(int Yr, int age, int ndim, double M_sp) {
 /**
  * \brief This routine calculates sum of squares for VPA model fit
  */
-void VPA_Funk_Val(int ndim, int nchrt, int YrMax, double *SS) {
+void VPA_Funk_Val(AssessFitStruct *fit, int ndim, int nchrt, int YrMax, double *SS) {
 	int age, Yr;
 	double Qval, Nval, Error;
 
@@ -396,20 +814,20 @@ void VPA_Funk_Val(int ndim, int nchrt, int YrMax, double *SS) {
 		Nval = 0;
 		Qval = 0;
 		for (Yr = 0; Yr < YrMax + 1; Yr++) {
-			if (IData[Yr][age] > 0) {
+			if (fit->IData[Yr][age] > 0) {
 				Nval++;
-				Qval += log(IData[Yr][age] / (NEst[Yr][age] + small_num));
+				Qval += log(fit->IData[Yr][age] / (fit->NEst[Yr][age] + small_num));
 			}
 		}
 		Qval = exp(Qval / (Nval + small_num));
 
 		/* Estimate contribution to SS */
 		for (Yr = 0; Yr < YrMax + 1; Yr++) {
-			if (IData[Yr][age] > 0) {
+			if (fit->IData[Yr][age] > 0) {
 				/* Calculate residuals */
-				Error = log(IData[Yr][age]) - log(NEst[Yr][age] * Qval);
-				Resu[Yr][age] = Error;
-				IDatahat[Yr][age] = NEst[Yr][age] * Qval;
+				Error = log(fit->IData[Yr][age]) - log(fit->NEst[Yr][age] * Qval);
+				fit->Resu[Yr][age] = Error;
+				fit->IDatahat[Yr][age] = fit->NEst[Yr][age] * Qval;
 				(*SS) += Error * Error;
 			}
 		}
@@ -422,7 +840,7 @@ void VPA_Funk_Val(int ndim, int nchrt, int YrMax, double *SS) {
 /**
  * \brief Calculate all aspects of production model, estimate biomass and cpue so can calculate SS
  */
-void Prod_Calc(MSEBoxModel *bm,int ndim, int sp, int nchrt, int YrMax, double prm_sp, FILE *ofp) {
+void Prod_Calc(MSEBoxModel *bm, AssessFitStruct *fit, int ndim, int sp, int nchrt, int YrMax, double prm_sp, FILE *ofp) {
 	int Yr, model_state, p_dynamic = 0, q_dynamic = 0;
 	double r, K, B0, step1, step2, step3, Biom_estimate, p, avgq, q, qinc;
 
@@ -456,76 +874,76 @@ void Prod_Calc(MSEBoxModel *bm,int ndim, int sp, int nchrt, int YrMax, double pr
 		break;
 	}
 
-	/* Assumes latest estimates of r, K, B0 are stored in NEst[YrMax][i] */
-	r = NEst[YrMax][est_r_id] / 100.0;
-	K = NEst[YrMax][est_K_id] * 1000.0;
-	B0 = NEst[YrMax][est_B0_id] * 1000.0;
+	/* Assumes latest estimates of r, K, B0 are stored in fit->NEst[YrMax][i] */
+	r = fit->NEst[YrMax][est_r_id] / 100.0;
+	K = fit->NEst[YrMax][est_K_id] * 1000.0;
+	B0 = fit->NEst[YrMax][est_B0_id] * 1000.0;
 
 	if (p_dynamic) {
 		/* Allow for assymetric production, but constrain so that p>0 always */
-		step1 = max(0.1, NEst[YrMax][est_p_id]);
+		step1 = max(0.1, fit->NEst[YrMax][est_p_id]);
 		p = step1 / 1000000.0;
 	} else
 		p = 1.0 / 1000000.0;
 
 	/* Calculate estimates of biomass */
-	NEst[0][est_B_id] = B0;
+	fit->NEst[0][est_B_id] = B0;
 	for (Yr = 1; Yr < YrMax + 1; Yr++) {
-		step1 = NEst[Yr - 1][est_B_id] / (K + small_num);
+		step1 = fit->NEst[Yr - 1][est_B_id] / (K + small_num);
 		step2 = pow(step1, p);
-		Biom_estimate = NEst[Yr - 1][est_B_id] + NEst[Yr - 1][est_B_id] * (r / p) * (1.0 - step2) - CTData[Yr];
+		Biom_estimate = fit->NEst[Yr - 1][est_B_id] + fit->NEst[Yr - 1][est_B_id] * (r / p) * (1.0 - step2) - fit->CTData[Yr];
 		/* Put in constraint to prevent negative biomasses */
-		NEst[Yr][est_B_id] = max(1.0, Biom_estimate);
+		fit->NEst[Yr][est_B_id] = max(1.0, Biom_estimate);
 	}
 
 	/* Calculate estimates of q */
 	for (Yr = 0; Yr < YrMax + 1; Yr++) {
-		NEst[Yr][est_q_id] = log(CTData[Yr] / (NEst[Yr][est_B_id] + small_num));
+		fit->NEst[Yr][est_q_id] = log(fit->CTData[Yr] / (fit->NEst[Yr][est_B_id] + small_num));
 	}
 
 	if (q_dynamic) {
 		/* Changing catchabillity so perform a linear regression */
 
 		/* Set starting points for minimisation */
-		XX[0] = 1.0;
-		XX[1] = 1.0;
+		fit->XX[0] = 1.0;
+		fit->XX[1] = 1.0;
 
-		Linear_Regression(bm, qlinear_regress, sp, XX, ndim, PP, YY, YrMax, 1, ofp);
+		Linear_Regression(bm, fit, qlinear_regress, sp, fit->XX, ndim, fit->PP, fit->YY, YrMax, 1, ofp);
 
 		/* Get results of regression - need to take exponent as linear
 		 regression dealt with logged ratios */
-		q = exp(XX[0]);
-		qinc = exp(XX[1]);
+		q = exp(fit->XX[0]);
+		qinc = exp(fit->XX[1]);
 	} else {
 		/* Constant (estimated) q */
 
 		avgq = 0;
 		for (Yr = 0; Yr < YrMax + 1; Yr++)
-			avgq += NEst[Yr][est_q_id];
+			avgq += fit->NEst[Yr][est_q_id];
 
 		avgq /= YrMax;
 
-		q = exp(avgq); /* Take the exponent as NEst[Yr][est_q_id] are logged ratios */
+		q = exp(avgq); /* Take the exponent as fit->NEst[Yr][est_q_id] are logged ratios */
 		qinc = 1.0;
 
 	}
 
 	/* Update q predictions */
-	NEst[0][est_q_id] = q;
+	fit->NEst[0][est_q_id] = q;
 	for (Yr = 1; Yr < YrMax + 1; Yr++) {
-		NEst[Yr][est_q_id] = NEst[Yr - 1][est_q_id] * qinc;
+		fit->NEst[Yr][est_q_id] = fit->NEst[Yr - 1][est_q_id] * qinc;
 	}
 
 	/* Calculate predicted CPUE (IData) */
 	for (Yr = 0; Yr < YrMax + 1; Yr++) {
-		NEst[Yr][est_I_id] = NEst[Yr][est_B_id] * NEst[Yr][est_q_id];
+		fit->NEst[Yr][est_I_id] = fit->NEst[Yr][est_B_id] * fit->NEst[Yr][est_q_id];
 	}
 
 	/* Calculate MSY */
 	step1 = (p + 1.0);
 	step2 = ((p + 1.0) / (p + small_num));
 	step3 = pow(step1, step2);
-	NEst[YrMax][est_msy_id] = (r * K) / (step3 = small_num);
+	fit->NEst[YrMax][est_msy_id] = (r * K) / (step3 = small_num);
 
 	return;
 }
@@ -535,7 +953,7 @@ void Prod_Calc(MSEBoxModel *bm,int ndim, int sp, int nchrt, int YrMax, double pr
  * Not using sum of squares, bur using log likelihood - as suggested in Chapter 10
  * of Modelling and Quantitative Methods in Fisheries by Malcolm Haddon
  * */
-void Prod_Funk_Val(int ndim, int sp, int nchrt, int YrMax, double *SS) {
+void Prod_Funk_Val(AssessFitStruct *fit, int ndim, int sp, int nchrt, int YrMax, double *SS) {
 	int Yr;
 	double Nval, Lval, SSQval, SSavg, Error;
 
@@ -546,7 +964,7 @@ void Prod_Funk_Val(int ndim, int sp, int nchrt, int YrMax, double *SS) {
 	Lval = 0;
 	for (Yr = 0; Yr < YrMax + 1; Yr++) {
 		Nval++;
-		SSQval = log(ITData[Yr]) - log(NEst[Yr][est_I_id]);
+		SSQval = log(fit->ITData[Yr]) - log(fit->NEst[Yr][est_I_id]);
 		SSQval *= SSQval;
 		Lval += SSQval;
 	}
@@ -556,8 +974,8 @@ void Prod_Funk_Val(int ndim, int sp, int nchrt, int YrMax, double *SS) {
 
 	/* Calculate residuals - as no age structure carried, store results in entry zero (0) */
 	for (Yr = 0; Yr < YrMax + 1; Yr++) {
-		Error = ITData[Yr] / (NEst[Yr][est_I_id] + small_num);
-		Resu[Yr][0] = Error;
+		Error = fit->ITData[Yr] / (fit->NEst[Yr][est_I_id] + small_num);
+		fit->Resu[Yr][0] = Error;
 	}
 
 	return;
@@ -570,10 +988,22 @@ void Prod_Funk_Val(int ndim, int sp, int nchrt, int YrMax, double *SS) {
  *	\brief This routine fits a linear regression model of the form Y = A1 + A2*X by doing least squares minimisation using amoeba
  *
  */
-void Linear_Regression(MSEBoxModel *bm, int funkflag, int sp, double *X, int ndim, double **P, double *Y, int YrMax, int ESTQ, FILE *ofp) {
+void Linear_Regression(MSEBoxModel *bm, AssessFitStruct *fit, int funkflag, int sp, double *X, int ndim, double **P, double *Y, int YrMax, int ESTQ, FILE *ofp) {
 	int i, j, nfunk, Ilow;
 	//double SS;
 	double GRD = 1.2;
+	FunkArgs args;
+	void *userdata = &args;
+
+	args.bm = bm;
+	args.fit = fit;
+	args.funkflag = funkflag;
+	args.sp = sp;
+	args.nchrt = ndim;
+	args.YrMax = YrMax;
+	args.prm_sp = 1.0;
+	args.ofp = ofp;
+	args.xpar = NULL;
 
 	/* Assumes X already initialised so set up tolerances and gridding */
 	for (i = 0; i < ndim; i++) {
@@ -584,20 +1014,15 @@ void Linear_Regression(MSEBoxModel *bm, int funkflag, int sp, double *X, int ndi
 		}
 	}
 
-	for (i = 0; i < ndim; i++) {
-		for (j = 0; j < ndim; j++) {
-			X[j] = P[i][j];
-		}
-		Y[i] = Funk(bm, funkflag, sp, ndim, ndim, YrMax, 1.0, X, ofp, NULL);
-	}
+	Solve_Evaluate_Points(P, Y, ndim, ndim, Funk, &userdata, 1);
 
-	AmoebaL(bm, P, Y, ndim, 0.001, 1000, funkflag, ndim, YrMax, 1.0, sp, &nfunk, &Ilow, ofp, NULL);
+	AmoebaL(P, Y, ndim, 0.001, 1000, &args, &nfunk, &Ilow);
 
 	if (nfunk <= 1000) {
 		for (j = 0; j < ndim; j++) {
 			X[j] = P[Ilow][j];
 		}
-		//SS = Funk(bm, funkflag, sp, ndim, ndim, YrMax, 1.0, X, ofp);
+		//SS = Funk(X, ndim, &args);
 	} else if (ESTQ) {
 		//SS = MAXDOUBLE;
 
@@ -627,7 +1052,7 @@ void Linear_Regression(MSEBoxModel *bm, int funkflag, int sp, double *X, int ndi
 /**
  * \brief Routine calculating sums of squares for linear regression line  y = a + bx
  */
-void Regression_Funk_Val(int ndim, int YrMax, double *X, double *SS) {
+void Regression_Funk_Val(AssessFitStruct *fit, int ndim, int YrMax, double *X, double *SS) {
 	int Yr;
 	double a, b, y, Error;
 
@@ -636,7 +1061,7 @@ void Regression_Funk_Val(int ndim, int YrMax, double *X, double *SS) {
 
 	for (Yr = 0; Yr < YrMax + 1; Yr++) {
 		y = a + b * Yr;
-		Error = NEst[Yr][est_q_id] - y;
+		Error = fit->NEst[Yr][est_q_id] - y;
 		(*SS) += Error * Error;
 	}
 
@@ -646,7 +1071,7 @@ void Regression_Funk_Val(int ndim, int YrMax, double *X, double *SS) {
 /**
  * \brief  Routine calculating sums of squares for linear regression line  y = a + bx
  */
-void Regression_CPUE_Funk_Val(int ndim, int nid, int YrMax, double *X, double *SS) {
+void Regression_CPUE_Funk_Val(AssessFitStruct *fit, int ndim, int nid, int YrMax, double *X, double *SS) {
 	int Yr;
 	double a, b, y, Error;
 
@@ -655,7 +1080,7 @@ void Regression_CPUE_Funk_Val(int ndim, int nid, int YrMax, double *X, double *S
 
 	for (Yr = 0; Yr < YrMax + 1; Yr++) {
 		y = a + b * Yr;
-		Error = CPUEtrend[nid][Yr] - y;
+		Error = fit->CPUEtrend[nid][Yr] - y;
 		*SS += Error * Error;
 	}
 
@@ -636,7 +636,7 @@ void CharismaticEstimates(MSEBoxModel *bm, FILE *ofp) {
 							lngth = Get_Length(bm, wgt, sp);
 							Sort_Length_Weight(bm, 0, 1, sizestocknums_id, z, sp, fishery_id, lngth, 1, wgt, cmaxsize, sample_id, &ltc, ofp);
 							//TODO Check with beth about changing to a round instead of a floor.
-							cage = (int)(round((chrt + drandom(0.0, 1.0)) * FunctGroupArray[sp].ageClassSize + 0.5));
+							cage = (int)(round((chrt + Util_Random(bm, rand_survey_id, 0.0, 1.0)) * FunctGroupArray[sp].ageClassSize + 0.5));
 
 							Length_Age_Key(bm, z, sp, cmaxsize, lngth, cage, cmaxage, 1, sample_id);
 
@@ -1256,7 +1256,7 @@ void FishEstimates(MSEBoxModel *bm, FILE *ofp) {
 							/* Assume animal uniformly distributed in age class - may not be right! */
 
 							//TODO Check with beth about changing to a round instead of a floor.
-							cage = (int) (round((chrt +  drandom(0.0, 1.0)) * FunctGroupArray[sp].ageClassSize + 0.5));
+							cage = (int) (round((chrt +  Util_Random(bm, rand_survey_id, 0.0, 1.0)) * FunctGroupArray[sp].ageClassSize + 0.5));
 
 							Length_Age_Key(bm, z, sp, cmaxsize, lngth, cage, cmaxage, 1, sample_id);
 							/* Get estimate of catchability */
@@ -1681,18 +1681,18 @@ double Assess_Add_Error(MSEBoxModel *bm, int er_case, double true_val, double a,
 	case uniform_err: /* Uniform */
 		step1 = -a * true_val;
 		step2 = a * true_val;
-		ans = true_val + drandom(step1, step2);
+		ans = true_val + Util_Random(bm, rand_survey_id, step1, step2);
 		break;
 	case normal_err: /* Normal */
-		step1 = drandom(0.0, 1.0);
-		step2 = drandom(0.0, 1.0);
+		step1 = Util_Random(bm, rand_survey_id, 0.0, 1.0);
+		step2 = Util_Random(bm, rand_survey_id, 0.0, 1.0);
 		step3 = sqrt(-2.0 * log(step1)) * cos(2.0 * 3.1415926 * step2);
 		ans = step3 * sqrt(v) + true_val * a;
 		break;
 	case lognorm_err: /* Lognormal - note - v/2 is the bias correction term
 	 needed when generating lognormal by exponentiating a standard normal */
-		step1 = drandom(0.0, 1.0);
-		step2 = drandom(0.0, 1.0);
+		step1 = Util_Random(bm, rand_survey_id, 0.0, 1.0);
+		step2 = Util_Random(bm, rand_survey_id, 0.0, 1.0);
 		step3 = sqrt(-2.0 * log(step1)) * cos(2.0 * 3.1415926 * step2);
 		ans = exp(step3 * sqrt(v) - v / 2.0) * (true_val * a);
 		break;
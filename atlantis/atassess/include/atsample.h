@@ -330,36 +330,13 @@ extern int **divindx;
 /* Asessment arrays */
 extern double *whichrefi;
 
-extern double *BootResu;
-extern double **CData;
-extern double *CTData;
-extern double **CPUEtrend;
-extern double **F;
-extern double **IData;
-extern double *ITData;
-extern double **IDatahat;
-extern double **NEst;
-extern double ***NResult;
 extern double **num_nyr;
-extern double **P;
-extern double **PP;
-extern double **Resu;
-extern double *ResultToSort;
-extern double *ResultSorted;
-extern double *X;
-extern double *XX;
-extern double *Y;
-extern double *YY;
 extern double ****zoneVERTpopratio;
 
-extern int *nbsSort;
 
 /* Extra calculation arrays */
 extern int *checkedz;
 
-/* Global parameters */
-extern double SSmin;
-
 extern int flagphys, phys_samplingsize, flaginvpbiom, flagepibiom, flaginfbiom, flagdetbiom, flagverts, flagprod, flageat, flagcatch, flageffort, flagdiscrd,
 		flagcount, flagcurve, flagprms, flagage, flagfishbiom, K_num_stomaches;
 
@@ -391,6 +368,19 @@ typedef struct {
 
 extern ErrorStructure *spErrorStructure;
 
+/* Arguments handed through Solve_Simplex to Funk() - the fit only touches the workspace in fit */
+typedef struct {
+	MSEBoxModel *bm;
+	AssessFitStruct *fit;
+	int funkflag;
+	int sp;
+	int nchrt;
+	int YrMax;
+	double prm_sp;
+	FILE *ofp;
+	double *xpar;
+} FunkArgs;
+
 /*********************************************************************
  Prototypes
  *********************************************************************/
@@ -462,8 +452,14 @@ int Tier_Assessment_Allocate(MSEBoxModel *bm);
 int Tier_Assessment_PostLoad_Allocate(MSEBoxModel *bm);
 void PreAllocate_Index_Setting(MSEBoxModel *bm);
 
+/* Classical assessment fit workspaces */
+AssessFitStruct *Assess_Alloc_Fit(MSEBoxModel *bm, int nyr);
+void Assess_Free_Fit(AssessFitStruct *fit);
+
 /* Numerical matrix solution and minimisation routines */
-void AmoebaL(MSEBoxModel *bm, double **p, double *y, int ndim, double ftol, int itmax, int funkflag, int nchrt, int YrMax, double prm_sp, int sp, int *nfunk, int *ilow, FILE *ofp, double *xpar);
+void Amoeba(int assessing, double dayt, char* speciesname, double **p, double *y, int ndim, double ftol, int itmax, FunkArgs *args, int *nfunk, int *ilow);
+void AmoebaL(double **p, double *y, int ndim, double ftol, int itmax, FunkArgs *args, int *nfunk, int *ilow);
+double Funk(double *X, int ndim, void *userdata);
 
 /* Assessment routines */
 void Classical_Assessment(MSEBoxModel *bm, FILE *ofp);
@@ -150,29 +150,9 @@ double ***trophspect = 0;
 int    **divindx = 0;
 
 /* Asessment arrays */
-double *BootResu = 0;
-double **CData = 0;
-double *CTData = 0;
-double **CPUEtrend = 0;
-double **F = 0;
-double **IData = 0;
-double *ITData = 0;
-double **IDatahat = 0;
-double **NEst = 0;
-double ***NResult = 0;
 double **num_nyr = 0;
-double **P = 0;
-double **PP = 0;
-double **Resu = 0;
-double *ResultToSort = 0;
-double *ResultSorted = 0;
-double *X = 0;
-double *XX = 0;
-double *Y = 0;
-double *YY = 0;
 double ****zoneVERTpopratio = 0;
 
-int *nbsSort = 0;
 
 /* Extra calculation arrays */
 int *checkedz = 0;
@@ -183,9 +163,6 @@ ErrorStructure *spErrorStructure;
 int readModelAssessmentParameters(MSEBoxModel *bm, char *filename);
 
 
-/* Global parameters */
-double SSmin;
-
 int flagphys, phys_samplingsize, flaginvpbiom, flagepibiom, flaginfbiom, flagdetbiom, flagverts, flagprod, flageat, flagcatch, flageffort, flagdiscrd,
 		flagcount, flagcurve, flagprms, flagage, flagfishbiom, K_num_stomaches;
 
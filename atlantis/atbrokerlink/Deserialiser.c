@@ -39,11 +39,15 @@ static int Deserialiser_SetMortality(LinkageInterface *interface, Requests__Requ
 static void Deserialiser_GetDetritus(LinkageInterface *interface, Requests__Request *request);
 static int Deserialiser_SetDetritus(LinkageInterface *interface, Requests__Request *baseRequest);
 
+/* Shared memory field rows */
+static double *Deserialiser_Field(MSEBoxModel *bm, LinkageInterface *interface, int kind);
+static void Deserialiser_Check_Length(LinkageInterface *interface, size_t length, char *requestName);
+
 Message *Deserialise_Message(MSEBoxModel *bm, LinkageInterface *interface, Message *message) {
 	Requests__Request *request;
 	double time;
 	Message *response = NULL;
-	double *data;
+	double *data, *field;
 	unsigned int i;
 	int halt;
 
@@ -89,11 +93,17 @@ Message *Deserialise_Message(MSEBoxModel *bm, LinkageInterface *interface, Messa
 	case REQUESTS__REQUEST__TYPE__GETBIOMASS:
 		Deserialiser_GetBiomass(interface, request);
 
-		/* Get the response*/
-		data = Util_Alloc_Init_1D_Double(interface->numPolygons, 0.0);
+		/* Get the response - straight into the shared row if there is one */
+		field = Deserialiser_Field(bm, interface, SHM_FIELD_BIOMASS);
+		data = field ? field : Util_Alloc_Init_1D_Double(interface->numPolygons, 0.0);
+		Util_Init_1D_Double(data, interface->numPolygons, 0.0);
 		Link_GetBiomass(bm, interface->groupName, interface->numPolygons, interface->polygonList, data);
 		//data = Link_GetBiomass(bm, interface->groupName, interface->numPolygons, interface->polygonList);
 
+		if (field) {
+			response = Serialise_Data_Response(NULL, 0);
+			break;
+		}
 		for (i = 0; i < interface->numPolygons; i++) {
 			printf("data[%d] = %e\n", i, data[i]);
 		}
@@ -105,10 +115,15 @@ Message *Deserialise_Message(MSEBoxModel *bm, LinkageInterface *interface, Messa
 		Deserialiser_GetMortality(interface, request);
 
 		/* Get the response*/
-		data = Util_Alloc_Init_1D_Double(interface->numPolygons, 0.0);
+		field = Deserialiser_Field(bm, interface, SHM_FIELD_MORTALITY);
+		data = field ? field : Util_Alloc_Init_1D_Double(interface->numPolygons, 0.0);
 		for (i = 0; i < interface->numPolygons; i++) {
 			data[i] = (double) i;
 		}
+		if (field) {
+			response = Serialise_Data_Response(NULL, 0);
+			break;
+		}
 		response = Serialise_Data_Response(data, interface->numPolygons);
 		free(data);
 		break;
@@ -117,9 +132,15 @@ Message *Deserialise_Message(MSEBoxModel *bm, LinkageInterface *interface, Messa
 
 		/* Get the response*/
 
-		data = Util_Alloc_Init_1D_Double(interface->numPolygons, 0.0);
+		field = Deserialiser_Field(bm, interface, SHM_FIELD_DETRITUS);
+		data = field ? field : Util_Alloc_Init_1D_Double(interface->numPolygons, 0.0);
+		Util_Init_1D_Double(data, interface->numPolygons, 0.0);
 		Link_GetBiomass(bm, interface->groupName, interface->numPolygons, interface->polygonList, data);
 
+		if (field) {
+			response = Serialise_Data_Response(NULL, 0);
+			break;
+		}
 		for (i = 0; i < interface->numPolygons; i++) {
 			printf("data[%d] = %e\n", i, data[i]);
 		}
@@ -130,7 +151,11 @@ Message *Deserialise_Message(MSEBoxModel *bm, LinkageInterface *interface, Messa
 	case REQUESTS__REQUEST__TYPE__SETBIOMASS:
 		Deserialiser_SetBiomass(interface, request);
 
-		Link_SetBiomass(bm, interface->groupName, interface->numPolygons, interface->polygonList, interface->valueList);
+		/* A request without values means they are in the shared row */
+		field = interface->valueList;
+		if (interface->valuesShared)
+			field = Deserialiser_Field(bm, interface, SHM_FIELD_BIOMASS);
+		Link_SetBiomass(bm, interface->groupName, interface->numPolygons, interface->polygonList, field);
 
 		/* Run model timestep */
 		response = Serialise_Boolean_Response(TRUE);
@@ -284,16 +309,13 @@ int Deserialiser_SetBiomass(LinkageInterface *interface, Requests__Request *base
 
 	/* Check the length specified is what we expect */
 	length = request->n_values;
-	if (length != interface->numPolygons) {
-		fprintf(stderr, "Deserialiser_SetBiomass. Number of values sent from Broker %ld does not match number of expected polygon values %d\n", length,
-				interface->numPolygons);
-		exit(-1);
-	}
+	Deserialiser_Check_Length(interface, length, "Deserialiser_SetBiomass");
+
 	/* Copy the groupName and valueList data across */
 	strcpy(interface->groupName, request->groupid);
 	memcpy(interface->valueList, request->values, (sizeof(double) * length));
 
-	if (interface->verbose) {
+	if (interface->verbose && !interface->valuesShared) {
 		printf("SetBiomass - %s, [", interface->groupName);
 		for (i = 0; i < length; i++) {
 			printf("%s%e", i > 0 ? ", " : "", interface->valueList[i]);
@@ -343,15 +365,12 @@ int Deserialiser_SetMortality(LinkageInterface *interface, Requests__Request *ba
 
 	/* Check the length specified is what we expect */
 	length = request->n_values;
-	if (length != interface->numPolygons) {
-		fprintf(stderr, "Deserialiser_SetMortality. Number of values sent from Broker does not match number of expected polygon values\n");
-		exit(-1);
-	}
+	Deserialiser_Check_Length(interface, length, "Deserialiser_SetMortality");
 	/* Copy the groupName and valueList data across */
 	strcpy(interface->groupName, request->groupid);
 	memcpy(interface->valueList, request->values, (sizeof(double) * length));
 
-	if (interface->verbose) {
+	if (interface->verbose && !interface->valuesShared) {
 		printf("SetMortality - %s, [", interface->groupName);
 		for (i = 0; i < length; i++) {
 			printf("%s%e", i > 0 ? ", " : "", interface->valueList[i]);
@@ -400,15 +419,12 @@ int Deserialiser_SetDetritus(LinkageInterface *interface, Requests__Request *bas
 
 	/* Check the length specified is what we expect */
 	length = request->n_values;
-	if (length != interface->numPolygons) {
-		fprintf(stderr, "Deserialiser_SetDetritus. Number of values sent from Broker does not match number of expected polygon values\n");
-		exit(-1);
-	}
+	Deserialiser_Check_Length(interface, length, "Deserialiser_SetDetritus");
 	/* Copy the groupName and valueList data across */
 	strcpy(interface->groupName, request->groupid);
 	memcpy(interface->valueList, request->values, (sizeof(double) * length));
 
-	if (interface->verbose) {
+	if (interface->verbose && !interface->valuesShared) {
 		printf("SetDetritus - %s, [", interface->groupName);
 		for (i = 0; i < length; i++) {
 			printf("%s%e", i > 0 ? ", " : "", interface->valueList[i]);
@@ -420,3 +436,38 @@ int Deserialiser_SetDetritus(LinkageInterface *interface, Requests__Request *bas
 	return TRUE;
 }
 
+
+/**
+ * Check the number of values sent is what we expect. With the shared memory
+ * transport a request may send none, and the values are read from the shared row.
+ */
+void Deserialiser_Check_Length(LinkageInterface *interface, size_t length, char *requestName) {
+
+	interface->valuesShared = (length == 0 && interface->networkInterface->shm != NULL);
+	if (interface->valuesShared)
+		return;
+
+	if (length != interface->numPolygons) {
+		fprintf(stderr, "%s. Number of values sent from Broker %ld does not match number of expected polygon values %d\n", requestName, (long) length,
+				interface->numPolygons);
+		exit(-1);
+	}
+}
+
+/**
+ * The shared memory row of the given field kind for the current group, or NULL if
+ * the transport has none.
+ */
+double *Deserialiser_Field(MSEBoxModel *bm, LinkageInterface *interface, int kind) {
+	int guild;
+
+	if (interface->networkInterface->shm == NULL)
+		return NULL;
+
+	guild = Util_Get_FG_Index(bm, interface->groupName);
+	if (guild == -1) {
+		fprintf(stderr, "Deserialiser_Field - group code %s not recognised\n", interface->groupName);
+		quit("");
+	}
+	return Network_Field(interface->networkInterface, kind, guild);
+}
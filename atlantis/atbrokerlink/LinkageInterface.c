@@ -27,6 +27,7 @@ int Linkage_Initialise(MSEBoxModel *bm, char *networkURL) {
 	bm->linkageInterface->shutdown = FALSE;
 	bm->linkageInterface->verbose = 1;
 	bm->linkageInterface->valueList = NULL;
+	bm->linkageInterface->valuesShared = FALSE;
 
 	/* Linkage arrays */
 	bm->linkageInterface->linkageWCDetritusFlux = Util_Alloc_Init_3D_Double(bm->K_num_tot_sp, bm->wcnz, bm->nbox, 0.0);
@@ -0,0 +1,140 @@
+/*
+ * ShmLoopback.c
+ *
+ * A stand in for the partner model on the shared memory transport. It attaches to
+ * the segment the model created, sends Init, then for each step asks the model to
+ * run a timestep, reads the biomass field of the first group and writes it back
+ * unchanged. Selected with a shmloop:// URL in the linkage config, where it runs in
+ * a child process of the model.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "requests.pb-c.h"
+#include "responses.pb-c.h"
+#include "ShmNetwork.h"
+
+/**
+ * Pack the request, send it, and check the reply. Returns the reply, or NULL if
+ * it was missing or an error.
+ */
+static Responses__Response *Loopback_Request(ShmNetwork *shm, Requests__Request *request) {
+	Message message, *reply;
+	Responses__Response *response;
+
+	message.size = requests__request__get_packed_size(request);
+	message.bytes = malloc(message.size > 0 ? message.size : 1);
+	requests__request__pack(request, message.bytes);
+
+	if (ShmNetwork_Send(shm, SHM_TO_MODEL, &message) != 0) {
+		free(message.bytes);
+		return NULL;
+	}
+	free(message.bytes);
+
+	reply = ShmNetwork_Receive(shm, SHM_TO_PARTNER);
+	response = responses__response__unpack(NULL, reply->size, reply->bytes);
+	free(reply->bytes);
+	free(reply);
+
+	if (response != NULL && response->type == RESPONSES__RESPONSE__TYPE__ERROR) {
+		fprintf(stderr, "ShmLoopback - model returned error %s\n", response->error ? response->error->reason : "");
+		responses__response__free_unpacked(response, NULL);
+		return NULL;
+	}
+	return response;
+}
+
+static int Loopback_Bool_Request(ShmNetwork *shm, Requests__Request *request) {
+	Responses__Response *response = Loopback_Request(shm, request);
+	int ok;
+
+	if (response == NULL)
+		return 0;
+	ok = (response->type == RESPONSES__RESPONSE__TYPE__BOOL && response->bool_ != NULL && response->bool_->response);
+	responses__response__free_unpacked(response, NULL);
+	return ok;
+}
+
+int ShmLoopback_Run(const char *name, int nsteps) {
+	ShmNetwork *shm;
+	Requests__Request request;
+	Requests__Init init = REQUESTS__INIT__INIT;
+	Requests__RunNextTimeStep runNext = REQUESTS__RUN_NEXT_TIME_STEP__INIT;
+	Requests__GetBiomass getBiomass = REQUESTS__GET_BIOMASS__INIT;
+	Requests__SetBiomass setBiomass = REQUESTS__SET_BIOMASS__INIT;
+	Requests__Shutdown shutDown = REQUESTS__SHUTDOWN__INIT;
+	Responses__Response *response;
+	char groupCode[SHM_CODE_LEN];
+	double *field;
+	int step, failed = 0;
+
+	shm = ShmNetwork_Attach(name);
+	if (shm == NULL)
+		return 1;
+
+	strncpy(groupCode, ShmNetwork_Group_Code(shm, 0), SHM_CODE_LEN - 1);
+	groupCode[SHM_CODE_LEN - 1] = '\0';
+	field = ShmNetwork_Field(shm, SHM_FIELD_BIOMASS, 0);
+
+	requests__request__init(&request);
+	request.type = REQUESTS__REQUEST__TYPE__INIT;
+	init.timestep = "0";
+	request.init = &init;
+	if (!Loopback_Bool_Request(shm, &request)) {
+		fprintf(stderr, "ShmLoopback - Init failed\n");
+		failed = 1;
+	}
+
+	for (step = 0; step < nsteps && !failed; step++) {
+		requests__request__init(&request);
+		request.type = REQUESTS__REQUEST__TYPE__RUNNEXTTIMESTEP;
+		request.runnext = &runNext;
+		if (!Loopback_Bool_Request(shm, &request)) {
+			fprintf(stderr, "ShmLoopback - RunNextTimeStep failed at step %d\n", step);
+			failed = 1;
+			break;
+		}
+
+		/* No values in the request or the reply - the model fills the shared biomass row */
+		requests__request__init(&request);
+		request.type = REQUESTS__REQUEST__TYPE__GETBIOMASS;
+		getBiomass.groupid = groupCode;
+		request.getbiomass = &getBiomass;
+		response = Loopback_Request(shm, &request);
+		if (response == NULL || response->type != RESPONSES__RESPONSE__TYPE__GET) {
+			fprintf(stderr, "ShmLoopback - GetBiomass %s failed at step %d\n", groupCode, step);
+			failed = 1;
+		}
+		if (response != NULL)
+			responses__response__free_unpacked(response, NULL);
+		if (failed)
+			break;
+
+		printf("ShmLoopback step %d - %s biomass in first box %e\n", step, groupCode, field[0]);
+
+		/* Hand the same row back so the model state is unchanged */
+		requests__request__init(&request);
+		request.type = REQUESTS__REQUEST__TYPE__SETBIOMASS;
+		setBiomass.groupid = groupCode;
+		setBiomass.n_values = 0;
+		setBiomass.values = NULL;
+		request.setbiomass = &setBiomass;
+		if (!Loopback_Bool_Request(shm, &request)) {
+			fprintf(stderr, "ShmLoopback - SetBiomass %s failed at step %d\n", groupCode, step);
+			failed = 1;
+		}
+	}
+
+	/* Always ask the model to stop, so it does not wait on the ring for ever */
+	requests__request__init(&request);
+	request.type = REQUESTS__REQUEST__TYPE__SHUTDOWN;
+	request.shutdown = &shutDown;
+	if (!Loopback_Bool_Request(shm, &request))
+		failed = 1;
+
+	ShmNetwork_Close(shm);
+
+	return failed;
+}
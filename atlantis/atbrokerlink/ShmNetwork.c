@@ -0,0 +1,286 @@
+/*
+ * ShmNetwork.c
+ *
+ * Shared memory ring buffer transport for the broker link. See ShmNetwork.h for
+ * the segment layout.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ShmNetwork.h"
+
+#define SHM_ROUND(x) ((((x) + SHM_ALIGN - 1) / SHM_ALIGN) * SHM_ALIGN)
+#define SHM_LEN_BYTES sizeof(uint64_t)
+
+/**
+ * Copy nbytes into the ring at position pos, wrapping at the end.
+ */
+static void Shm_Ring_Put(unsigned char *ring, uint64_t ringSize, uint64_t pos, const void *data, size_t nbytes) {
+	size_t start = (size_t) (pos % ringSize);
+	size_t first = nbytes;
+
+	if (first > ringSize - start)
+		first = (size_t) (ringSize - start);
+	memcpy(ring + start, data, first);
+	if (first < nbytes)
+		memcpy(ring, (const unsigned char *) data + first, nbytes - first);
+}
+
+static void Shm_Ring_Get(const unsigned char *ring, uint64_t ringSize, uint64_t pos, void *data, size_t nbytes) {
+	size_t start = (size_t) (pos % ringSize);
+	size_t first = nbytes;
+
+	if (first > ringSize - start)
+		first = (size_t) (ringSize - start);
+	memcpy(data, ring + start, first);
+	if (first < nbytes)
+		memcpy((unsigned char *) data + first, ring, nbytes - first);
+}
+
+static void Shm_Sem_Wait(sem_t *sem) {
+	while (sem_wait(sem) == -1) {
+		if (errno != EINTR) {
+			perror("Shm_Sem_Wait");
+			exit(-1);
+		}
+	}
+}
+
+/**
+ * Map totalSize bytes of the open segment and wrap it up. Closes fd.
+ */
+static ShmNetwork *Shm_Map(const char *name, int fd, uint64_t totalSize, int owner) {
+	ShmNetwork *shm;
+	void *addr;
+
+	addr = mmap(NULL, (size_t) totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (addr == MAP_FAILED) {
+		perror("ShmNetwork mmap");
+		return NULL;
+	}
+
+	shm = (ShmNetwork *) malloc(sizeof(ShmNetwork));
+	shm->name = strdup(name);
+	shm->owner = owner;
+	shm->base = (unsigned char *) addr;
+	shm->header = (ShmHeader *) addr;
+
+	return shm;
+}
+
+ShmNetwork *ShmNetwork_Create(const char *name, int nbox, const int *boxIds, int ngroup, char **groupCodes) {
+	ShmNetwork *shm;
+	ShmHeader *header;
+	uint64_t offset, boxOffset, codeOffset, fieldOffset, ringOffset[SHM_NRING];
+	int fd, i, ring;
+
+	/* Work out the layout */
+	offset = SHM_ROUND(sizeof(ShmHeader));
+	boxOffset = offset;
+	offset += SHM_ROUND(sizeof(int32_t) * (uint64_t) nbox);
+	codeOffset = offset;
+	offset += SHM_ROUND((uint64_t) SHM_CODE_LEN * (uint64_t) ngroup);
+	for (ring = 0; ring < SHM_NRING; ring++) {
+		ringOffset[ring] = offset;
+		offset += SHM_RING_SIZE;
+	}
+	fieldOffset = offset;
+	offset += SHM_ROUND(sizeof(double) * (uint64_t) SHM_NFIELD_KIND * (uint64_t) ngroup * (uint64_t) nbox);
+
+	/* Start from a clean segment in case a previous run did not finish */
+	shm_unlink(name);
+	fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+	if (fd == -1) {
+		fprintf(stderr, "ShmNetwork_Create - unable to create shared memory segment %s: %s\n", name, strerror(errno));
+		return NULL;
+	}
+	if (ftruncate(fd, (off_t) offset) == -1) {
+		fprintf(stderr, "ShmNetwork_Create - unable to size shared memory segment %s: %s\n", name, strerror(errno));
+		close(fd);
+		shm_unlink(name);
+		return NULL;
+	}
+	shm = Shm_Map(name, fd, offset, 1);
+	if (shm == NULL) {
+		shm_unlink(name);
+		return NULL;
+	}
+
+	header = shm->header;
+	memset(header, 0, sizeof(ShmHeader));
+	header->version = SHM_VERSION;
+	header->nbox = (uint32_t) nbox;
+	header->ngroup = (uint32_t) ngroup;
+	header->totalSize = offset;
+	header->ringSize = SHM_RING_SIZE;
+	header->boxOffset = boxOffset;
+	header->codeOffset = codeOffset;
+	for (ring = 0; ring < SHM_NRING; ring++)
+		header->ringOffset[ring] = ringOffset[ring];
+	header->fieldOffset = fieldOffset;
+
+	for (i = 0; i < nbox; i++)
+		((int32_t *) (shm->base + header->boxOffset))[i] = boxIds[i];
+	for (i = 0; i < ngroup; i++)
+		strncpy((char *) (shm->base + header->codeOffset + (uint64_t) i * SHM_CODE_LEN), groupCodes[i], SHM_CODE_LEN - 1);
+
+	for (ring = 0; ring < SHM_NRING; ring++) {
+		if (sem_init(&header->items[ring], 1, 0) == -1 || sem_init(&header->space[ring], 1, 0) == -1) {
+			perror("ShmNetwork_Create sem_init");
+			ShmNetwork_Close(shm);
+			return NULL;
+		}
+	}
+
+	/* The partner checks the magic number, so only set it once everything else is ready */
+	__sync_synchronize();
+	header->magic = SHM_MAGIC;
+
+	return shm;
+}
+
+ShmNetwork *ShmNetwork_Attach(const char *name) {
+	ShmHeader *header;
+	uint64_t totalSize;
+	struct stat st;
+	int fd;
+
+	fd = shm_open(name, O_RDWR, 0);
+	if (fd == -1) {
+		fprintf(stderr, "ShmNetwork_Attach - unable to open shared memory segment %s: %s\n", name, strerror(errno));
+		return NULL;
+	}
+	if (fstat(fd, &st) == -1 || (size_t) st.st_size < sizeof(ShmHeader)) {
+		fprintf(stderr, "ShmNetwork_Attach - shared memory segment %s is not ready\n", name);
+		close(fd);
+		return NULL;
+	}
+
+	/* Map just the header to check it and find the full size */
+	header = (ShmHeader *) mmap(NULL, sizeof(ShmHeader), PROT_READ, MAP_SHARED, fd, 0);
+	if (header == MAP_FAILED) {
+		perror("ShmNetwork_Attach mmap");
+		close(fd);
+		return NULL;
+	}
+	if (header->magic != SHM_MAGIC || header->version != SHM_VERSION) {
+		fprintf(stderr, "ShmNetwork_Attach - shared memory segment %s has magic %x version %u, expected %x version %u\n", name, header->magic,
+				header->version, SHM_MAGIC, SHM_VERSION);
+		munmap(header, sizeof(ShmHeader));
+		close(fd);
+		return NULL;
+	}
+	totalSize = header->totalSize;
+	munmap(header, sizeof(ShmHeader));
+
+	return Shm_Map(name, fd, totalSize, 0);
+}
+
+void ShmNetwork_Close(ShmNetwork *shm) {
+	int ring;
+
+	if (shm == NULL)
+		return;
+
+	if (shm->owner) {
+		for (ring = 0; ring < SHM_NRING; ring++) {
+			sem_destroy(&shm->header->items[ring]);
+			sem_destroy(&shm->header->space[ring]);
+		}
+	}
+	munmap(shm->base, (size_t) shm->header->totalSize);
+	if (shm->owner)
+		shm_unlink(shm->name);
+
+	free(shm->name);
+	free(shm);
+}
+
+/**
+ * Queue a message on the given ring. Blocks while the ring is too full to take it.
+ */
+int ShmNetwork_Send(ShmNetwork *shm, int ring, Message *message) {
+	ShmHeader *header = shm->header;
+	unsigned char *data = shm->base + header->ringOffset[ring];
+	uint64_t len = (uint64_t) message->size;
+	uint64_t need = SHM_LEN_BYTES + ((len + SHM_LEN_BYTES - 1) / SHM_LEN_BYTES) * SHM_LEN_BYTES;
+	uint64_t head = header->head[ring];
+
+	if (need > header->ringSize) {
+		fprintf(stderr, "ShmNetwork_Send - message of %lu bytes is larger than the ring (%lu bytes)\n", (unsigned long) len,
+				(unsigned long) header->ringSize);
+		return -1;
+	}
+
+	/* The reader posts space each time it takes a message, so recheck after each one */
+	while (header->ringSize - (head - header->tail[ring]) < need)
+		Shm_Sem_Wait(&header->space[ring]);
+
+	Shm_Ring_Put(data, header->ringSize, head, &len, SHM_LEN_BYTES);
+	Shm_Ring_Put(data, header->ringSize, head + SHM_LEN_BYTES, message->bytes, message->size);
+	header->head[ring] = head + need;
+
+	sem_post(&header->items[ring]);
+
+	return 0;
+}
+
+/**
+ * Take the next message off the given ring, waiting for one if it is empty.
+ */
+Message *ShmNetwork_Receive(ShmNetwork *shm, int ring) {
+	ShmHeader *header = shm->header;
+	unsigned char *data = shm->base + header->ringOffset[ring];
+	Message *message;
+	uint64_t tail, len;
+
+	Shm_Sem_Wait(&header->items[ring]);
+
+	tail = header->tail[ring];
+	Shm_Ring_Get(data, header->ringSize, tail, &len, SHM_LEN_BYTES);
+
+	message = (Message *) malloc(sizeof(Message));
+	message->size = (size_t) len;
+	message->bytes = malloc(len > 0 ? (size_t) len : 1);
+	Shm_Ring_Get(data, header->ringSize, tail + SHM_LEN_BYTES, message->bytes, message->size);
+
+	header->tail[ring] = tail + SHM_LEN_BYTES + ((len + SHM_LEN_BYTES - 1) / SHM_LEN_BYTES) * SHM_LEN_BYTES;
+	sem_post(&header->space[ring]);
+
+	return message;
+}
+
+/**
+ * The nbox values of the given field kind for the given group, in box id table order.
+ */
+double *ShmNetwork_Field(ShmNetwork *shm, int kind, int group) {
+	ShmHeader *header = shm->header;
+
+	if (kind < 0 || kind >= SHM_NFIELD_KIND || group < 0 || group >= (int) header->ngroup)
+		return NULL;
+
+	return (double *) (shm->base + header->fieldOffset) + ((uint64_t) kind * header->ngroup + (uint64_t) group) * header->nbox;
+}
+
+const char *ShmNetwork_Group_Code(ShmNetwork *shm, int group) {
+	if (group < 0 || group >= (int) shm->header->ngroup)
+		return NULL;
+	return (const char *) (shm->base + shm->header->codeOffset + (uint64_t) group * SHM_CODE_LEN);
+}
+
+int ShmNetwork_Group_Index(ShmNetwork *shm, const char *groupCode) {
+	int group;
+
+	for (group = 0; group < (int) shm->header->ngroup; group++) {
+		if (strcmp(ShmNetwork_Group_Code(shm, group), groupCode) == 0)
+			return group;
+	}
+	return -1;
+}
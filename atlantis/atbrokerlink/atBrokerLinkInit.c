@@ -29,6 +29,8 @@ int Linkage_Read_XML(MSEBoxModel *bm, char *fileName) {
 	int polygonIndex, numPolygons;
 	xmlNodePtr polygonNode;
 	char url[STRLEN];
+	char **groupCodes;
+	int guild;
 
 	if (strlen(fileName) == 0) {
 		fprintf(stderr,
@@ -81,6 +83,15 @@ int Linkage_Read_XML(MSEBoxModel *bm, char *fileName) {
 		quit("ERROR: Error in the broker linkage config XML input file %s\n", fileName);
 	}
 
+	/* With the shared memory transport set up the field area - one row per group for the linkage polygons */
+	groupCodes = (char **) malloc(sizeof(char *) * bm->K_num_tot_sp);
+	for (guild = 0; guild < bm->K_num_tot_sp; guild++)
+		groupCodes[guild] = FunctGroupArray[guild].groupCode;
+	if (Network_Open_Fields(bm->linkageInterface->networkInterface, numPolygons, bm->linkageInterface->polygonList, bm->K_num_tot_sp, groupCodes) != 0) {
+		quit("ERROR: Unable to set up the shared memory broker linkage %s\n", url);
+	}
+	free(groupCodes);
+
 	xmlFreeDoc(inputDoc);
 	/* Shutdown libxml */
 	xmlCleanupParser();
@@ -0,0 +1,89 @@
+/*
+ * ShmNetwork.h
+ *
+ * Shared memory transport for the broker link.
+ *
+ * The model creates one POSIX shared memory segment that both sides map:
+ *
+ *   ShmHeader | box ids | group codes | ring to model | ring to partner | fields
+ *
+ * The two rings carry the usual protobuf control messages (each one a length
+ * followed by the packed bytes), with process shared semaphores for the handoff.
+ * The field area is a flat array of doubles, field[kind][group][box], where kind
+ * is one of SHM_FIELD_KIND, group is the functional group index and box is the
+ * index into the box id table (the linkage polygon list). A Get or Set request
+ * sent with no values reads or writes the matching row in place, so the field
+ * data itself is never packed.
+ */
+
+#ifndef SHMNETWORK_H_
+#define SHMNETWORK_H_
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <semaphore.h>
+#include "Message.h"
+
+#define SHM_MAGIC 0x41544C53 /* "ATLS" */
+#define SHM_VERSION 1
+#define SHM_CODE_LEN 32
+#define SHM_RING_SIZE (1 << 20)
+#define SHM_ALIGN 64
+
+/* Number of timesteps the loopback partner asks the model to run */
+#define SHM_LOOPBACK_STEPS 3
+
+enum SHM_RING {
+	SHM_TO_MODEL = 0,
+	SHM_TO_PARTNER,
+	SHM_NRING
+};
+
+enum SHM_FIELD_KIND {
+	SHM_FIELD_BIOMASS = 0,
+	SHM_FIELD_DETRITUS,
+	SHM_FIELD_MORTALITY,
+	SHM_NFIELD_KIND
+};
+
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t nbox;
+	uint32_t ngroup;
+	uint64_t totalSize;
+	uint64_t ringSize;
+	uint64_t boxOffset;
+	uint64_t codeOffset;
+	uint64_t ringOffset[SHM_NRING];
+	uint64_t fieldOffset;
+	volatile uint64_t head[SHM_NRING];
+	volatile uint64_t tail[SHM_NRING];
+	sem_t items[SHM_NRING];
+	sem_t space[SHM_NRING];
+} ShmHeader;
+
+typedef struct {
+	char *name;
+	int owner;
+	ShmHeader *header;
+	unsigned char *base;
+} ShmNetwork;
+
+/* Model side */
+ShmNetwork *ShmNetwork_Create(const char *name, int nbox, const int *boxIds, int ngroup, char **groupCodes);
+void ShmNetwork_Close(ShmNetwork *shm);
+
+/* Partner side */
+ShmNetwork *ShmNetwork_Attach(const char *name);
+
+int ShmNetwork_Send(ShmNetwork *shm, int ring, Message *message);
+Message *ShmNetwork_Receive(ShmNetwork *shm, int ring);
+double *ShmNetwork_Field(ShmNetwork *shm, int kind, int group);
+int ShmNetwork_Group_Index(ShmNetwork *shm, const char *groupCode);
+const char *ShmNetwork_Group_Code(ShmNetwork *shm, int group);
+
+/* Loopback partner used to exercise the transport without a broker */
+int ShmLoopback_Run(const char *name, int nsteps);
+
+#endif /* SHMNETWORK_H_ */
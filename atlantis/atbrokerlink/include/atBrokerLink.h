@@ -23,6 +23,7 @@ typedef struct{
 	int shutdown;
 	int verbose;
 	double *valueList;
+	int valuesShared; /* Set when the last Set request left its values in the shared memory row */
 
 	/*
 	 * The additional mortality values that are used when atlantis links to other models such as EwE
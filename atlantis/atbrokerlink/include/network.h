@@ -8,14 +8,28 @@
 #ifndef NETWORK_H_
 #define NETWORK_H_
 
+#include <sys/types.h>
+#include "ShmNetwork.h"
+
+#define SHM_URL_PREFIX "shm://"
+#define SHM_LOOPBACK_URL_PREFIX "shmloop://"
+
 typedef struct
 {
 	/**
 	 * the URL of the model server to connect to; eg tcp://localhost:555
+	 * or shm://name for the shared memory transport on the local machine
+	 * (shmloop://name runs the loopback partner against it).
 	 */
 	char *modelURL;
 	void *context;
 	void *socket;
+
+	/* Shared memory transport - shm is NULL when using zmq */
+	char *shmName;
+	int shmLoopback;
+	pid_t loopbackPid;
+	ShmNetwork *shm;
 }Network;
 
 
@@ -40,6 +54,18 @@ void Network_Initialise(Network *network, char *modelurl);
 int Network_Send(Network *network, Message *message);
 
 Message *Network_Receive(Network *network);
+
+/**
+ * Create the shared memory segment, once the polygons and groups are known.
+ * Does nothing for a zmq URL.
+ */
+int Network_Open_Fields(Network *network, int nbox, const int *boxIds, int ngroup, char **groupCodes);
+
+/**
+ * The shared row of values for the given field kind and group, or NULL
+ * if the transport has no shared field area.
+ */
+double *Network_Field(Network *network, int kind, int group);
 /**
  * This method is called once at the end of the broker's life-cycle. It may
  * be used to tear down connections, release resources, etc. It is an error
@@ -10,12 +10,35 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
+#include <sys/wait.h>
 #include "Message.h"
 #include "network.h"
 #include "NetworkError.h"
 
 void Network_Initialise(Network *network, char *modelurl) {
+	const char *shmName = NULL;
+
 	network->modelURL = strdup(modelurl);
+	network->shmName = NULL;
+	network->shmLoopback = 0;
+	network->loopbackPid = -1;
+	network->shm = NULL;
+	network->context = NULL;
+	network->socket = NULL;
+
+	if (strncmp(modelurl, SHM_URL_PREFIX, strlen(SHM_URL_PREFIX)) == 0) {
+		shmName = modelurl + strlen(SHM_URL_PREFIX);
+	} else if (strncmp(modelurl, SHM_LOOPBACK_URL_PREFIX, strlen(SHM_LOOPBACK_URL_PREFIX)) == 0) {
+		shmName = modelurl + strlen(SHM_LOOPBACK_URL_PREFIX);
+		network->shmLoopback = 1;
+	}
+	if (shmName != NULL) {
+		/* The segment is created in Network_Open_Fields once the sizes are known */
+		network->shmName = (char *) malloc(strlen(shmName) + 2);
+		sprintf(network->shmName, "%s%s", shmName[0] == '/' ? "" : "/", shmName);
+		return;
+	}
+
 	network->context = zmq_init(1);
 	network->socket = zmq_socket(network->context, ZMQ_REP);
 	zmq_bind(network->socket, network->modelURL);
@@ -27,6 +50,14 @@ Message *Network_Receive(Network *network) {
 	zmq_msg_t request;
 	Message *messageReceived;
 
+	if (network->shmName != NULL) {
+		if (network->shm == NULL) {
+			fprintf(stderr, "Network_Receive - shared memory segment %s has not been opened\n", network->shmName);
+			exit(-1);
+		}
+		return ShmNetwork_Receive(network->shm, SHM_TO_MODEL);
+	}
+
 	zmq_msg_init(&request);
 	result = zmq_recv(network->socket, &request, 0);
 	if (result == -1) {
@@ -48,6 +79,9 @@ int Network_Send(Network *network, Message *message) {
 	zmq_msg_t response;
 	int result;
 
+	if (network->shmName != NULL)
+		return ShmNetwork_Send(network->shm, SHM_TO_PARTNER, message);
+
 	/* Send the data */
 	zmq_msg_init_size(&response, message->size);
 	memcpy(zmq_msg_data(&response), message->bytes, message->size);
@@ -64,9 +98,53 @@ int Network_Send(Network *network, Message *message) {
 	return 0;
 }
 
+int Network_Open_Fields(Network *network, int nbox, const int *boxIds, int ngroup, char **groupCodes) {
+
+	if (network->shmName == NULL)
+		return 0;
+
+	network->shm = ShmNetwork_Create(network->shmName, nbox, boxIds, ngroup, groupCodes);
+	if (network->shm == NULL)
+		return -1;
+
+	if (network->shmLoopback) {
+		fflush(stdout);
+		network->loopbackPid = fork();
+		if (network->loopbackPid == -1) {
+			perror("Network_Open_Fields fork");
+			return -1;
+		}
+		if (network->loopbackPid == 0) {
+			/* Child - play the partner model then leave without running the model's exit handlers */
+			int failed = ShmLoopback_Run(network->shmName, SHM_LOOPBACK_STEPS);
+			fflush(stdout);
+			_exit(failed);
+		}
+	}
+	return 0;
+}
+
+double *Network_Field(Network *network, int kind, int group) {
+	if (network->shm == NULL)
+		return NULL;
+	return ShmNetwork_Field(network->shm, kind, group);
+}
+
 void Network_Close(Network *network) {
+	int status;
+
 	if(network->modelURL != NULL)
 		free(network->modelURL);
+	if (network->shmName != NULL) {
+		if (network->loopbackPid > 0) {
+			waitpid(network->loopbackPid, &status, 0);
+			if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+				fprintf(stderr, "Network_Close - shared memory loopback partner failed\n");
+		}
+		ShmNetwork_Close(network->shm);
+		free(network->shmName);
+		return;
+	}
 	zmq_close(network->socket);
 	zmq_term(network->context);
 }
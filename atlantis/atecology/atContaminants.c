@@ -837,7 +837,7 @@ int Species_Contaminant_Uptake(MSEBoxModel *bm, BoxLayerValues *boxLayerInfo, HA
                         propLevel = 1.0;
                     }
 
-                    propContam = drandom(0.0, propLevel);
+                    propContam = Util_Random(bm, rand_ecology_id, 0.0, propLevel);
                     pid = FunctGroupArray[sp].contamPropTracers[cohort][cIndex];
 
                     switch(habitat) {
@@ -1046,7 +1046,7 @@ int Group_Transfer_Contaminant(MSEBoxModel *bm, BoxLayerValues *boxLayerInfo, HA
             }
 
             
-            propContam = drandom(min_num, prop_exchanged);
+            propContam = Util_Random(bm, rand_ecology_id, min_num, prop_exchanged);
             pid = FunctGroupArray[toGuild].contamPropTracers[toCohort][cIndex];
             
       //fprintf(bm->logFile, "Calling %s_Prop_%s with index %d\n", FunctGroupArray[toGuild].name, bm->contaminantStructure[cIndex]->contaminant_name, pid);
@@ -1976,7 +1976,7 @@ void Get_Settler_Contaminants(MSEBoxModel *bm, int wclayer, int sp, int ngene, i
     double this_reprodContam, maternal_transfer_rate, cGroupLevel;
     double start_n = FunctGroupArray[sp].speciesParams[age_mat_id];
     double end_n = (double)FunctGroupArray[sp].numCohortsXnumGenes;
-    int cohort = (int)(floor(drandom(start_n, end_n))); // Find a random adult cohort to use
+    int cohort = (int)(floor(Util_Random(bm, rand_ecology_id, start_n, end_n))); // Find a random adult cohort to use
     
     if (flagmother > 0) {
         for (cIndex = 0; cIndex < bm->num_contaminants; cIndex++) {
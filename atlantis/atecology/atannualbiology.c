@@ -361,12 +361,12 @@ static void Init_Spawning(MSEBoxModel *bm, FILE *llogfp, int do_debug, int sp) {
         for (ngene = 0; ngene < FunctGroupArray[sp].numGeneTypes; ngene++) {
             larval_queue_extension = 0;
             if (bm->flagrandom) {
-                temp1 = drandom(-14.0, 14.0);
+                temp1 = Util_Random(bm, rand_recruit_id, -14.0, 14.0);
                 if (temp1 < 0.0)
                     VarTime1 = (int) (ceil(temp1 - 0.5));
                 else
                     VarTime1 = (int) (floor(temp1 + 0.5));
-                temp2 = drandom(-7.0, 7.0);
+                temp2 = Util_Random(bm, rand_recruit_id, -7.0, 7.0);
                 if (temp2 < 0.0)
                     VarTime2 = (int) (ceil(temp2 - 0.5));
                 else
@@ -1112,7 +1112,7 @@ static double Get_Init_Embryos(MSEBoxModel *bm, int species, int ngene, int stoc
             break;
         case rand_recruit: /* Random - follows lognormal */
             if (EMBRYO[species].readytospawn[stock_id] == 1)
-                EMBRYO[species].Larvae[stock_id][ngene][qid] = recSTOCK[species][stock_id] * sp_log_mult * Util_Logx_Result(-lognorm_mu, lognorm_sigma);
+                EMBRYO[species].Larvae[stock_id][ngene][qid] = recSTOCK[species][stock_id] * sp_log_mult * Util_Logx_Result(bm, -lognorm_mu, lognorm_sigma);
             break;
         case plank_recruit: /* Spawn is based on plankton levels (not just CHLa) */
             EMBRYO[species].Larvae[stock_id][ngene][qid] += recSTOCK[species][stock_id] * PP_sp * plankton / bm->ref_chl;
@@ -1202,7 +1202,7 @@ static double Get_Init_Embryos(MSEBoxModel *bm, int species, int ngene, int stoc
             temprec = (recSTOCK[species][stock_id] * BHalpha_sp * EMBRYO[species].Larvae[stock_id][ngene][qid] / (BHbeta_sp  + recSTOCK[species][stock_id] * EMBRYO[species].Larvae[stock_id][ngene][qid]));
             break;
         case BevHolt_rand_recruit: /* Spawn is based on Beverton Holt with lognormal variation and dependence on plankton levels */
-            step1 = Util_Logx_Result(-lognorm_mu, lognorm_sigma);
+            step1 = Util_Logx_Result(bm, -lognorm_mu, lognorm_sigma);
             step2 = (recSTOCK[species][stock_id] * BHalpha_sp * EMBRYO[species].Larvae[stock_id][ngene][qid] / (BHbeta_sp + bm->totfishpop[species] * stock_prop[species][stock_id])) * (plankton / bm->ref_chl);
             temprec = step2 * step1;
             break;
@@ -1267,7 +1267,7 @@ static double Get_Init_Embryos(MSEBoxModel *bm, int species, int ngene, int stoc
     // Check for any stochasticity added to this recruitment
     if ( FunctGroupArray[species].speciesParams[flag_recruit_stochastic_id] > 0) {
         step1 = temprec;
-        temprec = Util_Normx_Result(step1, norm_sigma);
+        temprec = Util_Normx_Result(bm, step1, norm_sigma);
     }
 
     ans = temprec;
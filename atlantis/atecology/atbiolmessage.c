@@ -1135,16 +1135,19 @@ void Open_Ecology_Output_Files(MSEBoxModel *bm) {
 	SSBfp = Init_SSB_File(bm);
 	/* Recruits for vertebrate stocks */
 	yoyfp = Init_YOY_File(bm);
-	/* Mortality estimates - simple overall estimates */
-	mortfp = Init_MortEst_File(bm);
-	/* Specific mortality estimates */
-	specificmortfp = Init_SpecificMortEst_File(bm);
-	/* Mortality estimates - per predator estimates */
-	mortppfp = Init_MortPerPredEst_File(bm);
-	specificmortppfp = Init_SpecificPredMortEst_File(bm);
-    predPropCheckfp = Init_PredPropCheck_File(bm);
-	/* Mortality estimates - simple overall estimates */
-	dietCheckfp = Init_DietCheck_File(bm);
+	if (bm->flagmortoutput) {
+		/* Mortality estimates - simple overall estimates */
+		mortfp = Init_MortEst_File(bm);
+		/* Specific mortality estimates */
+		specificmortfp = Init_SpecificMortEst_File(bm);
+		/* Mortality estimates - per predator estimates */
+		mortppfp = Init_MortPerPredEst_File(bm);
+		specificmortppfp = Init_SpecificPredMortEst_File(bm);
+		predPropCheckfp = Init_PredPropCheck_File(bm);
+	}
+	/* Diet check - realised diet proportions */
+	if (bm->flagdietoutput)
+		dietCheckfp = Init_DietCheck_File(bm);
     
     if(bm->flagdietcheck)
     	detaileddietCheckfp = Init_DetailedDietCheck_File(bm);
@@ -1293,7 +1296,7 @@ static FILE * Init_VirginBiom_File(MSEBoxModel *bm) {
 	sprintf(fname, "%sBiomIndx.txt", bm->startfname);
 
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL ) {
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL ) {
         quit("Init_VirginBiom_File: Can't open %s\n",fname);
     }
 
@@ -1472,7 +1475,7 @@ static FILE * Init_Regional_Biomass_File(MSEBoxModel *bm) {
 	sprintf(fname, "%sBiomReg.txt", bm->startfname);
 
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("Init_Regional_Biomass_File: Can't open %s\n",fname);
 
     /** Column definitions **/
@@ -1572,7 +1575,7 @@ static FILE * Init_YOY_File(MSEBoxModel *bm) {
 	sprintf(fname, "%sYOY.txt", bm->startfname);
 
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("Init_YOY_File: Can't open %s\n",fname);
 
     /** Column definitions **/
@@ -1639,7 +1642,7 @@ static FILE * Init_SSB_File(MSEBoxModel *bm) {
 	sprintf(fname, "%sSSB.txt", bm->startfname);
 
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("Init_SSB_File: Can't open %s\n",fname);
 
     /** Column definitions **/
@@ -1695,6 +1698,9 @@ static void Write_SSB(FILE *fid, MSEBoxModel *bm) {
  */
 void Ecology_Output_Mort_Estimates(MSEBoxModel *bm, FILE *llogfp) {
 
+	if (!bm->flagmortoutput)
+		return;
+
 	Write_Mort(mortfp, bm);
 	Write_SpecificMort(specificmortfp, bm);
     Write_PredPropCheck(predPropCheckfp, bm);
@@ -1709,6 +1715,9 @@ void Ecology_Output_Mort_Estimates(MSEBoxModel *bm, FILE *llogfp) {
  */
 void Ecology_Output_Mort_Per_Pred_Estimates(MSEBoxModel *bm, FILE *llogfp) {
 
+	if (!bm->flagmortoutput)
+		return;
+
 	Write_MortPerPred(mortppfp, bm);
 	Write_SpecificPredMort(specificmortppfp, bm);
 
@@ -1730,7 +1739,7 @@ static FILE * Init_MortEst_File(MSEBoxModel *bm) {
 	sprintf(fname, "%sMort.txt", bm->startfname);
 
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("Init_MortEst_File: Can't open %s\n",fname);
 
     /** Column definitions **/
@@ -1790,7 +1799,7 @@ static void Write_Mort(FILE *fid, MSEBoxModel *bm) {
 			}
 
 			Mest = mort_scale * (natDead_N / (start_N + small_num));
-			fprintf(fid, " %e", Mest);
+			Util_TextOut_E(fid, Mest);
 		}
 	}
 	/* Write F values */
@@ -1812,7 +1821,7 @@ static void Write_Mort(FILE *fid, MSEBoxModel *bm) {
 				mort_scale = 365.0 / (365.0 - update_date);
 			}
 			Fest = mort_scale * (catch_N / (start_N + small_num));
-			fprintf(fid, " %e", Fest);
+			Util_TextOut_E(fid, Fest);
 		}
 	}
 	fprintf(fid, "\n");
@@ -1837,7 +1846,7 @@ FILE * Init_SpecificMortEst_File(MSEBoxModel *bm)
     printf("Creating %s\n",fname);
 
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("initMortFile: Can't open %s\n",fname);
 
     /** Column definitions **/
@@ -1903,7 +1912,7 @@ static void Write_SpecificMort(FILE *fid, MSEBoxModel *bm)
         if (flag_sp) {
         	for(cohort=0; cohort<FunctGroupArray[sp].numCohortsXnumGenes; cohort++) {
         		for(stock=0; stock<FunctGroupArray[sp].numStocks; stock++){
-        			fprintf(fid," %e", bm->calcTrackedMort[sp][cohort][stock][finalM1_id]);
+        			Util_TextOut_E(fid, bm->calcTrackedMort[sp][cohort][stock][finalM1_id]);
         		}
         	}
         }
@@ -1914,7 +1923,7 @@ static void Write_SpecificMort(FILE *fid, MSEBoxModel *bm)
         if (flag_sp) {
         	for(cohort=0; cohort<FunctGroupArray[sp].numCohortsXnumGenes; cohort++) {
         		for(stock=0; stock<FunctGroupArray[sp].numStocks; stock++){
-        			fprintf(fid," %e", bm->calcTrackedMort[sp][cohort][stock][finalM2_id]);
+        			Util_TextOut_E(fid, bm->calcTrackedMort[sp][cohort][stock][finalM2_id]);
         		}
         	}
         }
@@ -1925,7 +1934,7 @@ static void Write_SpecificMort(FILE *fid, MSEBoxModel *bm)
         if (flag_sp) {
         	for(cohort=0; cohort<FunctGroupArray[sp].numCohortsXnumGenes; cohort++) {
         		for(stock=0; stock<FunctGroupArray[sp].numStocks; stock++){
-        			fprintf(fid," %e", bm->calcTrackedMort[sp][cohort][stock][finalF_id]);
+        			Util_TextOut_E(fid, bm->calcTrackedMort[sp][cohort][stock][finalF_id]);
         		}
         	}
         }
@@ -1952,7 +1961,7 @@ static FILE * Init_SpecificPredMortEst_File(MSEBoxModel *bm)
     printf("Creating %s\n",fname);
 
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("initMortFile: Can't open %s\n",fname);
 
     /** Column definitions **/
@@ -1997,7 +2006,7 @@ static void Write_SpecificPredMort(FILE *fid, MSEBoxModel *bm)
         			for (pred=0; pred<totnum; pred++) {
                         flag_sppred = (int) (FunctGroupArray[pred].speciesParams[flag_id]);
                         if (flag_sppred) {
-                            fprintf(fid," %e", bm->calcTrackedPredMort[sp][cohort][stock][pred][final_id]);
+                            Util_TextOut_E(fid, bm->calcTrackedPredMort[sp][cohort][stock][pred][final_id]);
                         }
         			}
         			fprintf(fid,"\n");
@@ -2024,7 +2033,7 @@ static FILE * Init_PredPropCheck_File(MSEBoxModel *bm) {
     sprintf(fname, "%sPredPropCheck.txt", bm->startfname);
     
     /** Create file **/
-    if ((fid = Util_fopen(bm, fname, "w")) == NULL)
+    if ((fid = Util_TextOut_fopen(bm, fname)) == NULL)
         quit("Init_PredPropCheck_File: Can't open %s\n", fname);
     
     /** Column definitions **/
@@ -2081,7 +2090,7 @@ static void Write_PredPropCheck(FILE *fid, MSEBoxModel *bm) {
                     for (pred=0; pred<totnum; pred++) {
                         flag_sppred = (int) (FunctGroupArray[pred].speciesParams[flag_id]);
                         if (flag_sppred) {
-                            fprintf(fid," %e", bm->calcTrackedPredMort[sp][cohort][stock][pred][final_id] / totpred);
+                            Util_TextOut_E(fid, bm->calcTrackedPredMort[sp][cohort][stock][pred][final_id] / totpred);
                         }
                     }
                     fprintf(fid,"\n");
@@ -2109,7 +2118,7 @@ static FILE * Init_MortPerPredEst_File(MSEBoxModel *bm) {
 	sprintf(fname, "%sMortPerPred.txt", bm->startfname);
 
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("Init_MortPerPredEst_File: Can't open %s\n",fname);
 
     /** Column definitions **/
@@ -2208,13 +2217,13 @@ static void Write_MortPerPred(FILE *fid, MSEBoxModel *bm) {
 			//				caseid = expect_id;
 			//				mort_scale = 365.0 / (365.0 - update_date);
 			//			}
-			fprintf(fid, " %e", start_N);
-			fprintf(fid, " %e", mort_scale * bm->calcMLinearMort[sp][caseid] / (start_N + small_num));
-			fprintf(fid, " %e", mort_scale * bm->calcMQuadMort[sp][caseid] / (start_N + small_num));
+			Util_TextOut_E(fid, start_N);
+			Util_TextOut_E(fid, mort_scale * bm->calcMLinearMort[sp][caseid] / (start_N + small_num));
+			Util_TextOut_E(fid, mort_scale * bm->calcMQuadMort[sp][caseid] / (start_N + small_num));
 			if(bm->external_mortality){
-				fprintf(fid, " %e", mort_scale * bm->calcELinearMort[sp][caseid] / (start_N + small_num));
+				Util_TextOut_E(fid, mort_scale * bm->calcELinearMort[sp][caseid] / (start_N + small_num));
 			}
-			fprintf(fid, " %e", mort_scale * bm->calcMPredMort[sp][caseid] / (start_N + small_num));
+			Util_TextOut_E(fid, mort_scale * bm->calcMPredMort[sp][caseid] / (start_N + small_num));
 
 			for (pred = 0; pred < totnum; pred++) {
 				flag_sp = (int) (FunctGroupArray[pred].speciesParams[flag_id]);
@@ -2222,7 +2231,7 @@ static void Write_MortPerPred(FILE *fid, MSEBoxModel *bm) {
 					natDead_N = bm->calcMnumPerPred[sp][pred][caseid];
 					//total += natDead_N;
 					Mest = mort_scale * (natDead_N / (start_N + small_num));
-					fprintf(fid, " %e", Mest);
+					Util_TextOut_E(fid, Mest);
 					totalPredMort = totalPredMort + Mest;
 				}
 			}
@@ -2246,9 +2255,10 @@ void Output_Diet_Check(MSEBoxModel *bm) {
 
     // Don't bother doing it on day 0 as nothing to print out so is a waste
     if (bm->t) {
-        Update_Diets_Output(bm);
-
-        Write_DietCheck(dietCheckfp, bm);
+        if (bm->flagdietoutput) {
+            Update_Diets_Output(bm);
+            Write_DietCheck(dietCheckfp, bm);
+        }
         if (bm->flagdietcheck) {
             Write_DetailedDietCheck(detaileddietCheckfp, bm);
         }
@@ -2307,7 +2317,7 @@ static FILE * Init_DietCheck_File(MSEBoxModel *bm) {
 	sprintf(fname, "%sDietCheck.txt", bm->startfname);
 
 	/** Create file **/
-	if ((fid = Util_fopen(bm, fname, "w")) == NULL)
+	if ((fid = Util_TextOut_fopen(bm, fname)) == NULL)
 		quit("Init_DietCheck_File: Can't open %s\n", fname);
 
     /** Column definitions **/
@@ -2341,7 +2351,7 @@ static FILE * Init_DetailedDietCheck_File(MSEBoxModel *bm) {
     sprintf(fname, "%sDetailedDietCheck.txt", bm->startfname);
     
     /** Create file **/
-    if ((fid = Util_fopen(bm, fname, "w")) == NULL)
+    if ((fid = Util_TextOut_fopen(bm, fname)) == NULL)
         quit("Init_DetailedDietCheck_File: Can't open %s\n", fname);
     
     /** Column definitions **/
@@ -2385,7 +2395,7 @@ static void Write_DietCheck(FILE *fid, MSEBoxModel *bm) {
         			for (prey=0; prey<totnum; prey++) {
                         flag_spprey = (int) (FunctGroupArray[prey].speciesParams[flag_id]);
                         if (flag_spprey) {
-                            fprintf(fid," %e", DIET_check[sp][cohort][stock][prey][final_id]);
+                            Util_TextOut_E(fid, DIET_check[sp][cohort][stock][prey][final_id]);
                         }
         			}
         			fprintf(fid,"\n");
@@ -2432,14 +2442,14 @@ static void Write_DetailedDietCheck(FILE *fid, MSEBoxModel *bm) {
                             for (prey=0; prey<totnum; prey++) {
                                 flag_spprey = (int) (FunctGroupArray[prey].speciesParams[flag_id]);
                                 if (flag_spprey) {
-                                    fprintf(fid," %e", (bm->totDiet[b][k][sp][cohort][prey] / totdiet));
+                                    Util_TextOut_E(fid, (bm->totDiet[b][k][sp][cohort][prey] / totdiet));
                                 }
                             }
                         } else {
                             for (prey=0; prey<totnum; prey++) {
                                 flag_spprey = (int) (FunctGroupArray[prey].speciesParams[flag_id]);
                                 if (flag_spprey) {
-                                    fprintf(fid," %e", bm->totDiet[b][k][sp][cohort][prey] * mg_2_tonne * bm->X_CN);
+                                    Util_TextOut_E(fid, bm->totDiet[b][k][sp][cohort][prey] * mg_2_tonne * bm->X_CN);
                                 }
                             }
                         }
@@ -2462,14 +2472,14 @@ static void Write_DetailedDietCheck(FILE *fid, MSEBoxModel *bm) {
                             for (prey=0; prey<totnum; prey++) {
                                 flag_spprey = (int) (FunctGroupArray[prey].speciesParams[flag_id]);
                                 if (flag_spprey) {
-                                    fprintf(fid," %e", (bm->totDiet[b][bm->wcnz+k][sp][cohort][prey] / totdiet));
+                                    Util_TextOut_E(fid, (bm->totDiet[b][bm->wcnz+k][sp][cohort][prey] / totdiet));
                                 }
                             }
                         } else {
                             for (prey=0; prey<totnum; prey++) {
                                 flag_spprey = (int) (FunctGroupArray[prey].speciesParams[flag_id]);
                                 if (flag_spprey) {
-                                    fprintf(fid," %e", bm->totDiet[b][bm->wcnz+k][sp][cohort][prey] * mg_2_tonne * bm->X_CN);
+                                    Util_TextOut_E(fid, bm->totDiet[b][bm->wcnz+k][sp][cohort][prey] * mg_2_tonne * bm->X_CN);
                                 }
                             }
                         }
@@ -2520,7 +2530,7 @@ FILE * Init_Migration_File(MSEBoxModel *bm)
     sprintf(fname,"%sMigration.txt",bm->startfname);
 
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("Init_Migration_File: Can't open %s\n",fname);
 
     /** Column definitions **/
@@ -2626,31 +2636,31 @@ void Write_Migration_File(FILE *fid, MSEBoxModel *bm){
                         }
                     }
                     
-					fprintf(fid, " %e", juv_mig_sum * bm->X_CN * mg_2_tonne);
-					fprintf(fid, " %e", juv_sum * bm->X_CN * mg_2_tonne);
-					fprintf(fid, " %e",( juv_mig_sum * bm->X_CN * mg_2_tonne) / (juv_sum * bm->X_CN * mg_2_tonne));
+					Util_TextOut_E(fid, juv_mig_sum * bm->X_CN * mg_2_tonne);
+					Util_TextOut_E(fid, juv_sum * bm->X_CN * mg_2_tonne);
+					Util_TextOut_E(fid, ( juv_mig_sum * bm->X_CN * mg_2_tonne) / (juv_sum * bm->X_CN * mg_2_tonne));
 
-					fprintf(fid, " %e", ad_mig_sum * bm->X_CN * mg_2_tonne);
-					fprintf(fid, " %e", ad_sum * bm->X_CN * mg_2_tonne);
-					fprintf(fid, " %e",( ad_mig_sum * bm->X_CN * mg_2_tonne) / (ad_sum * bm->X_CN * mg_2_tonne));
+					Util_TextOut_E(fid, ad_mig_sum * bm->X_CN * mg_2_tonne);
+					Util_TextOut_E(fid, ad_sum * bm->X_CN * mg_2_tonne);
+					Util_TextOut_E(fid, ( ad_mig_sum * bm->X_CN * mg_2_tonne) / (ad_sum * bm->X_CN * mg_2_tonne));
 
            		}
 			} else {
 				for(n = 0; n < FunctGroupArray[sp].numCohortsXnumGenes; n++){
 					for(i = spmigrate_done; i < spmigrate; i++){
-						fprintf(fid, " %e", MIGRATION[sp].DEN[n][i] * bm->X_CN * mg_2_tonne);
-						fprintf(fid, " %e", bm->totagepop[sp][n] * bm->X_CN * mg_2_tonne);
+						Util_TextOut_E(fid, MIGRATION[sp].DEN[n][i] * bm->X_CN * mg_2_tonne);
+						Util_TextOut_E(fid, bm->totagepop[sp][n] * bm->X_CN * mg_2_tonne);
 						if(FunctGroupArray[sp].groupAgeType == AGE_STRUCTURED_BIOMASS){
 							if(bm->totagepop[sp][n] > 0){
-								fprintf(fid, " %e",( MIGRATION[sp].DEN[n][i] * bm->X_CN * mg_2_tonne) / ( bm->totagepop[sp][n] * bm->X_CN * mg_2_tonne));
+								Util_TextOut_E(fid, ( MIGRATION[sp].DEN[n][i] * bm->X_CN * mg_2_tonne) / ( bm->totagepop[sp][n] * bm->X_CN * mg_2_tonne));
 							}else{
-								fprintf(fid, " %e", 0.0);
+								Util_TextOut_E(fid, 0.0);
 							}
 						}else{
 							if(bm->totbiom[sp] > 0){
-								fprintf(fid, " %e",( MIGRATION[sp].DEN[n][i] * bm->X_CN * mg_2_tonne) / ( bm->totbiom[sp] * bm->X_CN * mg_2_tonne));
+								Util_TextOut_E(fid, ( MIGRATION[sp].DEN[n][i] * bm->X_CN * mg_2_tonne) / ( bm->totbiom[sp] * bm->X_CN * mg_2_tonne));
 							}else{
-								fprintf(fid, " %e", 0.0);
+								Util_TextOut_E(fid, 0.0);
 							}
 						}
 					}
@@ -2675,7 +2685,7 @@ FILE * Init_MigrationDump_File(MSEBoxModel *bm)
     sprintf(fname,"%sMigrationArray.txt",bm->startfname);
     
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("Init_MigrationDump_File: Can't open %s\n",fname);
     
     /** Column definitions **/
@@ -2744,7 +2754,7 @@ FILE *Init_Size_Data_File(MSEBoxModel *bm){
 	printf("Creating %s\n",fname);
 
 	/** Create file **/
-	if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+	if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
 		quit("Init_Size_Data_File: Can't open %s\n",fname);
 
 	/** Column definitions **/
@@ -2811,10 +2821,10 @@ void Write_Size_Data_File(FILE *fid, MSEBoxModel *bm){
 						RNsum= 0;
 					}
 					biomassSum = DENsum * (SNsum + RNsum)* bm->X_CN * mg_2_tonne;
-					fprintf(fid, " %e", DENsum);
-					fprintf(fid, " %e", SNsum);
-					fprintf(fid, " %e", RNsum);
-					fprintf(fid, " %e", biomassSum);
+					Util_TextOut_E(fid, DENsum);
+					Util_TextOut_E(fid, SNsum);
+					Util_TextOut_E(fid, RNsum);
+					Util_TextOut_E(fid, biomassSum);
 				}
 			}
 		}
@@ -2865,10 +2875,10 @@ void Write_Size_At_Age_Data_File(FILE *fid, MSEBoxModel *bm){
                         RNsum= 0;
                     }
                     biomassSum = DENsum * (SNsum + RNsum)* bm->X_CN * mg_2_tonne;
-                    fprintf(fid, " %e", DENsum);
-                    fprintf(fid, " %e", SNsum);
-                    fprintf(fid, " %e", RNsum);
-                    fprintf(fid, " %e", biomassSum);
+                    Util_TextOut_E(fid, DENsum);
+                    Util_TextOut_E(fid, SNsum);
+                    Util_TextOut_E(fid, RNsum);
+                    Util_TextOut_E(fid, biomassSum);
                 }
             }
         }
@@ -2900,7 +2910,7 @@ static FILE * Init_MacrophyteBiom_File(MSEBoxModel *bm) {
 	printf("Creating %s\n", fname);
 
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("Init_MacrophyteBiom_File: Can't open %s\n",fname);
 
     /** Column definitions **/
@@ -2937,7 +2947,7 @@ static void Write_MacrophyteBiomass(FILE *fid, MSEBoxModel *bm) {
 	for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
 		if(FunctGroupArray[sp].groupType == SEAGRASS){
 			for (cohort = 0; cohort < FunctGroupArray[sp].numCohortsXnumGenes; cohort++) {
-				fprintf(fid, " %e", bm->totagepop[sp][cohort] * bm->X_CN * mg_2_tonne);
+				Util_TextOut_E(fid, bm->totagepop[sp][cohort] * bm->X_CN * mg_2_tonne);
 			}
 		}
 	}
@@ -2961,7 +2971,7 @@ static FILE * Init_AgeBiom_File(MSEBoxModel *bm) {
 	printf("Creating %s\n", fname);
 
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("Init_AgeBiom_File: Can't open %s\n",fname);
 
     /** Column definitions **/
@@ -2998,7 +3008,7 @@ static void Write_AgeBiomass(FILE *fid, MSEBoxModel *bm) {
 	for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
 		if ( (int)(FunctGroupArray[sp].speciesParams[flag_id])){
 			for (cohort = 0; cohort < FunctGroupArray[sp].numCohortsXnumGenes; cohort++) {
-				fprintf(fid, " %e", bm->totagepop[sp][cohort] * bm->X_CN * mg_2_tonne);
+				Util_TextOut_E(fid, bm->totagepop[sp][cohort] * bm->X_CN * mg_2_tonne);
 			}
 		}
 	}
@@ -3021,7 +3031,7 @@ static FILE * Init_AnnualAgeBiom_File(MSEBoxModel *bm) {
     printf("Creating %s\n", fname);
     
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("Init_AnnualAgeBiom_File: Can't open %s\n",fname);
     
     /** Column definitions **/
@@ -3066,7 +3076,7 @@ static void Write_AnnualAgeBiomass(FILE *fid, MSEBoxModel *bm) {
                 //this_cohort = 0;
                 for (cohort = 0; cohort < FunctGroupArray[sp].numCohortsXnumGenes; cohort++) {
                     for (k = 0; k < FunctGroupArray[sp].ageClassSize; k++) {
-                        fprintf(fid, " %e", bm->totagepop[sp][cohort] * bm->X_CN * mg_2_tonne * bm->tempPopRatio[i][sp][cohort][k]);
+                        Util_TextOut_E(fid, bm->totagepop[sp][cohort] * bm->X_CN * mg_2_tonne * bm->tempPopRatio[i][sp][cohort][k]);
                     }
                     //this_cohort++;
                 }
@@ -3093,7 +3103,7 @@ static FILE * Init_BoxLight_File(MSEBoxModel *bm) {
 	printf("Creating %s\n", fname);
 
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("Init_BoxLight_File: Can't open %s\n",fname);
 
     fprintf(fid, "Proportion of sun hours per timestep.\n");
@@ -3148,7 +3158,7 @@ static FILE * Init_BoxBiomass_File(MSEBoxModel *bm) {
 	printf("Creating %s\n", fname);
 
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("Init_BoxBiomass_File: Can't open %s\n",fname);
 
 
@@ -3188,7 +3198,7 @@ static void Write_BoxBiomass(FILE *fid, MSEBoxModel *bm) {
 
 		for(sp = 0; sp < bm->K_num_tot_sp; sp++){
 			if ( (int)(FunctGroupArray[sp].speciesParams[flag_id])){
-				fprintf(fid, " %e", bm->boxBiomass[b][sp] * bm->X_CN * mg_2_tonne);
+				Util_TextOut_E(fid, bm->boxBiomass[b][sp] * bm->X_CN * mg_2_tonne);
 			}
 
 		}
@@ -611,6 +611,9 @@ void Ecology_Init(MSEBoxModel *bm, FILE *llogfp) {
 	/* Allocate the rest of the biology arrays */
 	Allocate_Arrays_Post_Load(bm, llogfp);
 
+	/* Group the species by temperature correction method for Parameter_Q10 */
+	Ecology_Setup_Q10_Groups(bm);
+
 	/* Set indices of all tracers and variables */
 	Initialise_Arrays(bm);
 
@@ -2329,6 +2332,9 @@ void Ecology_Free(MSEBoxModel *bm) {
 	free1d(sizeMinMax);
 	free2d(spSTOCKprop);
 	i_free2d(starve_vert);
+	i_free2d(q10_group_sp);
+	i_free1d(q10_group_nsp);
+	i_free1d(q10_prev_humped);
 	free2d(stock_prop);
 	free2d(sumSTOCK);
 	free2d(step1distrib);
@@ -2338,6 +2344,8 @@ void Ecology_Free(MSEBoxModel *bm) {
     printf("freesing movement related arrays\n");
     
 	free2d(tempdistrib);
+	free3d(tempdistrib_thread);
+	free3d(step1distrib_thread);
 	free2d(totden);
     free2d(boxden);
     free4d(currentden);
@@ -2866,6 +2874,9 @@ void Allocate_Arrays_Post_Load(MSEBoxModel *bm, FILE *llogfp) {
 
 	spSTOCKprop = (double **) alloc2d(ncohorts * ngenetypes, nstock);
 	starve_vert = Util_Alloc_Init_2D_Int(ncells, bm->K_num_tot_sp, 0);
+	q10_group_sp = Util_Alloc_Init_2D_Int(bm->K_num_tot_sp, num_q10_methods, 0);
+	q10_group_nsp = Util_Alloc_Init_1D_Int(num_q10_methods, 0);
+	q10_prev_humped = Util_Alloc_Init_1D_Int(bm->K_num_tot_sp, -1);
 	bm->stock_struct_prop = (double ***) alloc3d(nstock, ncohorts * ngenetypes, bm->K_num_tot_sp);
 	stock_prop = (double **) alloc2d(nstock, bm->K_num_tot_sp);
 	sumSTOCK = (double **) alloc2d(bm->maxspage, nstock);
@@ -2873,6 +2884,9 @@ void Allocate_Arrays_Post_Load(MSEBoxModel *bm, FILE *llogfp) {
     stock_done = Util_Alloc_Init_1D_Int(bm->K_num_stocks_per_sp, 0);
 
 	tempdistrib = (double **) alloc2d(bm->K_num_max_stages, bm->wcnz);
+	/* Per thread copies of tempdistrib and step1distrib for the threaded vertebrate movement */
+	tempdistrib_thread = (double ***) alloc3d(bm->K_num_max_stages, bm->wcnz, Util_Get_Num_Threads(bm));
+	step1distrib_thread = (double ***) alloc3d(bm->K_num_max_stages, bm->wcnz, Util_Get_Num_Threads(bm));
 	bm->tempPopRatio = (double ****) alloc4d(bm->maxspage, ncohorts * ngenetypes, bm->K_num_tot_sp, nstock);
 	bm->totbiom = Util_Alloc_Init_1D_Double(ntotsp + 1, 0.0);
 	bm->groupTotCatch = Util_Alloc_Init_2D_Double(bm->K_num_max_cohort * bm->K_num_max_genetypes, bm->K_num_tot_sp, 0.0);
@@ -1176,7 +1176,7 @@ void Ecology_Find_Embryoes(MSEBoxModel *bm, int species, int stock_id, double pl
 			break;
 		case rand_recruit: /* Random - follows lognormal */
 			if (EMBRYO[species].readytospawn[stock_id] == 1)
-				EMBRYO[species].Larvae[stock_id][ngene][qid] = recSTOCK[species][stock_id] * sp_log_mult * Util_Logx_Result(-lognorm_mu, lognorm_sigma);
+				EMBRYO[species].Larvae[stock_id][ngene][qid] = recSTOCK[species][stock_id] * sp_log_mult * Util_Logx_Result(bm, -lognorm_mu, lognorm_sigma);
 			break;
 		case plank_recruit: /* Spawn is based on plankton levels (not just CHLa) */
 			EMBRYO[species].Larvae[stock_id][ngene][qid] += recSTOCK[species][stock_id] * PP_sp * plankton / bm->ref_chl;
@@ -1428,7 +1428,7 @@ void Get_Recruits(MSEBoxModel *bm, int species, int stock_id, double plankton, F
             break;
         case BevHolt_rand_recruit: /* Spawn is based on Beverton Holt with lognormal variation and
 		 dependence on plankton levels */
-			step1 = Util_Logx_Result(-lognorm_mu, lognorm_sigma);
+			step1 = Util_Logx_Result(bm, -lognorm_mu, lognorm_sigma);
 			step2 = (recSTOCK[species][stock_id] * BHalpha_sp * EMBRYO[species].Larvae[stock_id][ngene][qid] / (BHbeta_sp + bm->totfishpop[species] * stock_prop[species][stock_id])) * (plankton / bm->ref_chl);
 			temprec = step2 * step1;
 			break;
@@ -1533,7 +1533,7 @@ void Get_Recruits(MSEBoxModel *bm, int species, int stock_id, double plankton, F
         // Check for any stochasticity added to this recruitment
         if ( FunctGroupArray[species].speciesParams[flag_recruit_stochastic_id] > 0) {
             step1 = temprec;
-            temprec = Util_Normx_Result(step1, norm_sigma);
+            temprec = Util_Normx_Result(bm, step1, norm_sigma);
         }
         
         // Store the final number of recruits
@@ -4564,7 +4564,7 @@ void Ecology_Find_Invert_Spawn(MSEBoxModel *bm, int species, double spawning_bio
 			local_spawn_biomass = PP_sp * CHLa / bm->ref_chl;
 			break;
 		case rand_recruit: /* Random - follows lognormal */
-			local_spawn_biomass = sp_log_mult * Util_Logx_Result(-lognorm_mu, lognorm_sigma);
+			local_spawn_biomass = sp_log_mult * Util_Logx_Result(bm, -lognorm_mu, lognorm_sigma);
 			break;
 		case plank_recruit: /* Spawn is based on plankton levels (not just CHLa) */
 			local_spawn_biomass = PP_sp * plankton / bm->ref_chl;
@@ -4709,7 +4709,7 @@ double Ecology_Find_Invert_Recruits(MSEBoxModel *bm, int species, int ngene, int
 		break;
     case BevHolt_rand_recruit: /* Spawn is based on Beverton Holt with lognormal variation and
 	 dependence on plankton levels  - so uses spawn calculated above */
-		step1 = Util_Logx_Result(-lognorm_mu, lognorm_sigma);
+		step1 = Util_Logx_Result(bm, -lognorm_mu, lognorm_sigma);
 		step2 = ((stock_scalar1 * BHalpha_sp * spawning_biomass) / (BHbeta_sp + pop_spawning_biomass));
 		spawned_biomass = step1 * step2 * (plankton / bm->ref_chl);
 		break;
@@ -4761,7 +4761,7 @@ double Ecology_Find_Invert_Recruits(MSEBoxModel *bm, int species, int ngene, int
     // Check for any stochasticity added to this recruitment
     if ( FunctGroupArray[species].speciesParams[flag_recruit_stochastic_id] > 0) {
         step1 = spawned_biomass;
-        spawned_biomass = Util_Normx_Result(step1, norm_sigma);
+        spawned_biomass = Util_Normx_Result(bm, step1, norm_sigma);
     }
     
 	if (do_debug && (bm->which_check == species))
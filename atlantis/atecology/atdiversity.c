@@ -638,7 +638,7 @@ void Do_Phenotyic_Expression(MSEBoxModel *bm, int species, FILE *llogfp) {
                     for (ngene = 0; ngene < FunctGroupArray[species].numGeneTypes; ngene++){
                         if (ngene != ng) { // work out who wanders away first
                             if (ngene < (FunctGroupArray[species].numGeneTypes - 1))
-                                scalar = drandom(0.0, max_prop_shift);  // So get random re-assortment between phenotypes (from each gene type)
+                                scalar = Util_Random(bm, rand_ecology_id, 0.0, max_prop_shift);  // So get random re-assortment between phenotypes (from each gene type)
                             else
                                 scalar = 1.0;
                             num_here = scalar * dennow;
@@ -279,13 +279,13 @@ void Init_Migration(MSEBoxModel *bm, FILE *llogfp, int do_debug, int sp) {
 
                     /* Add wobble to dates if required */
                     if (bm->flagrandom) {
-                        temp3 = drandom(-mig_window, mig_window);
+                        temp3 = Util_Random(bm, rand_ecology_id, -mig_window, mig_window);
                         if (temp3 < 0.0)
                             VarTime3 = (int) (ceil(temp3 - 0.5));
                         else
                             VarTime3 = (int) (floor(temp3 + 0.5));
                         
-                        temp4 = drandom(-mig_window, mig_window);
+                        temp4 = Util_Random(bm, rand_ecology_id, -mig_window, mig_window);
                         if (temp4 < 0.0)
                             VarTime4 = (int) (ceil(temp4 - 0.5));
                         else
@@ -148,6 +148,7 @@
 double Check_Conditions(MSEBoxModel *bm, int sp, int n, int ij, int k, double ****newden);
 int Check_Realloc_Conditions(MSEBoxModel *bm, int sp, int n, int ij, int k);
 void Store_Min_Max_Avg(MSEBoxModel *bm, int sp);
+static void Vertical_Distribution_Calc(MSEBoxModel *bm, int ij, int species, double ****currentden, int enviro_depend, int day_part, int cohort, double **vdistrib, double **s1distrib, FILE *llogfp);
 
 /* Routines */
 static double Calculate_Migration_Proportion(MSEBoxModel *bm, FILE *llogfp, double dt, int sp, double start, double period, double IOBox){
@@ -871,6 +872,10 @@ void Ecology_Total_Verts_And_Migration(MSEBoxModel *bm, double dt, FILE *llogfp)
 	double migtime2;
 	double some_ice = 0.0, ice_effect;
     int do_debug2;
+    int move_threads, dist_threads, tid = 0;
+    unsigned int rand_pass;
+    RandStream box_rand;
+    double **vdistrib = tempdistrib;
     
 	updated_already = 0;
 
@@ -884,6 +889,17 @@ void Ecology_Total_Verts_And_Migration(MSEBoxModel *bm, double dt, FILE *llogfp)
 
 	mig_done = 0;
 
+	/* Work out how many threads can be used in the per box parts of the vertebrate movement.
+	 The clearance rate diagnostics are written per box so keep those in order, and contaminant
+	 tracking, environmental displacement (which writes into neighbouring boxes) and the movement
+	 debugging all touch shared state so those runs stay serial. */
+	move_threads = Util_Get_Num_Threads(bm);
+	if ((bm->debug == debug_biology_process) && (bm->dayt >= bm->checkstart) && (bm->dayt < bm->checkstop))
+		move_threads = 1;
+	dist_threads = move_threads;
+	if (bm->track_contaminants || (enviro_depend && bm->flagenviro_displace) || (bm->debug == debug_move))
+		dist_threads = 1;
+
 	if (verbose)
 		printf("Dealing with migration\n");
 
@@ -1519,7 +1535,11 @@ void Ecology_Total_Verts_And_Migration(MSEBoxModel *bm, double dt, FILE *llogfp)
 					/* Initialise totroc */
 					totroc[n] = 0.0;
 
-					/* Get details of feeding preferences */
+					/* Get details of feeding preferences. Each box only touches its own entries
+					 so the expensive clearance rate calculations can be spread across threads */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(move_threads) if(move_threads > 1) private(k, rij, rangeid, clear) firstprivate(rocstage)
+#endif
 					for (ij = 0; ij < bm->nbox; ij++) {
 						/* Initialise density record */
 						boxden[ij][n] = 0.0;
@@ -1594,7 +1614,14 @@ void Ecology_Total_Verts_And_Migration(MSEBoxModel *bm, double dt, FILE *llogfp)
                                     
                                     
                                 }
+							}
+						}
+					}
 
+					/* Now build the totals - done in box order so the sums don't depend on the number of threads used above */
+					for (ij = 0; ij < bm->nbox; ij++) {
+						if(bm->boxes[ij].type != BOUNDARY && bm->boxes[ij].type != LAND) {
+							if (sp_ddepend_move > sedentary_move) {
 								/* Calculate total potential growth across entire area for each species */
 								totroc[n] += roc[ij][n];
 
@@ -1677,8 +1704,21 @@ void Ecology_Total_Verts_And_Migration(MSEBoxModel *bm, double dt, FILE *llogfp)
             cells_checked = 0;
             cells_impacted = 0;
 
-            /* Determine final movement distributions */
+            /* Any random draws in the box loop come from each box's own substream of the ecology stream */
+            rand_pass = Util_Rand_New_Pass(bm, rand_ecology_id);
+
+            /* Determine final movement distributions - boxes are independent of each other (apart from
+             the cases that force dist_threads to 1) so can be spread across threads */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(dist_threads) if(dist_threads > 1) \
+	private(n, k, stock_id, stage, spawn_date, spawn_period, sp_spawn_now, vertdistrib, thiscase1, thiscase2, spawnmove, orig_newden, \
+		numScalar, numScalar_final, current_enviro, den_diff, DL_id, DR_id, rij, rangeid, check_done, adbox, chkbox, kk, is_suitable, \
+		juv_num, ad_num, not_done, ad_start_cohort, ad_cohort, vdistrib, tid, box_rand) \
+	firstprivate(spSpeed) reduction(+:cells_checked, cells_impacted)
+#endif
 			for (ij = 0; ij < bm->nbox; ij++) {
+				Util_Rand_Substream(bm, rand_ecology_id, rand_pass, (unsigned int)ij, &box_rand);
+
 				/* Vertical distribution - ignore */
 				if(bm->terrestrial_on && bm->boxes[ij].type == LAND){
 
@@ -1712,7 +1752,15 @@ void Ecology_Total_Verts_And_Migration(MSEBoxModel *bm, double dt, FILE *llogfp)
 					}
 				} else if (bm->boxes[ij].type != BOUNDARY) {
 
-					Get_Vertical_Distribution(bm, ij, sp, currentden, enviro_depend, day_part, -1, llogfp);
+					/* Each thread needs its own vertical distribution scratch space */
+					if (dist_threads > 1) {
+						tid = Util_Get_Thread_Num();
+						vdistrib = tempdistrib_thread[tid];
+						Vertical_Distribution_Calc(bm, ij, sp, currentden, enviro_depend, day_part, -1, vdistrib, step1distrib_thread[tid], llogfp);
+					} else {
+						vdistrib = tempdistrib;
+						Get_Vertical_Distribution(bm, ij, sp, currentden, enviro_depend, day_part, -1, llogfp);
+					}
 
 					/*
 					if((bm->dayt > bm->checkstart) && (sp == bm->which_check)){
@@ -1738,7 +1786,7 @@ void Ecology_Total_Verts_And_Migration(MSEBoxModel *bm, double dt, FILE *llogfp)
 							stage = FunctGroupArray[sp].cohort_stage[n];
 
 							/* Update stored vertdistrib value - so can condition catch timeseries if need be */
-							bm->boxes[ij].vert_vdistrib[sp][stage][k] = tempdistrib[k][stage];
+							bm->boxes[ij].vert_vdistrib[sp][stage][k] = vdistrib[k][stage];
 
 							/*
 							if((bm->dayt > bm->checkstart) && (sp == bm->which_check)){
@@ -1759,7 +1807,7 @@ void Ecology_Total_Verts_And_Migration(MSEBoxModel *bm, double dt, FILE *llogfp)
                                 as if ideal free distributed then determine ideal distribution */
                                 /* FIX -- may want to have depth based on roc too not just always at optimal,
                                 otherwise with conditions change may not see distribution changes */
-                                vertdistrib = tempdistrib[k][stage];
+                                vertdistrib = vdistrib[k][stage];
 
                                 if(!stage) {
                                     thiscase1 = 1;
@@ -1853,7 +1901,7 @@ void Ecology_Total_Verts_And_Migration(MSEBoxModel *bm, double dt, FILE *llogfp)
                             case sticky_ddepend:
                                 /* FIX -- may want to have depth based on roc too not just always at optimal,
                                     otherwise with conditions change may not see distribution changes */
-                                vertdistrib = tempdistrib[k][stage];
+                                vertdistrib = vdistrib[k][stage];
                                 /* Find other migration pressure */
     							spawnmove = this_HowFar * (FunctGroupArray[sp].distrib[ij][next_qrt][stage] - FunctGroupArray[sp].distrib[ij][qrt][stage]) + FunctGroupArray[sp].distrib[ij][qrt][stage];
                             
@@ -1917,12 +1965,12 @@ void Ecology_Total_Verts_And_Migration(MSEBoxModel *bm, double dt, FILE *llogfp)
                                     
                                 break;
                             case sedentary_move:
-                                vertdistrib = tempdistrib[k][stage];
+                                vertdistrib = vdistrib[k][stage];
                                 newden[sp][n][k][ij] = vertdistrib * boxden[ij][n];
                                 break;
                             case perscribed_move:
                                 /* Used prescribed migration routes */
-                                vertdistrib = tempdistrib[k][stage];
+                                vertdistrib = vdistrib[k][stage];
 
     							newden[sp][n][k][ij] = vertdistrib * (this_HowFar * (FunctGroupArray[sp].distrib[ij][next_qrt][stage] - FunctGroupArray[sp].distrib[ij][qrt][stage]) + FunctGroupArray[sp].distrib[ij][qrt][stage]);
 
@@ -1942,7 +1990,7 @@ void Ecology_Total_Verts_And_Migration(MSEBoxModel *bm, double dt, FILE *llogfp)
                                     Note HomeRangeTotal is proportion of the total population in each home range
                                     whereas rangewgt is the proportion of those in home range x in the current cell
                                     */
-                                vertdistrib = tempdistrib[k][stage];
+                                vertdistrib = vdistrib[k][stage];
 
                                 newden[sp][n][k][ij] = 0;
                                 for (rij = 0; rij < bm->boxes[ij].HomeRangeInfo[sp].n; rij++) {
@@ -2057,7 +2105,7 @@ void Ecology_Total_Verts_And_Migration(MSEBoxModel *bm, double dt, FILE *llogfp)
                                 juv_num = FunctGroupArray[sp].LocalPopCount[n];
                                 not_done = 1;
                                 if(juv_num > bm->min_dens){ // Only do i if juveniles present
-                                    ad_start_cohort = (int)(floor(drandom(start_n, end_n))); // Find random starting point so not always the youngest adutlts feeding the young
+                                    ad_start_cohort = (int)(floor(Util_Random_Substream(bm, &box_rand, start_n, end_n))); // Find random starting point so not always the youngest adutlts feeding the young
                                     for (ad_cohort = ad_start_cohort; ad_cohort < FunctGroupArray[sp].numCohortsXnumGenes; ad_cohort++) { // Iterate up age classes
                                         ad_num = FunctGroupArray[sp].LocalPopCount[ad_cohort];
                                         if(ad_num > bm->min_dens) {
@@ -2103,6 +2151,17 @@ void Ecology_Total_Verts_And_Migration(MSEBoxModel *bm, double dt, FILE *llogfp)
 				 Base distribution should put them on flats in flood tide
 				 */
 				if (flagchannel) {
+					/* The spread below uses the vertical distribution of the last box visited in the
+					 loop above, so if that loop was threaded recreate it in the shared tempdistrib */
+					if (dist_threads > 1) {
+						for (ij = bm->nbox - 1; ij >= 0; ij--) {
+							if (bm->boxes[ij].type != BOUNDARY && !(bm->terrestrial_on && bm->boxes[ij].type == LAND)) {
+								Get_Vertical_Distribution(bm, ij, sp, currentden, enviro_depend, day_part, -1, llogfp);
+								break;
+							}
+						}
+					}
+
 					for (n = 0; n < FunctGroupArray[sp].numCohortsXnumGenes; n++) {
 						stage = FunctGroupArray[sp].cohort_stage[n];
 						for (ij = 0; ij < bm->nbox; ij++) {
@@ -3818,8 +3877,9 @@ void Ecology_Invading_Species(MSEBoxModel *bm, double dt, FILE *llogfp) {
             tot_scalar += this_scalar;
             
             // Now do neighbouring boxes
-            for (chkbox = 0; chkbox < bm->boxes[b].nUniqueAdj; chkbox++) {
-                nb = bm->boxes[b].uniqueAdjBoxes[chkbox];
+            for (chkbox = bm->adj_start[b]; chkbox < bm->adj_start[b + 1]; chkbox++) {
+                nb = bm->adj_box[chkbox];
+                dist = bm->adj_dist[chkbox];
                 this_depth = bm->boxes[nb].botz;
                 if ((this_depth <= (-1.0 * FunctGroupArray[bm->InvaderIndex].speciesParams[mindepth_id])) && (this_depth >= (-1.0 * bm->InvaderMaxDepth))) {
                     for (n = bm->minInvaderAge; n < bm->maxInvaderAge; n++) {
@@ -3853,7 +3913,7 @@ void Ecology_Invading_Species(MSEBoxModel *bm, double dt, FILE *llogfp) {
                         if (sp_like) {  // Habitat found in potential new location
                             for (k = 0; k < bm->boxes[nb].nz; k++) {
                                 // Then check the environment
-                                go_there = Invade_Spread(bm, bm->InvaderIndex, llogfp, b, nb, k, &dist);
+                                go_there = Invade_Spread(bm, bm->InvaderIndex, llogfp, nb, k);
                                 found_food = 0;
                                 if (go_there) {  // Conditions suitable so check prey
                                     for (prey = 0; prey < bm->K_num_tot_sp; prey++) {
@@ -3928,8 +3988,8 @@ void Ecology_Invading_Species(MSEBoxModel *bm, double dt, FILE *llogfp) {
                 }
 
                 // Now do the invader dispersal
-                for (chkbox = 0; chkbox < bm->boxes[b].nUniqueAdj; chkbox++) {
-                    nb = bm->boxes[b].uniqueAdjBoxes[chkbox];
+                for (chkbox = bm->adj_start[b]; chkbox < bm->adj_start[b + 1]; chkbox++) {
+                    nb = bm->adj_box[chkbox];
                     for (k = 0; k < bm->boxes[nb].nz; k++) {
                         bk = k;
                         if(bk >= bm->boxes[nb].nz)
@@ -3982,7 +4042,7 @@ void Ecology_Invading_Species(MSEBoxModel *bm, double dt, FILE *llogfp) {
  *
  * These are used in vertebrate_reproduction to calculate the num_recruits.
  */
-int Invade_Spread(MSEBoxModel *bm, int sp, FILE *llogfp, int b, int nb, int k, double *dist ) {
+int Invade_Spread(MSEBoxModel *bm, int sp, FILE *llogfp, int nb, int k) {
     int temp_sensitive_sp = (int)(FunctGroupArray[sp].speciesParams[flagtempsensitive_id]);
     int salt_sensitive_sp = (int)(FunctGroupArray[sp].speciesParams[flagSaltSensitive_id]);
     double min_temp_sp = FunctGroupArray[sp].speciesParams[min_move_temp_id];
@@ -3996,10 +4056,6 @@ int Invade_Spread(MSEBoxModel *bm, int sp, FILE *llogfp, int b, int nb, int k, d
     int go_there = 0;
     double current_enviro;
 
-    double xdiff = bm->boxes[b].inside.x - bm->boxes[nb].inside.x;
-    double ydiff = bm->boxes[b].inside.y - bm->boxes[nb].inside.y;
-    *dist = sqrt(xdiff * xdiff + ydiff * ydiff);
-    
     if(!bm->flagtempdepend_move) { // Have turned off temperature dependent movement
         if(temp_sensitive_sp && bm->newmonth) {
             warn("Invade_Spread: Time: %e Zeroing temperature sensitivity for movement of %s even though flagtempsensitive %d as flagtempdepend_move = %d\n", bm->dayt, FunctGroupArray[sp].groupCode, temp_sensitive_sp, bm->flagtempdepend_move);
@@ -4129,10 +4185,21 @@ int Larval_Dispersal(MSEBoxModel *bm, int sp, FILE *llogfp) {
 /*
  * \brief Helper routine to determines vertical position in the water column - for age-structured groups (i.e. "vertebrates")
  *
+ * Result is left in the global tempdistrib array.
  */
 
 void Get_Vertical_Distribution(MSEBoxModel *bm, int ij, int species, double ****currentden, int enviro_depend, int day_part, int cohort, FILE *llogfp){
 
+	Vertical_Distribution_Calc(bm, ij, species, currentden, enviro_depend, day_part, cohort, tempdistrib, step1distrib, llogfp);
+}
+
+/*
+ * \brief Does the work for Get_Vertical_Distribution() using the scratch arrays supplied (vdistrib receives the
+ * final distribution) so that the threaded vertebrate movement code can give each thread its own copy.
+ *
+ */
+static void Vertical_Distribution_Calc(MSEBoxModel *bm, int ij, int species, double ****currentden, int enviro_depend, int day_part, int cohort, double **vdistrib, double **s1distrib, FILE *llogfp){
+
 	int layerk, diffdeep, k, tracker_id;
 	int flagdem = (int) (FunctGroupArray[species].speciesParams[flagdem_id]);
 	int maxdeep = bm->wcnz;
@@ -4162,20 +4229,20 @@ void Get_Vertical_Distribution(MSEBoxModel *bm, int ij, int species, double ****
 
 	// Initialise (just in case)
 	for (k = 0; k < bm->wcnz; k++) {
-		tempdistrib[k][juv_id] = 0.0;
-		tempdistrib[k][adult_id] = 0.0;
+		vdistrib[k][juv_id] = 0.0;
+		vdistrib[k][adult_id] = 0.0;
 	}
 
 	/* Load in overwintering or normal vertical distributions */
 	if(FunctGroupArray[species].isMobile){
 
 		for (k = 0; k < bm->wcnz; k++) {
-			step1distrib[k][juv_id] = FunctGroupArray[species].distrib_VERTICAL[day_part][k][juv_id];
-			step1distrib[k][tracker_id] = FunctGroupArray[species].distrib_VERTICAL[day_part][k][tracker_id];
+			s1distrib[k][juv_id] = FunctGroupArray[species].distrib_VERTICAL[day_part][k][juv_id];
+			s1distrib[k][tracker_id] = FunctGroupArray[species].distrib_VERTICAL[day_part][k][tracker_id];
 
 			if (FunctGroupArray[species].speciesParams[overwintering_id] > 0) {
-				step1distrib[k][juv_id] = FunctGroupArray[species].distrib_OVERWINTER[k][juv_id];
-				step1distrib[k][tracker_id] = FunctGroupArray[species].distrib_OVERWINTER[k][tracker_id];
+				s1distrib[k][juv_id] = FunctGroupArray[species].distrib_OVERWINTER[k][juv_id];
+				s1distrib[k][tracker_id] = FunctGroupArray[species].distrib_OVERWINTER[k][tracker_id];
 			}
 		}
 	} else {
@@ -4193,17 +4260,17 @@ void Get_Vertical_Distribution(MSEBoxModel *bm, int ij, int species, double ****
 		}
 
 		for (k = 0; k < bm->wcnz; k++) {
-			step1distrib[k][juv_id] = currentden[species][first_id][k][ij];
-			step1distrib[k][tracker_id] = currentden[species][second_id][k][ij];
+			s1distrib[k][juv_id] = currentden[species][first_id][k][ij];
+			s1distrib[k][tracker_id] = currentden[species][second_id][k][ij];
 		}
 	}
 
 	if(do_debug){
 		for (k = 0; k < bm->wcnz; k++) {
 			fprintf(llogfp,"Time: %e %s box %d-%d day_part: %d, step1-juv: %e (%e), step1-tracker: %e (%e), step1-adult: %e (%e) \n",
-				bm->dayt, FunctGroupArray[species].groupCode, ij, k, day_part, step1distrib[k][juv_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][juv_id],
-				 step1distrib[k][tracker_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][tracker_id],
-				   step1distrib[k][adult_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][adult_id]);
+				bm->dayt, FunctGroupArray[species].groupCode, ij, k, day_part, s1distrib[k][juv_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][juv_id],
+				 s1distrib[k][tracker_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][tracker_id],
+				   s1distrib[k][adult_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][adult_id]);
 		}
 	}
 
@@ -4227,70 +4294,70 @@ void Get_Vertical_Distribution(MSEBoxModel *bm, int ij, int species, double ****
 
 			if(cohort <= -1){
 				// Doing adults and juveniles in bulk - so make sure do juvenile case, adult done under tracker_id and store_id
-				sumnzj1 += step1distrib[layerk][juv_id];
-				sumnzj2 += step1distrib[k][juv_id];
+				sumnzj1 += s1distrib[layerk][juv_id];
+				sumnzj2 += s1distrib[k][juv_id];
 			} else {
 				// Doing a specific cohort - done under tracker id and store_id
 			}
-			sumnza1 += step1distrib[layerk][tracker_id];
-			sumnza2 += step1distrib[k][tracker_id];
+			sumnza1 += s1distrib[layerk][tracker_id];
+			sumnza2 += s1distrib[k][tracker_id];
 
 		}
 
 		if (sumnzj1 < sumnzj2) {
 			for (k = 0; k < bm->boxes[ij].nz; k++) {
-				tempdistrib[k][juv_id] = step1distrib[k][juv_id] / sumnzj2;
+				vdistrib[k][juv_id] = s1distrib[k][juv_id] / sumnzj2;
 			}
 
 		} else if (!sumnzj1) {
 			for (k = 0; k < bm->boxes[ij].nz; k++) {
-				tempdistrib[k][juv_id] = 0;
+				vdistrib[k][juv_id] = 0;
 			}
 
 			if (!flagdem) {
 				/* If pelagic */
 				k = bm->boxes[ij].nz - 1;
-				tempdistrib[k][juv_id] = 1;
+				vdistrib[k][juv_id] = 1;
 			} else {
 				/* If demersal */
 				k = 0;
-				tempdistrib[k][juv_id] = 1;
+				vdistrib[k][juv_id] = 1;
 			}
 		} else {
 			for (k = 0; k < bm->boxes[ij].nz; k++) {
 				layerk = k + diffdeep;
-				tempdistrib[k][0] = step1distrib[layerk][juv_id] / sumnzj1;
+				vdistrib[k][0] = s1distrib[layerk][juv_id] / sumnzj1;
 			}
 		}
 		if (sumnza1 < sumnza2) {
 			for (k = 0; k < bm->boxes[ij].nz; k++) {
-				tempdistrib[k][tracker_id] = step1distrib[k][tracker_id] / sumnza2;
+				vdistrib[k][tracker_id] = s1distrib[k][tracker_id] / sumnza2;
 			}
 		} else if (!sumnza1) {
 			for (k = 0; k < bm->boxes[ij].nz; k++) {
-				tempdistrib[k][tracker_id] = 0;
+				vdistrib[k][tracker_id] = 0;
 			}
 
 			if (!flagdem) {
 				/* If pelagic */
 				k = bm->boxes[ij].nz - 1;
-				tempdistrib[k][tracker_id] = 1;
+				vdistrib[k][tracker_id] = 1;
 			} else {
 				/* If demersal */
 				k = 0;
-				tempdistrib[k][tracker_id] = 1;
+				vdistrib[k][tracker_id] = 1;
 			}
 		} else {
 			for (k = 0; k < bm->boxes[ij].nz; k++) {
 				layerk = k + diffdeep;
-				tempdistrib[k][tracker_id] = step1distrib[layerk][tracker_id] / sumnza1;
+				vdistrib[k][tracker_id] = s1distrib[layerk][tracker_id] / sumnza1;
 			}
 		}
 
 	} else {
 		for (k = 0; k < bm->boxes[ij].nz; k++) {
-			tempdistrib[k][juv_id] = step1distrib[k][juv_id];
-			tempdistrib[k][tracker_id] = step1distrib[k][tracker_id];
+			vdistrib[k][juv_id] = s1distrib[k][juv_id];
+			vdistrib[k][tracker_id] = s1distrib[k][tracker_id];
 		}
 	}
 
@@ -4298,9 +4365,9 @@ void Get_Vertical_Distribution(MSEBoxModel *bm, int ij, int species, double ****
 	if(do_debug){
 		for (k = 0; k < bm->wcnz; k++) {
 			fprintf(llogfp,"Time: %e %s box %d-%d day_part: %d, temp-juv: %e (%e), temp-tracker: %e (%e), temp-adult: %e (%e) \n",
-				bm->dayt, FunctGroupArray[species].groupCode, ij, k, day_part, tempdistrib[k][juv_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][juv_id],
-					tempdistrib[k][tracker_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][tracker_id],
-					tempdistrib[k][adult_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][adult_id]);
+				bm->dayt, FunctGroupArray[species].groupCode, ij, k, day_part, vdistrib[k][juv_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][juv_id],
+					vdistrib[k][tracker_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][tracker_id],
+					vdistrib[k][adult_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][adult_id]);
 		}
 	}
 
@@ -4311,16 +4378,16 @@ void Get_Vertical_Distribution(MSEBoxModel *bm, int ij, int species, double ****
             if (FunctGroupArray[species].isLightEffected) {
                 current_enviro = bm->boxes[ij].tr[k][Light_Pollution_i];
                 if (current_enviro > 0) {
-                    tempdistrib[k][juv_id] *= (FunctGroupArray[species].speciesParams[light_coefft_id] / (current_enviro + small_num));
-                    tempdistrib[k][adult_id] *= (FunctGroupArray[species].speciesParams[light_coefft_id] / (current_enviro + small_num));
+                    vdistrib[k][juv_id] *= (FunctGroupArray[species].speciesParams[light_coefft_id] / (current_enviro + small_num));
+                    vdistrib[k][adult_id] *= (FunctGroupArray[species].speciesParams[light_coefft_id] / (current_enviro + small_num));
                 }
             }
             
             if (FunctGroupArray[species].isNoiseEffected) {
                 current_enviro = bm->boxes[ij].tr[k][Noise_Pollution_i];
                 if (current_enviro > 0) {
-                    tempdistrib[k][juv_id] *= (FunctGroupArray[species].speciesParams[noise_coefft_id] / (current_enviro + small_num));
-                    tempdistrib[k][adult_id] *= (FunctGroupArray[species].speciesParams[noise_coefft_id] / (current_enviro + small_num));
+                    vdistrib[k][juv_id] *= (FunctGroupArray[species].speciesParams[noise_coefft_id] / (current_enviro + small_num));
+                    vdistrib[k][adult_id] *= (FunctGroupArray[species].speciesParams[noise_coefft_id] / (current_enviro + small_num));
                 }
             }
             
@@ -4330,14 +4397,14 @@ void Get_Vertical_Distribution(MSEBoxModel *bm, int ij, int species, double ****
 			if (bm->flagtempdepend_move) {
 				current_enviro = bm->boxes[ij].tr[k][Temp_i];
 				if ((current_enviro < min_temp_sp) || (current_enviro > max_temp_sp)) {
-					tempdistrib[k][juv_id] = 0.0;
-					tempdistrib[k][adult_id] = 0.0;
+					vdistrib[k][juv_id] = 0.0;
+					vdistrib[k][adult_id] = 0.0;
 
 					if(do_debug){
 						fprintf(llogfp,"WARNING Time: %e %s box %d-%d day_part: %d, temp-juv: %e (%e), temp-tracker: %e (%e), temp-adult: %e (%e) current_enviro: %e, min_temp: %e, max_temp: %e\n",
-							bm->dayt, FunctGroupArray[species].groupCode, ij, k, day_part, tempdistrib[k][juv_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][juv_id],
-								tempdistrib[k][tracker_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][tracker_id],
-								tempdistrib[k][adult_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][adult_id],
+							bm->dayt, FunctGroupArray[species].groupCode, ij, k, day_part, vdistrib[k][juv_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][juv_id],
+								vdistrib[k][tracker_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][tracker_id],
+								vdistrib[k][adult_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][adult_id],
 								current_enviro, min_temp_sp, max_temp_sp);
 					}
 				}
@@ -4345,14 +4412,14 @@ void Get_Vertical_Distribution(MSEBoxModel *bm, int ij, int species, double ****
 			if (bm->flagsaltdepend) {
 				current_enviro = bm->boxes[ij].tr[k][Salinity_i];
 				if ((current_enviro < min_salt_sp) || (current_enviro > max_salt_sp)) {
-					tempdistrib[k][juv_id] = 0.0;
-					tempdistrib[k][adult_id] = 0.0;
+					vdistrib[k][juv_id] = 0.0;
+					vdistrib[k][adult_id] = 0.0;
 
 					if(do_debug){
 						fprintf(llogfp,"WARNING Time: %e %s box %d-%d day_part: %d, temp-juv: %e (%e), temp-tracker: %e (%e), temp-adult: %e (%e) current_enviro: %e, min_salt: %e, max_salt: %e\n",
-							bm->dayt, FunctGroupArray[species].groupCode, ij, k, day_part, tempdistrib[k][juv_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][juv_id],
-								tempdistrib[k][tracker_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][tracker_id],
-								tempdistrib[k][adult_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][adult_id],
+							bm->dayt, FunctGroupArray[species].groupCode, ij, k, day_part, vdistrib[k][juv_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][juv_id],
+								vdistrib[k][tracker_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][tracker_id],
+								vdistrib[k][adult_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][adult_id],
 								current_enviro, min_salt_sp, max_salt_sp);
 					}
 
@@ -4361,14 +4428,14 @@ void Get_Vertical_Distribution(MSEBoxModel *bm, int ij, int species, double ****
 			if (bm->flagO2depend) {
 				current_enviro = bm->boxes[ij].tr[k][Oxygen_i];
 				if (current_enviro < min_O2_sp) {
-					tempdistrib[k][juv_id] = 0.0;
-					tempdistrib[k][adult_id] = 0.0;
+					vdistrib[k][juv_id] = 0.0;
+					vdistrib[k][adult_id] = 0.0;
 
 					if(do_debug){
 						fprintf(llogfp,"WARNING Time: %e %s box %d-%d day_part: %d, temp-juv: %e (%e), temp-tracker: %e (%e), temp-adult: %e (%e) current_enviro: %e, min_O2: %e\n",
-							bm->dayt, FunctGroupArray[species].groupCode, ij, k, day_part, tempdistrib[k][juv_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][juv_id],
-								tempdistrib[k][tracker_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][tracker_id],
-								tempdistrib[k][adult_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][adult_id],
+							bm->dayt, FunctGroupArray[species].groupCode, ij, k, day_part, vdistrib[k][juv_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][juv_id],
+								vdistrib[k][tracker_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][tracker_id],
+								vdistrib[k][adult_id], FunctGroupArray[species].distrib_VERTICAL[day_part][k][adult_id],
 								current_enviro, min_O2_sp);
 					}
 
@@ -2279,7 +2279,8 @@ void UpdateTrackedMort(MSEBoxModel *bm, FILE *llogfp, int guildcase, int cohort,
 	bm->calcMnumPerPred[prey][guildcase][current_id] += (mortality_scalar * GRAZEinfo[prey][prey_chrt][habitat] * biomass_correction);
 	bm->calcTrackedMort[prey][prey_chrt][preystock][ongoingM2_id] += (mortality_scalar * GRAZEinfo[prey][prey_chrt][habitat] * biomass_correction * FunctGroupArray[prey].speciesParams[Mdt_id]);
 	bm->calcTrackedPredMort[prey][prey_chrt][preystock][guildcase][ongoing_id] += (mortality_scalar * GRAZEinfo[prey][prey_chrt][habitat] * biomass_correction * FunctGroupArray[prey].speciesParams[Mdt_id]);
-	DIET_check[guildcase][cohort][stock_id][prey][ongoing_id] += (mortality_scalar * GRAZEinfo[prey][prey_chrt][habitat] * biomass_correction * FunctGroupArray[guildcase].speciesParams[Mdt_id]);
+	if (bm->flagdietoutput)
+		DIET_check[guildcase][cohort][stock_id][prey][ongoing_id] += (mortality_scalar * GRAZEinfo[prey][prey_chrt][habitat] * biomass_correction * FunctGroupArray[guildcase].speciesParams[Mdt_id]);
     
     if(bm->flagdietcheck) {
         if (habitat == SED) {
@@ -113,6 +113,161 @@ static void Scale_Linear_Mortality(MSEBoxModel *bm, FILE *llogfp, int boxID) {
 }
 
 
+/**
+ * \brief Group the species by their temperature correction method so Parameter_Q10 can
+ * evaluate each curve in a single pass over the species that use it.
+ *
+ * The species lists are kept in species order. q10_prev_humped[sp] records the last humped
+ * (Griffith) group before sp in the species list, as Get_Tcorr overwrites the shared
+ * current_corr for those groups and any basic q10 group after them picks that value up.
+ */
+void Ecology_Setup_Q10_Groups(MSEBoxModel *bm) {
+	int sp, q10flag, last_humped = -1;
+
+	for (q10flag = 0; q10flag < num_q10_methods; q10flag++)
+		q10_group_nsp[q10flag] = 0;
+
+	for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
+		q10flag = (int)(FunctGroupArray[sp].speciesParams[q10_method_id]);
+		q10_prev_humped[sp] = last_humped;
+
+		if ((q10flag < 0) || (q10flag >= num_q10_methods)) {
+			if (bm->flagq10)
+				quit("How got here as code option not possible - q10 effect method can only be 0-%d and you have %d\n", num_q10_methods - 1, q10flag);
+			continue;
+		}
+
+		q10_group_sp[q10flag][q10_group_nsp[q10flag]] = sp;
+		q10_group_nsp[q10flag]++;
+
+		if (q10flag == humped_griffith_q10_id)
+			last_humped = sp;
+	}
+}
+
+/**
+ * \brief Keep the temperature correction positive, but don't make it zero as have to divide by it.
+ */
+static double Bound_Tcorr(double ans) {
+    if((ans < 0.0) || (!ans) || isnan(ans))
+      ans = small_num;
+
+	return ans;
+}
+
+/**
+ * \brief Metabolic scaling term (Tau) at the given temperature, from Heinichen et al. 2022
+ * referencing Blanchard et al. 2012, Gillooly et al. 2001 and Brown et al. 2004.
+ */
+static double Tcorr_Tau(double temp) {
+	double step1, step2;
+
+	// Tau = 2.71^(25.55-(0.63/((0.0000863*TinK[i]))))
+	step1 = 0.0000863 * (temp + 273.15); // Caren added: These constants are: Boltzman constant (0.0000863) & temperature conversion from Celsius to Kelvin (+273.15)
+	step2 = 25.55 - (0.63 / step1); // Caren added: These are values for activation energy constant (0.63) and a constant: c1=25.55
+
+	return exp(step2);
+}
+
+/**
+ * \brief The temperature correction curves, shared by Get_Tcorr and Calc_Group_Tcorr.
+ *
+ * powB_temp (pow(temp_const_B, current_temp)) and tau_temp (Tcorr_Tau(current_temp)) only depend on
+ * the current temperature, so the caller works them out and they are only read by the humped and
+ * Heinichen curves respectively. corr is the basic q10 exponent. The answer is not bounded.
+ */
+static double Tcorr_Curve(MSEBoxModel *bm, int sp, int q10flag, double current_temp, double corr, double powB_temp, double tau_temp) {
+	double ans = 1.0;
+	double step1, step2, step3, step4;
+	double opt_temp, temp_const_A, temp_const_B;
+
+	switch (q10flag) {
+	case base_q10_id: /* Basic q10 relationship */
+		ans = (double)pow(FunctGroupArray[sp].speciesParams[q10_id], corr);
+		break;
+	case humped_griffith_q10_id: /* Humped shape from Gary Griffith */
+		// Equation from Gary G - Tdep_di=log(2)*0.851*(1.066.^T_i).*exp(-((abs(T_i-T_opt_nitzschia)).^3)./1000);
+		temp_const_A = (double) FunctGroupArray[sp].speciesParams[temp_coefftA_id];
+		opt_temp = (double) FunctGroupArray[sp].speciesParams[q10_optimal_temp_id];
+		step1 = log(2) * temp_const_A * powB_temp;
+		step2 = exp(-bm->temp_const_C * (pow(fabs(current_temp - opt_temp), bm->temp_const_D) / FunctGroupArray[sp].speciesParams[q10_correction_id]));
+
+		ans = step1 * step2;
+		break;
+	case Heinichen_q10_id:
+		/* Equation 4 from Heinichen et al. for Tau at the current temperature, scaled by
+		 * Tau at the optimal temperature as in Equation #5 from Heinichen et al. 2022 */
+		opt_temp = FunctGroupArray[sp].speciesParams[q10_optimal_temp_id];
+
+		ans = 1.0 / (tau_temp / Tcorr_Tau(opt_temp)); //scaled Tau
+		break;
+	case CEATTLE_q10_id:
+		// Equation from Wisconsin model used in CEATTLE
+		temp_const_A = (double) FunctGroupArray[sp].speciesParams[temp_coefftA_id];
+		opt_temp = (double) FunctGroupArray[sp].speciesParams[q10_optimal_temp_id];
+		temp_const_B = (double) FunctGroupArray[sp].speciesParams[q10_correction_id];
+
+		step1 = log(temp_const_A)*(temp_const_B - opt_temp + 2);
+		step2 = log(temp_const_A)*(temp_const_B - opt_temp);
+		step3 = (pow(step2, 2) * pow((1 + pow((1 + 40/step1), 0.5)), 2)) / 400;
+		step4 = (temp_const_B - current_temp)/(temp_const_B - opt_temp);
+
+		ans = pow(step4, step3) * exp(step3 * (1 - step4));
+		break;
+	default:
+		quit("How got here as code option not possible - q10 effect method can only be 0-%d and you have %d\n", num_q10_methods - 1, q10flag);
+	}
+
+	return ans;
+}
+
+/**
+ * \brief Calculate the Tcorr value for every group, one q10 method at a time.
+ *
+ * Gives the same answers as calling Get_Tcorr for each species in turn, but the terms that
+ * only depend on the current temperature are evaluated once per call rather than once per species.
+ * bm->current_corr is left as the species ordered loop would leave it.
+ */
+static void Calc_Group_Tcorr(MSEBoxModel *bm, double current_temp) {
+	int i, sp, prev_sp, nsp, q10flag;
+	double base_corr = bm->current_corr;
+	double corr, powB_temp = 0.0, tau_temp = 0.0;
+
+	if (!bm->flagq10) {
+		for (sp = 0; sp < bm->K_num_tot_sp; sp++)
+			FunctGroupArray[sp].Tcorr = 1.0;
+		return;
+	}
+
+	if (q10_group_nsp[humped_griffith_q10_id])
+		powB_temp = pow(bm->temp_const_B, current_temp);
+	if (q10_group_nsp[Heinichen_q10_id])
+		tau_temp = Tcorr_Tau(current_temp);
+
+	for (q10flag = 0; q10flag < num_q10_methods; q10flag++) {
+		nsp = q10_group_nsp[q10flag];
+		for (i = 0; i < nsp; i++) {
+			sp = q10_group_sp[q10flag][i];
+
+			/* A basic q10 group picks up the exponent left by the last humped group before it */
+			corr = base_corr;
+			if (q10flag == base_q10_id) {
+				prev_sp = q10_prev_humped[sp];
+				if (prev_sp >= 0)
+					corr = current_temp - FunctGroupArray[prev_sp].speciesParams[q10_optimal_temp_id];
+			}
+
+			FunctGroupArray[sp].Tcorr = Bound_Tcorr(Tcorr_Curve(bm, sp, q10flag, current_temp, corr, powB_temp, tau_temp));
+		}
+
+		/* The last humped group in the species list sets current_corr */
+		if ((q10flag == humped_griffith_q10_id) && nsp) {
+			sp = q10_group_sp[humped_griffith_q10_id][nsp - 1];
+			bm->current_corr = current_temp - FunctGroupArray[sp].speciesParams[q10_optimal_temp_id];
+		}
+	}
+}
+
 /**
  * \brief Computing temperature sensitive parameters based on time
  *
@@ -148,9 +303,10 @@ void Parameter_Q10(MSEBoxModel *bm, Box *pBox, double dayt, int numwclayer, doub
 	/* Temperature influence on recruitment */
 	bm->temp_influence = bm->Tcorr;
 
-	/* Calculate the TCorr value for each group */
+	/* Calculate the TCorr value for each group - done a method at a time, see Calc_Group_Tcorr */
+	Calc_Group_Tcorr(bm, H2Otemp);
+
 	for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
-		FunctGroupArray[sp].Tcorr = Get_Tcorr(bm, sp, H2Otemp, &bm->current_corr);
         FunctGroupArray[sp].TcorrEff = FunctGroupArray[sp].Tcorr;
         
 		/** Include pH and salinity modifiers if desired **/
@@ -184,86 +340,26 @@ void Parameter_Q10(MSEBoxModel *bm, Box *pBox, double dayt, int numwclayer, doub
  */
 double Get_Tcorr(MSEBoxModel *bm, int sp, double current_temp, double *current_corr) {
 	double ans = 1.0;
-	double step1, step2, step3, step4, stepA, stepB, stepC;
-	double opt_temp;
-	double temp_const_A = 0.0, temp_const_B = 0.0;
+	double powB_temp = 0.0, tau_temp = 0.0;
     int q10flag = (int)(FunctGroupArray[sp].speciesParams[q10_method_id]);
 
 	if (bm->flagq10) {
 		/* Now check the type of q10 correction that we are doing for this group */
-		switch (q10flag) {
-            case base_q10_id: /* Basic q10 relationship */
-                ans = (double)pow(FunctGroupArray[sp].speciesParams[q10_id], (*current_corr));
-                break;
-            case humped_griffith_q10_id: /* Humped shape from Hary Griffith */
-                // Equation from Gary G - Tdep_di=log(2)*0.851*(1.066.^T_i).*exp(-((abs(T_i-T_opt_nitzschia)).^3)./1000);
-                temp_const_A = (double) FunctGroupArray[sp].speciesParams[temp_coefftA_id];
-                opt_temp = (double) FunctGroupArray[sp].speciesParams[q10_optimal_temp_id];
-                step1 = log(2) * temp_const_A * pow(bm->temp_const_B,current_temp);
-                step2 = exp(-bm->temp_const_C * (pow(fabs(current_temp - opt_temp), bm->temp_const_D) / FunctGroupArray[sp].speciesParams[q10_correction_id]));
-                *current_corr = current_temp - opt_temp;
-
-                ans = step1 * step2;
-                
-                //                fprintf(bm->logFile, "FunctGroupArray[sp].speciesParams[q10_correction_id] = %e, opt_temp = %e\n",FunctGroupArray[sp].speciesParams[q10_correction_id], opt_temp);
-                //                fprintf(llogfp, "ParameterQ10 - opt_temp = %e, current_temp, = %e, FunctGroupArray[%d].Tcorr  = %e, step1 = %e, step2 = %e\n",opt_temp, current_temp, sp, FunctGroupArray[sp].Tcorr, step1, step2);
-                break;
-            case Heinichen_q10_id:
-                /* Equation 4 from Heinichen et al. referencing Blanchard et al. 2012 referencing Gillooly et al. 2001; & Brown et al. 2004 */
-                // Tau = 2.71^(25.55-(0.63/((0.0000863*TinK[i]))))
-                step1 = 0.0000863 * (current_temp + 273.15); // Caren added: These constants are: Boltzman constant (0.0000863) & temperature conversion from Celsius to Kelvin (+273.15)
-                step2 = 25.55 - (0.63 / step1); // Caren added: These are values for activation energy constant (0.63) and a constant: c1=25.55
-                      
-                step3 = exp(step2);
-
-                /*
-                if(sp == 45) {
-                  fprintf(bm->logFile, "Tau check: Day: %e, Species: %s, current_temp: %e, step1: %e, step2: %e, step3: %e, ans: %e", bm->dayt, FunctGroupArray[sp].groupCode, current_temp, step1, step2, step3);
-                }
-                 */
-               
-                opt_temp = FunctGroupArray[sp].speciesParams[q10_optimal_temp_id];
-               
-                // Equation #5 from Heinichen et al. 2022
-                stepA = 0.0000863 * (opt_temp + 273.15);
-                stepB = 25.55 - (0.63 / stepA);
-                stepC = exp(stepB);
-               
-                ans = 1.0 / (step3 / stepC); //scaled Tau
-                
-                /*
-                if(sp == 45) {
-                  fprintf(bm->logFile, "Scaled Tau check: Day: %e, Species: %s, opt_temp: %e, stepA: %e, stepB: %e, stepC: %e, ans: %e", bm->dayt, FunctGroupArray[sp].groupCode, opt_temp, stepA, stepB, stepC, ans);
-                }
-                */
-
-                break;
-            case CEATTLE_q10_id:
-                // Equation from Wisconsin model used in CEATTLE
-                temp_const_A = (double) FunctGroupArray[sp].speciesParams[temp_coefftA_id];
-                opt_temp = (double) FunctGroupArray[sp].speciesParams[q10_optimal_temp_id];
-                temp_const_B = (double) FunctGroupArray[sp].speciesParams[q10_correction_id];
-                
-                step1 = log(temp_const_A)*(temp_const_B - opt_temp + 2);
-                step2 = log(temp_const_A)*(temp_const_B - opt_temp);
-                step3 = (pow(step2, 2) * pow((1 + pow((1 + 40/step1), 0.5)), 2)) / 400;
-                step4 = (temp_const_B - current_temp)/(temp_const_B - opt_temp);
-                
-                ans = pow(step4, step3) * exp(step3 * (1 - step4));
+		if (q10flag == humped_griffith_q10_id)
+			powB_temp = pow(bm->temp_const_B, current_temp);
+		else if (q10flag == Heinichen_q10_id)
+			tau_temp = Tcorr_Tau(current_temp);
 
-                break;
-            default:
-                quit("How got here as code option not possible - q10 effect method can only be 0-2 and you have %d\n", (int)(FunctGroupArray[sp].speciesParams[q10_method_id]));
-		}
+		ans = Tcorr_Curve(bm, sp, q10flag, current_temp, (*current_corr), powB_temp, tau_temp);
+
+		if (q10flag == humped_griffith_q10_id)
+			*current_corr = current_temp - FunctGroupArray[sp].speciesParams[q10_optimal_temp_id];
 	} else {
 		ans = 1.0;
 	}
 
     // Always has to be non-negative, but don't make it zero as have to divide by it
-    if((ans < 0.0) || (!ans) || isnan(ans))
-      ans = small_num;
-
-	return ans;
+	return Bound_Tcorr(ans);
 }
 
 
@@ -51,7 +51,7 @@ void Ecology_Total_Verts_And_Migration(MSEBoxModel *bm, double dt, FILE *llogfp)
 void Ecology_Invading_Species(MSEBoxModel *bm, double dt, FILE *llogfp);
 void Ecology_Invert_Migration(MSEBoxModel *bm, double dt, FILE *llogfp);
 
-int Invade_Spread(MSEBoxModel *bm, int sp, FILE *llogfp, int b, int nb, int k, double *dist );
+int Invade_Spread(MSEBoxModel *bm, int sp, FILE *llogfp, int nb, int k);
 
 /* Warning and testing prototypes */
 void Ecology_Test_Fish_Total(MSEBoxModel *bm, double ***valtr, double **landtr, int calltype, char *spotcall, FILE *llogfp);
@@ -157,6 +157,7 @@ Local Modelling variables
 
 
 extern int **recover_help, **starve_vert, **nSTOCK, **shiftVERTON, **prey_counted, *mig_returners, *active_den, *not_finished, *ngene_done, *stock_done;
+extern int **q10_group_sp, *q10_group_nsp, *q10_prev_humped;
 //extern *mig_status;
 
 
@@ -171,6 +172,7 @@ extern double ***AGE_stock_struct_prop, // Also updated in Prepare_Age_Distrib -
 	*sizeMinMax, **SUPPdistrib, *recover_help_set, *BED_scale,
 	***PREYinfo, ***GRAZEinfo, ***EATINGinfo, **KDENR, *yoy,
 	***FEEDinfo, **step1distrib, **CATCHEATINGinfo,
+	***tempdistrib_thread, ***step1distrib_thread,
 	**CATCHGRAZEinfo, **boxden, ****currentden, **leftden, *newden_sum,
     ***preyamt, *totad, *totboxden, *totroc, *lostden_zero, *totsum,
     *totksum, *tot_new_mat, *coming_SPden, *numbers_entering,
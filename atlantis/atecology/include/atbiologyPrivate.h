@@ -77,6 +77,8 @@ Local Modelling variables
 
 
 int **recover_help = 0, **starve_vert = 0, **nSTOCK = 0, **shiftVERTON = 0, **prey_counted = 0, *mig_returners = 0, *active_den = 0, *not_finished = 0, *ngene_done = 0, *stock_done = 0;
+/* Species grouped by temperature correction method - allocated in Allocate_Arrays_Post_Load and filled in by Ecology_Setup_Q10_Groups */
+int **q10_group_sp = 0, *q10_group_nsp = 0, *q10_prev_humped = 0;
 //int *mig_status = 0;
 
 double ***AGE_stock_struct_prop = 0, // Also updated in Prepare_Age_Distrib - used to store the normalised distribution of the cohort species across each stock
@@ -91,6 +93,7 @@ double ***AGE_stock_struct_prop = 0, // Also updated in Prepare_Age_Distrib - us
 	*recover_help_set = 0, *BED_scale = 0, **KDENR = 0, *yoy = 0,
 	***PREYinfo = 0, ***GRAZEinfo = 0, ***EATINGinfo = 0, *lostden_zero = 0,
 	***FEEDinfo = 0, **step1distrib = 0, **CATCHEATINGinfo = 0,
+	***tempdistrib_thread = 0, ***step1distrib_thread = 0,
 	**CATCHGRAZEinfo = 0, **boxden = 0, ****currentden = 0, **leftden = 0,
     *newden_sum = 0, ***preyamt = 0, *totad = 0, *totboxden = 0, *totroc = 0,
     *totsum = 0, *totksum = 0, *tot_new_mat = 0, *coming_SPden = 0,
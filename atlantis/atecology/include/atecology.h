@@ -98,6 +98,7 @@ extern int verbose; /** \var If true then detailed debugging information is writ
 /* Migration and reproduction arrays */
 
 extern int **recover_help, **starve_vert, **nSTOCK, **shiftVERTON, **prey_counted, *mig_returners, *active_den, *not_finished, *ngene_done, *stock_done;
+extern int **q10_group_sp, *q10_group_nsp, *q10_prev_humped;
 //extern int *mig_status;
 
 /* Population arrays */
@@ -109,7 +110,7 @@ extern double ****readinpopratio, ****newden, ****recVERTpopratio,
 		*sizeMinMax, **stock_prop, **recSTOCK, **totden, **recruit_vdistrib,
 		**tempdistrib, **VERTabund_check, ***totrecruit, **totden_check, 
         **Schange, **tot_yoy, **KDENR, *lostden_zero, *adults_spawning,
-		*recover_help_set, *BED_scale, **step1distrib,
+		*recover_help_set, *BED_scale, **step1distrib, ***tempdistrib_thread, ***step1distrib_thread,
 		***PREYinfo, ***GRAZEinfo, ***EATINGinfo, ***FEEDinfo, **PHchange,
 		**CATCHEATINGinfo, **CATCHGRAZEinfo, **SUPPdistrib, **boxden, ****currentden,
         **leftden, *newden_sum, ***preyamt, *totad, *totboxden, *totroc, *yoy, *totsum,
@@ -313,6 +314,7 @@ void Box_Nutrient_Check(MSEBoxModel *bm, Box *pBox);
 double Get_pHcorr(MSEBoxModel *bm, int sp, double current_pH, int cbox, int clayer);
 double Get_Scorr(MSEBoxModel *bm, int sp, double current_salt);
 double Get_Tcorr(MSEBoxModel *bm, int sp, double current_temp, double *current_corr);
+void Ecology_Setup_Q10_Groups(MSEBoxModel *bm);
 double Get_Pollutant_Corrections(MSEBoxModel *bm, int sp, int b, int clayer);
 
 double Projection_GetLatitude(MSEBoxModel *bm, double x_coord, double y_coord);
@@ -714,7 +714,7 @@ void Stocastic_Effort_Allocation(MSEBoxModel *bm, int nf, int ns, int *not_bound
 			 small pi values in rndnum comparison.
 			 */
 			rndmax = min(1.0, pi_bound);
-			rndnum = drandom(0.0, rndmax);
+			rndnum = Util_Random(bm, rand_econ_id, 0.0, rndmax);
 			checkmonth = -1;
 			cum_pi = 0;
 			for (month = 0; month < 12; month++) {
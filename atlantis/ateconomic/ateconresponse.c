@@ -356,11 +356,11 @@ void Update_Vessel_Numbers(MSEBoxModel *bm, FILE *llogfp) {
 					p_flexgear = 0.0;
 
 				num_moving = 0;
-				rndnum = drandom(0.0, 1.0);
+				rndnum = Util_Random(bm, rand_econ_id, 0.0, 1.0);
 
 				/* Supplementing gear */
 				if ((rndnum < p_flexgear) || (rndnum < p_supp)) {
-					rndnum2 = drandom(0.0, bm->prop_supp) * bm->SUBFLEET_ECONprms[nf][ns][nboat_id];
+					rndnum2 = Util_Random(bm, rand_econ_id, 0.0, bm->prop_supp) * bm->SUBFLEET_ECONprms[nf][ns][nboat_id];
 					num_moving = (int) (min(1.0, floor(rndnum2)));
 					boats_free[nf][ns] += num_moving;
 
@@ -369,7 +369,7 @@ void Update_Vessel_Numbers(MSEBoxModel *bm, FILE *llogfp) {
 
 				} else if (rndnum < p_switch) {
 					/* Simply switching fleets */
-					rndnum2 = drandom(0.0, bm->prop_switch) * bm->SUBFLEET_ECONprms[nf][ns][nboat_id];
+					rndnum2 = Util_Random(bm, rand_econ_id, 0.0, bm->prop_switch) * bm->SUBFLEET_ECONprms[nf][ns][nboat_id];
 					num_moving = (int) (min(1.0, floor(rndnum2)));
 					boats_free[nf][ns] += num_moving;
 
@@ -380,7 +380,7 @@ void Update_Vessel_Numbers(MSEBoxModel *bm, FILE *llogfp) {
 					/* Actual decomissioning - nothing to do actually as will be lost below
 					 as boats_free not being reset
 					 */
-					rndnum2 = drandom(0.0, bm->prop_leave) * bm->SUBFLEET_ECONprms[nf][ns][nboat_id];
+					rndnum2 = Util_Random(bm, rand_econ_id, 0.0, bm->prop_leave) * bm->SUBFLEET_ECONprms[nf][ns][nboat_id];
 
 					/* If don't just want one ticking over every time trigger tripped, do second
 					 check vs month of year
@@ -427,7 +427,7 @@ void Update_Vessel_Numbers(MSEBoxModel *bm, FILE *llogfp) {
 				 */
 				bank_vault = bm->SUBFLEET_ECONprms[nf][ns][lasttot_cash_id];
 				if (!debt_lost && (bank_vault < bm->shorecost) && (bm->dayt > 364.0)) {
-					rndnum2 = drandom(0.0, 1.0) * bm->SUBFLEET_ECONprms[nf][ns][nboat_id];
+					rndnum2 = Util_Random(bm, rand_econ_id, 0.0, 1.0) * bm->SUBFLEET_ECONprms[nf][ns][nboat_id];
 					debt_lost = (int) (min(1.0, floor(rndnum2)));
 					num_moving += debt_lost;
 
@@ -476,9 +476,9 @@ void Update_Vessel_Numbers(MSEBoxModel *bm, FILE *llogfp) {
 				new_cost = bm->SUBFLEET_ECONprms[nf][ns][newboat_cost_id];
 				final_VNR = bm->new_return_coefft * final_net_return1 - bm->new_coefft * new_cost;
 				p_new = 1.0 / (1.0 + exp(-final_VNR));
-				rndnum = drandom(0.0, 1.0);
+				rndnum = Util_Random(bm, rand_econ_id, 0.0, 1.0);
 				if (rndnum < p_new) {
-					rndnum2 = drandom(0.0, 1.0) * (bm->FISHERYprms[nf][nlicence_id] - bm->FISHERYprms[nf][nvessel_id]);
+					rndnum2 = Util_Random(bm, rand_econ_id, 0.0, 1.0) * (bm->FISHERYprms[nf][nlicence_id] - bm->FISHERYprms[nf][nvessel_id]);
 					num_new = (int) (min(1.0, floor(rndnum2)));
 					boats_new[nf][ns] += num_new;
 				}
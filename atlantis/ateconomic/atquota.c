@@ -762,6 +762,127 @@ double Get_Seller_Supply(MSEBoxModel *bm, int sellernf, int sellerns, int sp, do
 	return supply;
 
 }
+/**
+ *
+ *	\brief Rank the subfleets and months taking part in the quota market for species sp on their
+ *	marginal rent (final utility). The sorted rent and ids are left in linearPI[sp].
+ *
+ *	Only the holdings of sp are read and only pi[][][][sp] and linearPI[sp] are written, so this
+ *	can be called for different species at the same time.
+ *
+ *	Returns the number of ranked entries or -1 if there is no market for the species (not a quota
+ *	species or nobody near their quota or with some to spare).
+ */
+static int Quota_Market_Rank(MSEBoxModel *bm, int sp, int tnf, int nm, int totpi) {
+	int nf, ns, month, idd, idp = 0, quota_sp = 0, within_min = 0, any_spare = 0;
+	int ascendflag = 0;
+	double TripLength, TripCost, cumCatch, expectedCatch, ownQuota, leaseQuota, priceQuota, fishprice, expectedCPUE, scheduledEffort, prop_olease,
+			prop_tlease;
+	double *rent = linearPI[sp][linPI_id];
+	double *ids = linearPI[sp][idd_id];
+	double *carry;
+
+	for (nf = 0; nf < bm->K_num_fisheries; nf++) {
+		if (bm->FISHERYprms[nf][flageffortmodel_id] > rec_econ_model) { /* Only commerical fisheries trade quota */
+			/* Identify quota mix and rank subfleets/fisheries */
+			/* Only bother continuing if a quota species */
+			if (bm->SP_FISHERYprms[sp][nf][flagquota_id]) {
+				quota_sp = 1;
+				for (ns = 0; ns < bm->FISHERYprms[nf][nsubfleets_id]; ns++) {
+					/* If no boats in the subfleet currently skip ahead */
+					if (!bm->SUBFLEET_ECONprms[nf][ns][nboat_id]) {
+						continue;
+					}
+					TripLength = bm->SUBFLEET_ECONprms[nf][ns][max_trip_length_id];
+					TripCost = bm->SUBFLEET_ECONprms[nf][ns][cost_ind_id];
+
+					/* Identify if anyone actually needs to trade this species rightly now */
+					if (bm->QuotaAlloc[nf][ns][sp][within_id])
+						within_min = 1;
+
+					/* Identify if anyone actually has some to spare */
+					if (bm->QuotaAlloc[nf][ns][sp][spare2sell_id])
+						any_spare = 1;
+
+					/* Calculate profit (pi) */
+					cumCatch = bm->QuotaAlloc[nf][ns][sp][cumboatcatch_id];
+					prop_olease = bm->QuotaAlloc[nf][ns][sp][permolease_id];
+					prop_tlease = bm->QuotaAlloc[nf][ns][sp][templease_id];
+					ownQuota = (1.0 - prop_olease - prop_tlease) * bm->QuotaAlloc[nf][ns][sp][owned_id];
+					leaseQuota = bm->QuotaAlloc[nf][ns][sp][leased_id];
+					priceQuota = bm->QuotaAlloc[nf][ns][sp][spmarg_profit_id] * (1.0 + 1.0 / (bm->interest_rate + small_num));
+					for (month = bm->MofY; month < 12; month++) {
+						expectedCatch = bm->MonthAlloc[nf][ns][sp][month];
+						scheduledEffort = bm->EffortSchedule[nf][ns][month][expect_id];
+						fishprice = bm->SP_FISHERYprms[sp][nf][saleprice_id];
+						expectedCPUE = bm->BlackBook[nf][ns][sp][bm->MofY][expect_id] / (bm->EffortSchedule[nf][ns][bm->MofY][hist_id] + small_num);
+						pi[nf][ns][month][sp] = scheduledEffort * ((fishprice * expectedCPUE) - (TripCost / (TripLength + small_num)));
+						pi[nf][ns][month][sp] -= priceQuota * (cumCatch + expectedCatch - ownQuota - leaseQuota);
+
+						if (bm->QuotaAlloc[nf][ns][sp][within_id] || bm->QuotaAlloc[nf][ns][sp][spare2sell_id]) {
+							/* To keep sort times to a minimum only include those
+							 fishery components that are actually buying or selling
+							 at this time.
+							 */
+							idd = ns * tnf * nm + nm * nf + month - bm->MofY;
+							rent[idp] = bm->QuotaAlloc[nf][ns][sp][finalutility_id];
+							ids[idp] = idd;
+							idp++;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	if (!quota_sp || !within_min || !any_spare)
+		return -1;
+
+	/* The seller search starts one past the last ranked entry so keep that entry clear */
+	if (idp < totpi) {
+		rent[idp] = 0;
+		ids[idp] = 0;
+	}
+
+	/* Sort participating subfleet and fisheries based on marginal rent only (the other
+	 arrays carried through the sort are not needed in this case) */
+	carry = Util_Alloc_Init_1D_Double(3 * idp + 1, 1.0);
+	Quicksort_Dir(rent, ids, carry, &carry[idp], &carry[2 * idp], idp, ascendflag);
+	d_free1d(carry);
+
+	return idp;
+}
+
+/**
+ *
+ *	\brief Expected catch of sp over the rest of the year for each subfleet, along with the planned
+ *	effort and catch totals. Trade() does not change the effort schedule or black book so these
+ *	only need to be worked out once per species market.
+ *
+ */
+static void Quota_Rest_Of_Year(MSEBoxModel *bm, int sp, double **restCatch, double **planEffort, double **planCatch) {
+	int nf, ns, m;
+	double scheduledEffort, ExpCatch, ExpEffort;
+
+	for (nf = 0; nf < bm->K_num_fisheries; nf++) {
+		for (ns = 0; ns < bm->FISHERYprms[nf][nsubfleets_id]; ns++) {
+			restCatch[nf][ns] = 0;
+			planEffort[nf][ns] = 0;
+			planCatch[nf][ns] = 0;
+			for (m = bm->MofY; m < 12; m++) {
+				scheduledEffort = bm->EffortSchedule[nf][ns][m][expect_id];
+				ExpCatch = bm->BlackBook[nf][ns][sp][m][expect_id];
+				ExpEffort = bm->EffortSchedule[nf][ns][m][hist_id];
+				restCatch[nf][ns] += scheduledEffort * ExpCatch / (ExpEffort + small_num);
+				planEffort[nf][ns] += scheduledEffort;
+				planCatch[nf][ns] += scheduledEffort * ExpCatch / ExpEffort;
+			}
+		}
+	}
+
+	return;
+}
+
 /**
  *
  *	\brief Boxmodel quota trading model - based on Rich Little's quota model
@@ -774,14 +895,19 @@ double Get_Seller_Supply(MSEBoxModel *bm, int sellernf, int sellerns, int sp, do
  *
  */
 void Quota_trade(MSEBoxModel *bm, FILE *llogfp) {
-	int nf, ns, sp, month, quota_sp, b, s, step1, buyernf = 0, buyerns = 0, buyermonth = 0, sellernf = 0, sellerns = 0, sellermonth = 0, m,
-		within_min, any_spare, itc, idd, nsort, idp, still_trading, found_any, do_debug, do_debug_base;
+	int nf, ns, sp, b, s, step1, buyernf = 0, buyerns = 0, buyermonth = 0, sellernf = 0, sellerns = 0, sellermonth = 0,
+		itc, idd, nsort, idp, still_trading, found_any, do_debug, do_debug_base;
 	int tnf = bm->K_num_fisheries;
 	int maxmonth = 12;
 	int nm = maxmonth - bm->MofY;
 	int ascendflag = 0;
 	int totpi = bm->K_max_num_subfleet * bm->K_num_fisheries * maxmonth;
-	double scheduledEffort, TripLength, TripCost, cumCatch, expectedCatch = 0, ownQuota, leaseQuota, priceQuota, fishprice, expectedCPUE, aggDemand, aggSupply,
+	int *marketSize;
+#ifdef _OPENMP
+	int market_threads = Util_Get_Num_Threads(bm);
+#endif
+	double **restCatch, **planEffort, **planCatch;
+	double scheduledEffort, cumCatch, expectedCatch = 0, ownQuota, leaseQuota,
 			demand, supply, ExpCatch, ExpEffort, expectedIncreasedCatch, expectedDecreaseCatch, remainderQ, sp_wgt, totPlannedEffort, totPlannedCatch,
 			effThresh, max_month_effort = 0, prop_olease, prop_tlease, friend_weight, tot_match, this_max_demand, BUYERexpectedCatch, BUYERcumCatch, BUYERownQuota,
 			BUYERleaseQuota, sp_needed, SELLERexpectedCatch, SELLERcumCatch, SELLERownQuota, SELLERleaseQuota, sp_avail, spareend, remain_demand,
@@ -811,330 +937,201 @@ void Quota_trade(MSEBoxModel *bm, FILE *llogfp) {
 	/* If single species match-up rather than packages then do buying and selling */
 	/* FIX STEP THROUGH RICH'S DOCUMENT AND SEE WHAT IN CODE MATCHES WHAT IN TEXT */
 	if (bm->sp_by_sp) {
+		/* Rank each species market first. Trade() only changes the holdings of the species being
+		 traded so the rankings are independent of each other and can be built in parallel. The
+		 matching itself is done in species order below as it shares the random number stream,
+		 the log file and the planned catch totals.
+		 */
+		marketSize = Util_Alloc_Init_1D_Int(bm->K_num_tot_sp, -1);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(market_threads) if(market_threads > 1)
+#endif
 		for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
 			if (FunctGroupArray[sp].isFished == TRUE) {
-				quota_sp = 0;
-				aggDemand = 0;
-				aggSupply = 0;
-				within_min = 0;
-				any_spare = 0;
-
-				/* Initialise linearPI */
-				for (ns = 0; ns < totpi; ns++) {
-					linearPI[sp][linPI_id][ns] = 0;
-					linearPI[sp][idd_id][ns] = 0;
-					ax[ns] = 0;
-					bx[ns] = 0;
-				}
-
-				idp = 0;
-				for (nf = 0; nf < bm->K_num_fisheries; nf++) {
-					if (bm->FISHERYprms[nf][flageffortmodel_id] > rec_econ_model) { /* Only commerical fisheries trade quota */
-						/* Identify quota mix and rank subfleets/fisheries */
-						/* Only bother continuing if a quota species */
-						if (bm->SP_FISHERYprms[sp][nf][flagquota_id]) {
-							quota_sp = 1;
-							for (ns = 0; ns < bm->FISHERYprms[nf][nsubfleets_id]; ns++) {
-								/* If no boats in the subfleet currently skip ahead */
-								if (!bm->SUBFLEET_ECONprms[nf][ns][nboat_id]) {
-									continue;
-								}
-								TripLength = bm->SUBFLEET_ECONprms[nf][ns][max_trip_length_id];
-								TripCost = bm->SUBFLEET_ECONprms[nf][ns][cost_ind_id];
-
-								/* Identify if anyone actually needs to trade this species rightly now */
-								if (bm->QuotaAlloc[nf][ns][sp][within_id])
-									within_min = 1;
-
-								/* Identify if anyone actually has some to spare */
-								if (bm->QuotaAlloc[nf][ns][sp][spare2sell_id])
-									any_spare = 1;
-
-								/* Calculate profit (pi) */
-								cumCatch = bm->QuotaAlloc[nf][ns][sp][cumboatcatch_id];
-								prop_olease = bm->QuotaAlloc[nf][ns][sp][permolease_id];
-								prop_tlease = bm->QuotaAlloc[nf][ns][sp][templease_id];
-								ownQuota = (1.0 - prop_olease - prop_tlease) * bm->QuotaAlloc[nf][ns][sp][owned_id];
-								leaseQuota = bm->QuotaAlloc[nf][ns][sp][leased_id];
-								priceQuota = bm->QuotaAlloc[nf][ns][sp][spmarg_profit_id] * (1.0 + 1.0 / (bm->interest_rate + small_num));
-								for (month = bm->MofY; month < 12; month++) {
-									expectedCatch = bm->MonthAlloc[nf][ns][sp][month];
-									scheduledEffort = bm->EffortSchedule[nf][ns][month][expect_id];
-									fishprice = bm->SP_FISHERYprms[sp][nf][saleprice_id];
-									expectedCPUE = bm->BlackBook[nf][ns][sp][bm->MofY][expect_id] / (bm->EffortSchedule[nf][ns][bm->MofY][hist_id] + small_num);
-									pi[nf][ns][month][sp] = scheduledEffort * ((fishprice * expectedCPUE) - (TripCost / (TripLength + small_num)));
-									pi[nf][ns][month][sp] -= priceQuota * (cumCatch + expectedCatch - ownQuota - leaseQuota);
-
-									idd = ns * tnf * nm + nm * nf + month - bm->MofY;
-									linearPI[sp][linPI_id][idd] = bm->QuotaAlloc[nf][ns][sp][finalutility_id];
-									linearPI[sp][idd_id][idd] = idd;
-
-									if (bm->QuotaAlloc[nf][ns][sp][within_id] || bm->QuotaAlloc[nf][ns][sp][spare2sell_id]) {
-										/* To keep sort times to a minimum only include those
-										 fishery components that are actually buying or selling
-										 at this time.
-										 */
-										ax[idp] = linearPI[sp][linPI_id][idd];
-										bx[idp] = linearPI[sp][idd_id][idd];
-										cx[idp] = 1.0; // Not needed in this case
-										dx[idp] = 1.0; // Not needed in this case
-										ex[idp] = 1.0; // Not needed in this case
-										idp++;
-									}
-								}
-
-								/** Calculate aggregate demand and supply **/
-								/* Aggregate demand - is sum of the differences between the cumulative catch
-								 + expected future catch and the quota held already */
-								aggDemand += cumCatch + expectedCatch - ownQuota - leaseQuota;
-
-								/* Aggregate supply - here purchase quota is sold quota so need is negative */
-								aggSupply += ownQuota + leaseQuota - cumCatch;
-
-							}
-						}
-					}
-				}
+				marketSize[sp] = Quota_Market_Rank(bm, sp, tnf, nm, totpi);
+			}
+		}
 
-				/* Only continue if quota species that someone has nearly filled their quota on
-				 and someone else has some spare to sell. Also don't bother continuing if not
-				 using the sp_by_sp code. More complex case is handled below.
-				 */
-				if (!quota_sp || !within_min || !any_spare || !bm->sp_by_sp)
-					continue;
+		restCatch = Util_Alloc_Init_2D_Double(bm->K_max_num_subfleet, bm->K_num_fisheries, 0.0);
+		planEffort = Util_Alloc_Init_2D_Double(bm->K_max_num_subfleet, bm->K_num_fisheries, 0.0);
+		planCatch = Util_Alloc_Init_2D_Double(bm->K_max_num_subfleet, bm->K_num_fisheries, 0.0);
 
-				/* Sort participating subfleet and fisheries based on marginal rent only - set nsort first
-				 (so don't waste time sorting non-participating members */
-				nsort = idp;
-				Quicksort_Dir(ax, bx, cx, dx, ex, nsort, ascendflag);
+		for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
+			/* Only continue if quota species that someone has nearly filled their quota on
+			 and someone else has some spare to sell. More complex case is handled below.
+			 */
+			if (marketSize[sp] < 0)
+				continue;
 
-				/* Copy ax and bx across to linearPIP for use below */
-				for (ns = 0; ns < totpi; ns++) {
-					linearPI[sp][linPI_id][ns] = ax[ns];
-					linearPI[sp][idd_id][ns] = bx[ns];
-				}
+			nsort = marketSize[sp];
+			Quota_Rest_Of_Year(bm, sp, restCatch, planEffort, planCatch);
 
+			b = 0;
+			s = nsort;
+			while ((s >= 0) && (b < nsort && b >= 0)) {
 				b = 0;
-				s = nsort;
-				while ((s >= 0) && (b < nsort && b >= 0)) {
-					b = 0;
-					demand = 1;
-					while ((demand > 0) && (b < nsort && b >= 0)) {
-						demand = 0;
-						/* Deconstructing ids from single sorted array - assuming ids in
-						 the sorted array are of the form ns*tnf*(12 - month) + (12 - month)*nf + month - bm->MofY */
-						step1 = (int) floor(ROUNDGUARD + (linearPI[sp][idd_id][b] / (nm + small_num))); /* First step in finding fishery_id and subfleet_id */
-						buyerns = (int) floor(ROUNDGUARD + (step1 / (tnf + small_num))); /* Finding subfleet_id */
-						buyernf = step1 % tnf; /* Finding the fishery_id */
-						buyermonth = (int) floor(ROUNDGUARD + (linearPI[sp][idd_id][b])) % nm; /* Finding the month_id */
-						down_time = bm->SUBFLEET_ECONprms[buyernf][buyerns][down_time_id];
-						max_month_effort = bm->month_scalar * (1 - down_time) * bm->SUBFLEET_ECONprms[buyernf][buyerns][nboat_id];
-
-						/* The expected increase in catch by filling the current month */
-						if ((max_month_effort - bm->EffortSchedule[buyernf][buyerns][buyermonth][expect_id] >= 1)
-								&& (bm->MargRent[buyernf][buyerns][sp][buyermonth] >= 0)) {
-							scheduledEffort = bm->EffortSchedule[buyernf][buyerns][buyermonth][expect_id];
-							ExpCatch = bm->BlackBook[buyernf][buyerns][sp][buyermonth][expect_id];
-							ExpEffort = bm->EffortSchedule[buyernf][buyerns][buyermonth][hist_id];
-							expectedIncreasedCatch = (max_month_effort - scheduledEffort) * ExpCatch / (ExpEffort + small_num);
-							expectedCatch = 0;
-							prop_olease = bm->QuotaAlloc[buyernf][buyerns][sp][permolease_id];
-							prop_tlease = bm->QuotaAlloc[buyernf][buyerns][sp][templease_id];
-							ownQuota = (1.0 - prop_olease - prop_tlease) * bm->QuotaAlloc[buyernf][buyerns][sp][owned_id];
-							leaseQuota = bm->QuotaAlloc[buyernf][buyerns][sp][leased_id];
-							cumCatch = bm->QuotaAlloc[buyernf][buyerns][sp][cumboatcatch_id];
-							for (m = bm->MofY; m < 12; m++) {
-								scheduledEffort = bm->EffortSchedule[buyernf][buyerns][m][expect_id];
-								ExpCatch = bm->BlackBook[buyernf][buyerns][sp][m][expect_id];
-								ExpEffort = bm->EffortSchedule[buyernf][buyerns][m][hist_id];
-								expectedCatch += scheduledEffort * ExpCatch / (ExpEffort + small_num);
-							}
-							demand = cumCatch + expectedCatch + expectedIncreasedCatch - ownQuota - leaseQuota;
-						}
-						if (demand <= 0)
-							b++;
-					}
-
-					s = nsort;
-					supply = 0;
-					while (supply <= 0 && s >= 0) {
-						/* Deconstructing ids from single sorted array - assuming ids in
-						 the sorted array are of the form ns*tnf*(12 - month) + (12 - month)*nf + month - bm->MofY */
-						step1 = (int) floor(ROUNDGUARD + (linearPI[sp][idd_id][s] / (nm + small_num))); /* First step in finding fishery_id and subfleet_id */
-						sellerns = (int) floor(ROUNDGUARD + (step1 / (tnf + small_num))); /* Finding subfleet_id */
-						sellernf = step1 % tnf; /* Finding the fishery_id */
-						sellermonth = (int) floor(ROUNDGUARD + (linearPI[sp][idd_id][s])) % nm; /* Finding the month_id */
-
-						/* Expected annual quota leftover if no fishing in this month */
-						if ((bm->EffortSchedule[sellernf][sellerns][sellermonth][expect_id] > 0) && (bm->MargRent[sellernf][sellerns][sp][sellermonth] < 0)) {
-							scheduledEffort = bm->EffortSchedule[sellernf][sellerns][sellermonth][expect_id];
-							ExpCatch = bm->BlackBook[sellernf][sellerns][sp][sellermonth][expect_id];
-							ExpEffort = bm->EffortSchedule[sellernf][sellerns][sellermonth][hist_id];
-							expectedDecreaseCatch = scheduledEffort * ExpCatch / (ExpEffort + small_num);
-							prop_olease = bm->QuotaAlloc[sellernf][sellerns][sp][permolease_id];
-							prop_tlease = bm->QuotaAlloc[sellernf][sellerns][sp][templease_id];
-							ownQuota = (1.0 - prop_olease - prop_tlease) * bm->QuotaAlloc[sellernf][sellerns][sp][owned_id];
-							leaseQuota = bm->QuotaAlloc[sellernf][sellerns][sp][leased_id];
-							cumCatch = bm->QuotaAlloc[sellernf][sellerns][sp][cumboatcatch_id];
-							/* Need supply to cover the rest of the year */
-							expectedCatch = 0;
-							for (m = bm->MofY; m < 12; m++) {
-								scheduledEffort = bm->EffortSchedule[sellernf][sellerns][m][expect_id];
-								ExpCatch = bm->BlackBook[sellernf][sellerns][sp][m][expect_id];
-								ExpEffort = bm->EffortSchedule[sellernf][sellerns][m][hist_id];
-								expectedCatch += scheduledEffort * ExpCatch / (ExpEffort + small_num);
-							}
-							remainderQ = ownQuota + leaseQuota - cumCatch - (expectedCatch - expectedDecreaseCatch);
-							supply = min(expectedDecreaseCatch, remainderQ);
-						}
-						if (supply <= 0)
-							s--;
-					}
-
-					if ((demand <= bm->recon_buffer) || (supply <= bm->recon_buffer))
-						break;
-
+				demand = 1;
+				while ((demand > 0) && (b < nsort && b >= 0)) {
+					demand = 0;
+					/* Deconstructing ids from single sorted array - assuming ids in
+					 the sorted array are of the form ns*tnf*(12 - month) + (12 - month)*nf + month - bm->MofY */
+					step1 = (int) floor(ROUNDGUARD + (linearPI[sp][idd_id][b] / (nm + small_num))); /* First step in finding fishery_id and subfleet_id */
+					buyerns = (int) floor(ROUNDGUARD + (step1 / (tnf + small_num))); /* Finding subfleet_id */
+					buyernf = step1 % tnf; /* Finding the fishery_id */
+					buyermonth = (int) floor(ROUNDGUARD + (linearPI[sp][idd_id][b])) % nm; /* Finding the month_id */
 					down_time = bm->SUBFLEET_ECONprms[buyernf][buyerns][down_time_id];
 					max_month_effort = bm->month_scalar * (1 - down_time) * bm->SUBFLEET_ECONprms[buyernf][buyerns][nboat_id];
-					Trade(bm, sp, bm->MofY, buyernf, buyerns, sellernf, sellerns, demand, supply, buyermonth, sellermonth, max_month_effort, &remain_demand,
-							&remain_supply, llogfp);
-
-					/* Need to recalculate expected catch and planned effort as just changed schedule in
-					 quota trading routine trade() */
-					bm->SUBFLEET_ECONprms[sellernf][sellerns][totPlanEffort_id] = 0;
-					bm->SUBFLEET_ECONprms[sellernf][sellerns][totPlanCatch_id] = 0;
-					for (m = bm->MofY; m < 12; m++) {
-						scheduledEffort = bm->EffortSchedule[sellernf][sellerns][m][expect_id];
-						ExpCatch = bm->BlackBook[sellernf][sellerns][sp][m][expect_id];
-						ExpEffort = bm->EffortSchedule[sellernf][sellerns][m][hist_id];
-						bm->SUBFLEET_ECONprms[sellernf][sellerns][totPlanEffort_id] += scheduledEffort;
-						bm->SUBFLEET_ECONprms[sellernf][sellerns][totPlanCatch_id] += scheduledEffort * ExpCatch / ExpEffort;
-					}
-
-					bm->SUBFLEET_ECONprms[buyernf][buyerns][totPlanEffort_id] = 0;
-					bm->SUBFLEET_ECONprms[buyernf][buyerns][totPlanCatch_id] = 0;
-					for (m = bm->MofY; m < 12; m++) {
-						scheduledEffort = bm->EffortSchedule[buyernf][buyerns][m][expect_id];
-						ExpCatch = bm->BlackBook[buyernf][buyerns][sp][m][expect_id];
-						ExpEffort = bm->EffortSchedule[buyernf][buyerns][m][hist_id];
-						bm->SUBFLEET_ECONprms[buyernf][buyerns][totPlanEffort_id] += scheduledEffort;
-						bm->SUBFLEET_ECONprms[buyernf][buyerns][totPlanCatch_id] += scheduledEffort * ExpCatch / ExpEffort;
-					}
 
-					/* Get new aggregate supply and demand */
-					aggDemand = 0;
-					aggSupply = 0;
-					for (nf = 0; nf < bm->K_num_fisheries; nf++) {
-						for (ns = 0; ns < bm->FISHERYprms[nf][nsubfleets_id]; ns++) {
-							/* If no boats in the subfleet currently skip ahead */
-							if (!bm->SUBFLEET_ECONprms[nf][ns][nboat_id]) {
-								continue;
-							}
-							cumCatch = bm->QuotaAlloc[nf][ns][sp][cumboatcatch_id];
-							expectedCatch = bm->MonthAlloc[nf][ns][sp][bm->MofY];
-							prop_olease = bm->QuotaAlloc[nf][ns][sp][permolease_id];
-							prop_tlease = bm->QuotaAlloc[nf][ns][sp][templease_id];
-							ownQuota = (1.0 - prop_olease - prop_tlease) * bm->QuotaAlloc[nf][ns][sp][owned_id];
-							leaseQuota = bm->QuotaAlloc[nf][ns][sp][leased_id];
-
-							/** Calculate aggregate demand and supply **/
-							/* Aggregate demand - is sum of the differences between the cumulative catch
-							 + expected future catch and the quota held already */
-							aggDemand += cumCatch + expectedCatch - ownQuota - leaseQuota;
-
-							/* Aggregate supply - here purchase quota is sold quota so need is negative */
-							aggSupply += ownQuota + leaseQuota - cumCatch;
-						}
+					/* The expected increase in catch by filling the current month */
+					if ((max_month_effort - bm->EffortSchedule[buyernf][buyerns][buyermonth][expect_id] >= 1)
+							&& (bm->MargRent[buyernf][buyerns][sp][buyermonth] >= 0)) {
+						scheduledEffort = bm->EffortSchedule[buyernf][buyerns][buyermonth][expect_id];
+						ExpCatch = bm->BlackBook[buyernf][buyerns][sp][buyermonth][expect_id];
+						ExpEffort = bm->EffortSchedule[buyernf][buyerns][buyermonth][hist_id];
+						expectedIncreasedCatch = (max_month_effort - scheduledEffort) * ExpCatch / (ExpEffort + small_num);
+						prop_olease = bm->QuotaAlloc[buyernf][buyerns][sp][permolease_id];
+						prop_tlease = bm->QuotaAlloc[buyernf][buyerns][sp][templease_id];
+						ownQuota = (1.0 - prop_olease - prop_tlease) * bm->QuotaAlloc[buyernf][buyerns][sp][owned_id];
+						leaseQuota = bm->QuotaAlloc[buyernf][buyerns][sp][leased_id];
+						cumCatch = bm->QuotaAlloc[buyernf][buyerns][sp][cumboatcatch_id];
+						expectedCatch = restCatch[buyernf][buyerns];
+						demand = cumCatch + expectedCatch + expectedIncreasedCatch - ownQuota - leaseQuota;
 					}
+					if (demand <= 0)
+						b++;
 				}
 
-				/* Step 2 see if there is anyone with full effort scedule but is expected to not fill their quota */
-
 				s = nsort;
-				b = 0;
-
-				while (s >= 0 && (b < nsort && b >= 0)) {
-					s = nsort;
-					supply = 0;
-					while ((supply <= 0) && (s >= 0)) {
-						/* Deconstructing ids from single sorted array - assuming ids in
-						 the sorted array are of the form ns*tnf*(12 - month) + (12 - month)*nf + month - bm->MofY */
-						step1 = (int) floor(ROUNDGUARD + (linearPI[sp][idd_id][s] / (nm + small_num))); /* First step in finding fishery_id and subfleet_id */
-						sellerns = (int) floor(ROUNDGUARD + (step1 / (tnf + small_num))); /* Finding subfleet_id */
-						sellernf = step1 % tnf; /* Finding the fishery_id */
-
-						/* Use totPlanEffort and totPlanCatch calculated elsewhere */
-						supply = 0;
-						totPlannedEffort = bm->SUBFLEET_ECONprms[sellernf][sellerns][totPlanEffort_id];
-						totPlannedCatch = bm->SUBFLEET_ECONprms[sellernf][sellerns][totPlanCatch_id];
-						cumCatch = bm->QuotaAlloc[sellernf][sellerns][sp][cumboatcatch_id];
-						expectedCatch = bm->MonthAlloc[sellernf][sellerns][sp][bm->MofY];
+				supply = 0;
+				while (supply <= 0 && s >= 0) {
+					/* Deconstructing ids from single sorted array - assuming ids in
+					 the sorted array are of the form ns*tnf*(12 - month) + (12 - month)*nf + month - bm->MofY */
+					step1 = (int) floor(ROUNDGUARD + (linearPI[sp][idd_id][s] / (nm + small_num))); /* First step in finding fishery_id and subfleet_id */
+					sellerns = (int) floor(ROUNDGUARD + (step1 / (tnf + small_num))); /* Finding subfleet_id */
+					sellernf = step1 % tnf; /* Finding the fishery_id */
+					sellermonth = (int) floor(ROUNDGUARD + (linearPI[sp][idd_id][s])) % nm; /* Finding the month_id */
+
+					/* Expected annual quota leftover if no fishing in this month */
+					if ((bm->EffortSchedule[sellernf][sellerns][sellermonth][expect_id] > 0) && (bm->MargRent[sellernf][sellerns][sp][sellermonth] < 0)) {
+						scheduledEffort = bm->EffortSchedule[sellernf][sellerns][sellermonth][expect_id];
+						ExpCatch = bm->BlackBook[sellernf][sellerns][sp][sellermonth][expect_id];
+						ExpEffort = bm->EffortSchedule[sellernf][sellerns][sellermonth][hist_id];
+						expectedDecreaseCatch = scheduledEffort * ExpCatch / (ExpEffort + small_num);
 						prop_olease = bm->QuotaAlloc[sellernf][sellerns][sp][permolease_id];
 						prop_tlease = bm->QuotaAlloc[sellernf][sellerns][sp][templease_id];
 						ownQuota = (1.0 - prop_olease - prop_tlease) * bm->QuotaAlloc[sellernf][sellerns][sp][owned_id];
 						leaseQuota = bm->QuotaAlloc[sellernf][sellerns][sp][leased_id];
-						effThresh = 30.0; /* Effort threshold as max can actually do
-						 - if effort = days fishing then 30 is thresh,
-						 if seconds then 86400*30 etc */
-						if ((totPlannedEffort >= (12.0 - bm->MofY) * effThresh) && ((totPlannedCatch + cumCatch) < (ownQuota + leaseQuota))) {
-							supply = (ownQuota + leaseQuota) - (totPlannedCatch + cumCatch);
-						}
+						cumCatch = bm->QuotaAlloc[sellernf][sellerns][sp][cumboatcatch_id];
+						/* Need supply to cover the rest of the year */
+						expectedCatch = restCatch[sellernf][sellerns];
+						remainderQ = ownQuota + leaseQuota - cumCatch - (expectedCatch - expectedDecreaseCatch);
+						supply = min(expectedDecreaseCatch, remainderQ);
+					}
+					if (supply <= 0)
+						s--;
+				}
 
-						if (supply <= 0)
-							s--;
+				if ((demand <= bm->recon_buffer) || (supply <= bm->recon_buffer))
+					break;
+
+				down_time = bm->SUBFLEET_ECONprms[buyernf][buyerns][down_time_id];
+				max_month_effort = bm->month_scalar * (1 - down_time) * bm->SUBFLEET_ECONprms[buyernf][buyerns][nboat_id];
+				Trade(bm, sp, bm->MofY, buyernf, buyerns, sellernf, sellerns, demand, supply, buyermonth, sellermonth, max_month_effort, &remain_demand,
+						&remain_supply, llogfp);
+
+				/* Trade() does not change the effort schedule so the planned effort and catch
+				 are the rest of year totals worked out above */
+				bm->SUBFLEET_ECONprms[sellernf][sellerns][totPlanEffort_id] = planEffort[sellernf][sellerns];
+				bm->SUBFLEET_ECONprms[sellernf][sellerns][totPlanCatch_id] = planCatch[sellernf][sellerns];
+				bm->SUBFLEET_ECONprms[buyernf][buyerns][totPlanEffort_id] = planEffort[buyernf][buyerns];
+				bm->SUBFLEET_ECONprms[buyernf][buyerns][totPlanCatch_id] = planCatch[buyernf][buyerns];
+			}
+
+			/* Step 2 see if there is anyone with full effort scedule but is expected to not fill their quota */
+
+			s = nsort;
+			b = 0;
+
+			while (s >= 0 && (b < nsort && b >= 0)) {
+				s = nsort;
+				supply = 0;
+				while ((supply <= 0) && (s >= 0)) {
+					/* Deconstructing ids from single sorted array - assuming ids in
+					 the sorted array are of the form ns*tnf*(12 - month) + (12 - month)*nf + month - bm->MofY */
+					step1 = (int) floor(ROUNDGUARD + (linearPI[sp][idd_id][s] / (nm + small_num))); /* First step in finding fishery_id and subfleet_id */
+					sellerns = (int) floor(ROUNDGUARD + (step1 / (tnf + small_num))); /* Finding subfleet_id */
+					sellernf = step1 % tnf; /* Finding the fishery_id */
+
+					/* Use totPlanEffort and totPlanCatch calculated elsewhere */
+					supply = 0;
+					totPlannedEffort = bm->SUBFLEET_ECONprms[sellernf][sellerns][totPlanEffort_id];
+					totPlannedCatch = bm->SUBFLEET_ECONprms[sellernf][sellerns][totPlanCatch_id];
+					cumCatch = bm->QuotaAlloc[sellernf][sellerns][sp][cumboatcatch_id];
+					expectedCatch = bm->MonthAlloc[sellernf][sellerns][sp][bm->MofY];
+					prop_olease = bm->QuotaAlloc[sellernf][sellerns][sp][permolease_id];
+					prop_tlease = bm->QuotaAlloc[sellernf][sellerns][sp][templease_id];
+					ownQuota = (1.0 - prop_olease - prop_tlease) * bm->QuotaAlloc[sellernf][sellerns][sp][owned_id];
+					leaseQuota = bm->QuotaAlloc[sellernf][sellerns][sp][leased_id];
+					effThresh = 30.0; /* Effort threshold as max can actually do
+					 - if effort = days fishing then 30 is thresh,
+					 if seconds then 86400*30 etc */
+					if ((totPlannedEffort >= (12.0 - bm->MofY) * effThresh) && ((totPlannedCatch + cumCatch) < (ownQuota + leaseQuota))) {
+						supply = (ownQuota + leaseQuota) - (totPlannedCatch + cumCatch);
 					}
 
-					b = 0;
+					if (supply <= 0)
+						s--;
+				}
+
+				b = 0;
+				demand = 0;
+				while ((demand <= 0) && (b < nsort && b >= 0)) {
 					demand = 0;
-					while ((demand <= 0) && (b < nsort && b >= 0)) {
-						demand = 0;
-						/* Deconstructing ids from single sorted array - assuming ids in
-						 the sorted array are of the form ns*tnf*(12 - month) + (12 - month)*nf + month - bm->MofY */
-						step1 = (int) floor(ROUNDGUARD + (linearPI[sp][idd_id][b] / (nm + small_num))); /* First step in finding fishery_id and subfleet_id */
-						buyerns = (int) floor(ROUNDGUARD + (step1 / (tnf + small_num))); /* Finding subfleet_id */
-						buyernf = step1 % tnf; /* Finding the fishery_id */
-						buyermonth = (int) floor(ROUNDGUARD + (linearPI[sp][idd_id][b])) % nm; /* Finding the month_id */
-
-						/* The expected increase in catch by filling the current month */
-						if ((max_month_effort - bm->EffortSchedule[buyernf][buyerns][buyermonth][expect_id] >= 1)
-								&& (bm->MargRent[buyernf][buyerns][sp][buyermonth] >= 0)) {
-							scheduledEffort = bm->EffortSchedule[buyernf][buyerns][buyermonth][expect_id];
-							ExpCatch = bm->BlackBook[buyernf][buyerns][sp][buyermonth][expect_id];
-							ExpEffort = bm->EffortSchedule[buyernf][buyerns][buyermonth][hist_id];
-							prop_olease = bm->QuotaAlloc[buyernf][buyerns][sp][permolease_id];
-							prop_tlease = bm->QuotaAlloc[buyernf][buyerns][sp][templease_id];
-							ownQuota = (1.0 - prop_olease - prop_tlease) * bm->QuotaAlloc[buyernf][buyerns][sp][owned_id];
-							leaseQuota = bm->QuotaAlloc[buyernf][buyerns][sp][leased_id];
-							cumCatch = bm->QuotaAlloc[buyernf][buyerns][sp][cumboatcatch_id];
-							expectedIncreasedCatch = (max_month_effort - scheduledEffort) * ExpCatch / (ExpEffort + small_num);
-							expectedCatch = 0;
-							for (m = bm->MofY; m < 12; m++) {
-								scheduledEffort = bm->EffortSchedule[buyernf][buyerns][m][expect_id];
-								ExpCatch = bm->BlackBook[buyernf][buyerns][sp][m][expect_id];
-								ExpEffort = bm->EffortSchedule[buyernf][buyerns][m][hist_id];
-								expectedCatch += scheduledEffort * ExpCatch / (ExpEffort + small_num);
-							}
-							demand = cumCatch + expectedCatch + expectedIncreasedCatch - ownQuota - leaseQuota;
+					/* Deconstructing ids from single sorted array - assuming ids in
+					 the sorted array are of the form ns*tnf*(12 - month) + (12 - month)*nf + month - bm->MofY */
+					step1 = (int) floor(ROUNDGUARD + (linearPI[sp][idd_id][b] / (nm + small_num))); /* First step in finding fishery_id and subfleet_id */
+					buyerns = (int) floor(ROUNDGUARD + (step1 / (tnf + small_num))); /* Finding subfleet_id */
+					buyernf = step1 % tnf; /* Finding the fishery_id */
+					buyermonth = (int) floor(ROUNDGUARD + (linearPI[sp][idd_id][b])) % nm; /* Finding the month_id */
+
+					/* The expected increase in catch by filling the current month */
+					if ((max_month_effort - bm->EffortSchedule[buyernf][buyerns][buyermonth][expect_id] >= 1)
+							&& (bm->MargRent[buyernf][buyerns][sp][buyermonth] >= 0)) {
+						scheduledEffort = bm->EffortSchedule[buyernf][buyerns][buyermonth][expect_id];
+						ExpCatch = bm->BlackBook[buyernf][buyerns][sp][buyermonth][expect_id];
+						ExpEffort = bm->EffortSchedule[buyernf][buyerns][buyermonth][hist_id];
+						prop_olease = bm->QuotaAlloc[buyernf][buyerns][sp][permolease_id];
+						prop_tlease = bm->QuotaAlloc[buyernf][buyerns][sp][templease_id];
+						ownQuota = (1.0 - prop_olease - prop_tlease) * bm->QuotaAlloc[buyernf][buyerns][sp][owned_id];
+						leaseQuota = bm->QuotaAlloc[buyernf][buyerns][sp][leased_id];
+						cumCatch = bm->QuotaAlloc[buyernf][buyerns][sp][cumboatcatch_id];
+						expectedIncreasedCatch = (max_month_effort - scheduledEffort) * ExpCatch / (ExpEffort + small_num);
+						expectedCatch = restCatch[buyernf][buyerns];
+						demand = cumCatch + expectedCatch + expectedIncreasedCatch - ownQuota - leaseQuota;
 
-						}
-						if (demand <= 0)
-							b++;
 					}
+					if (demand <= 0)
+						b++;
+				}
 
-					if ((demand <= bm->recon_buffer) || (supply <= bm->recon_buffer))
-						break;
+				if ((demand <= bm->recon_buffer) || (supply <= bm->recon_buffer))
+					break;
 
-					down_time = bm->SUBFLEET_ECONprms[buyernf][buyerns][down_time_id];
-					max_month_effort = bm->month_scalar * (1 - down_time) * bm->SUBFLEET_ECONprms[buyernf][buyerns][nboat_id];
-					Trade(bm, sp, bm->MofY, buyernf, buyerns, sellernf, sellerns, demand, supply, buyermonth, sellermonth, max_month_effort, &remain_demand,
-							&remain_supply, llogfp);
+				down_time = bm->SUBFLEET_ECONprms[buyernf][buyerns][down_time_id];
+				max_month_effort = bm->month_scalar * (1 - down_time) * bm->SUBFLEET_ECONprms[buyernf][buyerns][nboat_id];
+				Trade(bm, sp, bm->MofY, buyernf, buyerns, sellernf, sellerns, demand, supply, buyermonth, sellermonth, max_month_effort, &remain_demand,
+						&remain_supply, llogfp);
 
-					/* Use totPlanEffort and totPlanCatch calculated elsewhere
-					 FIX - AS NOT UPDATING EFFORT ETC HERE RIGHT?? WHY NEED TO CALCULATE IT AGAIN? */
+				/* Use totPlanEffort and totPlanCatch calculated elsewhere
+				 FIX - AS NOT UPDATING EFFORT ETC HERE RIGHT?? WHY NEED TO CALCULATE IT AGAIN? */
 
-				}
 			}
 		}
+
+		i_free1d(marketSize);
+		free2d(restCatch);
+		free2d(planEffort);
+		free2d(planCatch);
 	}
 
 	/* If dealing with packages not single species quota trading */
@@ -1626,7 +1623,7 @@ void Trade(MSEBoxModel *bm, int sp, int month, int buyernf, int buyerns, int sel
 		final_VNR = NRA_thresh;
 	p_perm = 1.0 / (1.0 + exp(-final_VNR));
 
-	rndnum = drandom(0.0, 1.0);
+	rndnum = Util_Random(bm, rand_econ_id, 0.0, 1.0);
 
 	if (do_debug) {
 		fprintf(
@@ -256,9 +256,10 @@ void Harvest_Init_Layer_Arrays(MSEBoxModel *bm, int ij, int nl, FILE *llogfp) {
  *	Assumes all ids to be reset sit within the pBox->fstat vector
  */
 void Harvest_Update_Temp_Catch_Array(MSEBoxModel *bm, FILE *llogfp) {
-	int sp, n, ij, nl;
-	int d = bm->K_num_catchqueue - 1;
+	int sp, n, ij, nl, d;
+	int last = bm->K_num_catchqueue - 1;
 	double list_length = (double) (bm->K_num_catchqueue);
+	double *catchrow, *queue;
 
 	/* Obviously for the first k_length_catchqueue time steps you
 	 really not taking anything off the queue, just building it up,
@@ -267,17 +268,21 @@ void Harvest_Update_Temp_Catch_Array(MSEBoxModel *bm, FILE *llogfp) {
 	 Also setting up first value of LastCatch to work from.
 	 */
 
+	/* Each entry only depends on its own catch so the boxes are taken in the outer loop,
+	 which walks the catch array (box x group x fishery x layer) in storage order */
 	if (bm->t < (2.0 * bm->dt)) {
-		for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
-			if (FunctGroupArray[sp].isFished == TRUE) {
-				for (n = 0; n < bm->K_num_fisheries; n++) {
-					for (ij = 0; ij < bm->nbox; ij++) {
+		for (ij = 0; ij < bm->nbox; ij++) {
+			for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
+				if (FunctGroupArray[sp].isFished == TRUE) {
+					for (n = 0; n < bm->K_num_fisheries; n++) {
+						catchrow = bm->Catch[ij][sp][n];
+						queue = bm->CatchQueue[sp][n][ij];
 
 						/* Set up the catch queue */
 						for (d = 0; d < bm->K_num_catchqueue; d++) {
-							bm->CatchQueue[sp][n][ij][d] = 0;
+							queue[d] = 0;
 							for (nl = 0; nl < bm->boxes[ij].nz; nl++) {
-								bm->CatchQueue[sp][n][ij][d] += (bm->Catch[ij][sp][n][nl] / list_length);
+								queue[d] += (catchrow[nl] / list_length);
 							}
 						}
 
@@ -288,7 +293,7 @@ void Harvest_Update_Temp_Catch_Array(MSEBoxModel *bm, FILE *llogfp) {
 						 */
 						bm->LastCatch[sp][n][ij] = 0.0;
 						for (d = 0; d < bm->K_num_catchqueue; d++) {
-							bm->LastCatch[sp][n][ij] += bm->CatchQueue[sp][n][ij][d];
+							bm->LastCatch[sp][n][ij] += queue[d];
 						}
 					}
 				}
@@ -298,25 +303,28 @@ void Harvest_Update_Temp_Catch_Array(MSEBoxModel *bm, FILE *llogfp) {
 
 	} else {
 		/* Standard case - once queue initialised */
-		for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
-			if (FunctGroupArray[sp].isFished == TRUE) {
-				for (n = 0; n < bm->K_num_fisheries; n++) {
-					for (ij = 0; ij < bm->nbox; ij++) {
-						bm->LastCatch[sp][n][ij] -= bm->CatchQueue[sp][n][ij][d];
+		for (ij = 0; ij < bm->nbox; ij++) {
+			for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
+				if (FunctGroupArray[sp].isFished == TRUE) {
+					for (n = 0; n < bm->K_num_fisheries; n++) {
+						catchrow = bm->Catch[ij][sp][n];
+						queue = bm->CatchQueue[sp][n][ij];
+
+						bm->LastCatch[sp][n][ij] -= queue[last];
 
 						/* Shift everything along the CatchQueue one spot */
 						for (d = 0; d < bm->K_num_catchqueue - 1; d++) {
-							bm->CatchQueue[sp][n][ij][d + 1] = bm->CatchQueue[sp][n][ij][d];
+							queue[d + 1] = queue[d];
 						}
 						/* Reinitialise first (most recent) spot in the queue as about to fill it */
-						bm->CatchQueue[sp][n][ij][0] = 0;
+						queue[0] = 0;
 
 						for (nl = 0; nl < bm->boxes[ij].nz; nl++) {
-							bm->CatchQueue[sp][n][ij][0] += (bm->Catch[ij][sp][n][nl] / list_length);
+							queue[0] += (catchrow[nl] / list_length);
 						}
 
 						/* Update LastCatch */
-						bm->LastCatch[sp][n][ij] += bm->CatchQueue[sp][n][ij][0];
+						bm->LastCatch[sp][n][ij] += queue[0];
 
 					}
 				}
@@ -364,6 +372,51 @@ void Harvest_Set_Fishery_Active(MSEBoxModel *bm, FILE *llogfp) {
 	return;
 }
 
+/**
+ *	\brief Build the list of fisheries that can take each group this timestep.
+ *
+ *	A fishery is left off a group's list when Harvest_Do_Fishing_And_ByCatch would skip it
+ *	in every cell anyway - the fishery hasn't started or has finished, it isn't active at
+ *	this time of day, or Get_Catch's short cut applies (no q, F, imposed catch, dependent
+ *	discards, targeting or incidental mortality). Called once per timestep before the box
+ *	biology so any management changes made since the last timestep are picked up.
+ */
+void Harvest_Set_Active_Catch_Lists(MSEBoxModel *bm) {
+	int sp, nf, flagimposecatch, depend_dis, flagF;
+
+	for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
+		catch_num_active_nf[sp] = 0;
+
+		for (nf = 0; nf < bm->K_num_fisheries; nf++) {
+			if ((bm->dayt < bm->FISHERYprms[nf][tStart_id]) || (bm->dayt > bm->FISHERYprms[nf][tEnd_id]))
+				continue;
+
+			if (!(int) (bm->FISHERYprms[nf][fisheriesactive_id]))
+				continue;
+
+			if ((int) (bm->SP_FISHERYprms[sp][nf][flagdiscard_id]) == depend_discard)
+				depend_dis = 1;
+			else
+				depend_dis = 0;
+
+			flagimposecatch = (int) (bm->SP_FISHERYprms[sp][nf][flagimposecatch_id]);
+			if ((bm->dayt < bm->SP_FISHERYprms[sp][nf][imposecatchstart_id]) || (bm->dayt > bm->SP_FISHERYprms[sp][nf][imposecatchend_id]))
+				flagimposecatch = 0;
+
+			flagF = (int) (bm->SP_FISHERYprms[sp][nf][flagF_id]);
+
+			/* Same test as the short cut at the top of Get_Catch */
+			if ((!flagimposecatch) && (!bm->SP_FISHERYprms[sp][nf][q_id]) && (!depend_dis) && (!flagF) && (!bm->flagincidmort && (bm->FISHERYtarget[nf][sp] < 1)))
+				continue;
+
+			catch_active_nf[sp][catch_num_active_nf[sp]] = nf;
+			catch_num_active_nf[sp]++;
+		}
+	}
+
+	return;
+}
+
 /**
  *	Fishing mortality for target groups (vertebrate and invertebrate.
  *	This subroutine works out the pressure put on the groups
@@ -375,7 +428,7 @@ int Harvest_Do_Fishing_And_ByCatch(MSEBoxModel *bm, FILE *llogfp, int guildcase,
 	double li, loadDetFC, FCtoDR, SPtoFC, fishing, age_catch, discards, Wgt, Dens, Biom, deadnums, age_discard, vert_scale,
 			gear_change_scale, discard_change_scale, survivors, quota, prop_dis_dead, flagrecfish, fishery_start, fishery_end, loadFC, mpa_losses,
             FCwaste, on_deck, waste_offloaded;
-	int i, j, nf, sp, stage, flagspfish, flagimposecatch, boxkey_id;
+	int i, j, k, nf, sp, stage, flagspfish, flagimposecatch, boxkey_id;
 	int do_debug = 0, do_debug_dis = 0, do_debug_orig = 0, do_debug_dis_orig = 0, do_debug_econ = 0, do_debug_econ_orig = 0;
 	int depend_dis;
 
@@ -461,7 +514,9 @@ int Harvest_Do_Fishing_And_ByCatch(MSEBoxModel *bm, FILE *llogfp, int guildcase,
 		return FALSE;
 	}
 
-	for (nf = 0; nf < bm->K_num_fisheries; nf++) {
+	/* Only visit the fisheries that can take this group this timestep - see Harvest_Set_Active_Catch_Lists */
+	for (k = 0; k < catch_num_active_nf[guildcase]; k++) {
+		nf = catch_active_nf[guildcase][k];
         FCwaste = 0.0;
 
 		fishery_end = bm->FISHERYprms[nf][tEnd_id];
@@ -1425,6 +1480,10 @@ void Basic_Habitat_Overlap(MSEBoxModel *bm, int b, FILE *llogfp) {
 		FC_hdistrib[b][nf] = prop_access;
 	}
 
+	/* Any scaled overlaps cached for this box are now stale */
+	for (nf = 0; nf < bm->K_num_fisheries; nf++)
+		p_fish_scale_valid[b][nf] = FALSE;
+
 	/* Determine relative area in common with each species */
 	for (sp = 0; sp < bm->K_num_tot_sp; sp++)
 		if (FunctGroupArray[sp].isImpacted == TRUE)
@@ -1483,6 +1542,11 @@ void Basic_Habitat_Overlap(MSEBoxModel *bm, int b, FILE *llogfp) {
 
 /**
  *	Adjust total area effected by fishing to reflect changes in actual area fished.
+ *
+ *	The scaled overlaps are cached per box and fishery in p_fish_scaledi and only
+ *	recalculated when the fishery's spatial change scale has moved since the box was
+ *	last visited (or Basic_Habitat_Overlap has reset the box). p_fishi is then pointed
+ *	at this box's entry in the cache.
  */
 void Harvest_Update_Habitat_Overlap(MSEBoxModel *bm, int b) {
 	double P_scale, P_orig, newP;
@@ -1501,6 +1565,13 @@ void Harvest_Update_Habitat_Overlap(MSEBoxModel *bm, int b) {
 
 		P_scale = Get_Fishery_Change_Scale(bm, nf, P_num_changes_id, P_num_changes_id, Pchange);
 
+		/* Nothing has changed for this fishery in this box since it was last done */
+		if (p_fish_scale_valid[b][nf] && (p_fish_scale_used[b][nf] == P_scale))
+			continue;
+
+		p_fish_scale_used[b][nf] = P_scale;
+		p_fish_scale_valid[b][nf] = TRUE;
+
 		for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
 			if (FunctGroupArray[sp].isImpacted == TRUE) {
 				for (stage = 0; stage < FunctGroupArray[sp].numStages; stage++) {
@@ -1513,12 +1584,14 @@ void Harvest_Update_Habitat_Overlap(MSEBoxModel *bm, int b) {
 
 					/* Is allowed to be > 1.0 as can represent concentration of fish and
 					 boats at aggregation sites (e.g. canyons) */
-					p_fishi[sp][stage][nf] = newP;
+					p_fish_scaledi[b][sp][stage][nf] = newP;
 				}
 			}
 		}
 	}
 
+	p_fishi = p_fish_scaledi[b];
+
 	return;
 }
 
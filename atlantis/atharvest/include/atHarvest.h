@@ -53,7 +53,8 @@
  Modelling variables for control of processes within the model
  */
 
-extern double ***p_fishi, ***Effort_vdistrib, ****p_fish_origi, ***MPAchange, **FC_hdistrib, **effort_scale, ***Effort_hdistrib, ***qSTOCK;
+extern int **p_fish_scale_valid, **catch_active_nf, *catch_num_active_nf;
+extern double ***p_fishi, ***Effort_vdistrib, ****p_fish_origi, ****p_fish_scaledi, **p_fish_scale_used, ***MPAchange, **FC_hdistrib, **effort_scale, ***Effort_hdistrib, ***qSTOCK;
 
 extern double ****RegCatch; // From economics library
 
@@ -47,6 +47,7 @@ void Harvest_Init_Layer_Arrays(MSEBoxModel *bm, int ij, int nl, FILE *llogfp);
 void Harvest_Update_Temp_Catch_Array(MSEBoxModel *bm, FILE *llogfp);
 
 void Harvest_Set_Fishery_Active(MSEBoxModel *bm, FILE *llogfp);
+void Harvest_Set_Active_Catch_Lists(MSEBoxModel *bm);
 int Harvest_Do_Fishing_And_ByCatch(MSEBoxModel *bm, FILE *llogfp, int guildcase, int chrt, double SC, double RC, double NUMS, double **FishingRes,
 		double *numsdead, double *waste);
 int Harvest_Get_Num_Gear_Changes(MSEBoxModel *bm, int nf, FILE *llogfp);
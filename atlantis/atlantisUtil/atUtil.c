@@ -165,6 +165,9 @@
 #include <atHarvestLib.h>
 #include <atManageLib.h>
 #include <atImplementationLib.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 char **paramStrings;
@@ -970,11 +973,11 @@ double Util_Mich_Ment(double x, double m) {
  *    \brief random number from normal distribution
  *
  */
-double Util_Normx_Result(double mu, double sigma) {
+double Util_Normx_Result(MSEBoxModel *bm, double mu, double sigma) {
     double result, step_a, step_b, step_c;
 
-    step_a = drandom(0.0, 1.0);
-    step_b = drandom(0.0, 1.0);
+    step_a = Util_Random(bm, rand_recruit_id, 0.0, 1.0);
+    step_b = Util_Random(bm, rand_recruit_id, 0.0, 1.0);
     step_c = sqrt(-2.0 * log(step_a)) * cos(2.0 * 3.1415926 * step_b);
     result = step_c * sigma + mu;
 
@@ -986,10 +989,10 @@ double Util_Normx_Result(double mu, double sigma) {
  *	\brief random number from lognormal distribution
  *
  */
-double Util_Logx_Result(double mu, double sigma) {
+double Util_Logx_Result(MSEBoxModel *bm, double mu, double sigma) {
 	double x_b, result, step_a, step_b, step_c;
 
-	x_b = drandom(0.0, 1.0);
+	x_b = Util_Random(bm, rand_recruit_id, 0.0, 1.0);
 	step_a = 1.0 / (x_b * sigma * sqrt(2.0 * 3.141592654));
 	step_b = (log(x_b) - mu) * (log(x_b) - mu);
 	step_c = 2.0 * sigma * sigma;
@@ -1015,6 +1018,45 @@ double Util_Lognorm_Distrib(double mu, double sigma, double x_b) {
 
 }
 
+/**
+ *	\brief Running sum of the n (non-negative) bin probabilities in p, for use with
+ *	Util_Sample_Cumulative. The sums are accumulated in bin order so they match a linear scan.
+ *
+ */
+void Util_Cumulative_Probs(double *p, double *cumprob, int n) {
+	int i;
+	double upper = 0.0;
+
+	for (i = 0; i < n; i++) {
+		upper += p[i];
+		cumprob[i] = upper;
+	}
+}
+
+/**
+ *	\brief Index of the bin whose subinterval [cumprob[i-1], cumprob[i]) contains the variate u,
+ *	found by bisection rather than scanning every bin. Returns -1 if u lies beyond cumprob[n-1]
+ *	(i.e. the probabilities summed to less than u).
+ *
+ */
+int Util_Sample_Cumulative(double *cumprob, int n, double u) {
+	int lo = 0, hi = n - 1, mid;
+
+	if ((n < 1) || (u >= cumprob[n - 1]))
+		return -1;
+
+	/* First bin with cumprob[i] > u */
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (cumprob[mid] > u)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+
+	return lo;
+}
+
 int at_compileRegExpression(regex_t *regBuffer, char *str) {
 	int returnValue;
 	regBuffer->re_nsub = 1;
@@ -1160,6 +1202,49 @@ void Util_GenMnorm(double *vec, double *means, int *iseed, int np, double **tt,
 	return;
 }
 
+/* One entry per output file type (-1 to 6) for Util_Check_NetCDF_Size */
+#define NC_SIZE_NTYPES 8
+
+static int ncSizeKnown[NC_SIZE_NTYPES];
+static int ncSizeFid[NC_SIZE_NTYPES];
+static double ncSizeHeader[NC_SIZE_NTYPES];
+
+/**
+ * \brief Size of the data in an open classic netCDF file, worked out from the
+ * variable shapes and the number of records the library has written (the record
+ * dimension length). The file header is not included.
+ */
+static double Util_NetCDF_Data_Bytes(int fid) {
+	int ndims, nvars, natts, recdim, varid, vndims, d;
+	int dimids[NC_MAX_VAR_DIMS];
+	long numrecs = 0, dimlen;
+	double fixedBytes = 0, recBytes = 0, varBytes;
+	nc_type vtype;
+
+	ncinquire(fid, &ndims, &nvars, &natts, &recdim);
+	if (recdim >= 0)
+		ncdiminq(fid, recdim, NULL, &numrecs);
+
+	for (varid = 0; varid < nvars; varid++) {
+		ncvarinq(fid, varid, NULL, &vtype, &vndims, dimids, NULL);
+		varBytes = nctypelen(vtype);
+		for (d = 0; d < vndims; d++) {
+			if (dimids[d] == recdim)
+				continue;
+			ncdiminq(fid, dimids[d], NULL, &dimlen);
+			varBytes *= (double) dimlen;
+		}
+		/* Each variable's data is padded out to a 4 byte boundary */
+		varBytes = 4.0 * ceil(varBytes / 4.0);
+		if (vndims > 0 && dimids[0] == recdim)
+			recBytes += varBytes;
+		else
+			fixedBytes += varBytes;
+	}
+
+	return fixedBytes + recBytes * (double) numrecs;
+}
+
 int Util_Check_NetCDF_Size(MSEBoxModel *bm, int fid, int *dump, char *fileName, int *index, int type){
 	struct stat buffer;
 	char fname[STRLEN*2];
@@ -1167,6 +1252,8 @@ int Util_Check_NetCDF_Size(MSEBoxModel *bm, int fid, int *dump, char *fileName,
 	char tempStr[STRLEN];
 	char *pdest;
 	int newFid;
+	int sizeIndex = type + 1;
+	double fileBytes;
 
 	if(fid < 0)
 		return -1;
@@ -1182,13 +1269,21 @@ int Util_Check_NetCDF_Size(MSEBoxModel *bm, int fid, int *dump, char *fileName,
 	}
 
 
-	/* Might need to close the file and then open it after we have checked its size */
-	/* Check the size of the diff file. */
-	if(stat(fname, &buffer) < 0){
-		quit("Unable to get information about file %s\n", fileName);
+	/* The file is only looked at once, to find the size of its header. After that the
+	 * size comes from the record count the netCDF library keeps for the open file.
+	 */
+	if (!ncSizeKnown[sizeIndex] || ncSizeFid[sizeIndex] != fid) {
+		if(stat(fname, &buffer) < 0){
+			quit("Unable to get information about file %s\n", fileName);
+		}
+		ncSizeHeader[sizeIndex] = max(0.0, (double) buffer.st_size - Util_NetCDF_Data_Bytes(fid));
+		ncSizeFid[sizeIndex] = fid;
+		ncSizeKnown[sizeIndex] = TRUE;
 	}
+	fileBytes = ncSizeHeader[sizeIndex] + Util_NetCDF_Data_Bytes(fid);
 
-	if (buffer.st_size > MAX_NETCDF_FILE_SIZE) {
+	/* Might need to close the file and then open it after we have checked its size */
+	if (fileBytes > MAX_NETCDF_FILE_SIZE) {
 		strcpy(tempStr, fileName);
 		pdest = strstr(tempStr, endname);
 		*pdest = '\0';
@@ -1211,9 +1306,37 @@ int Util_Check_NetCDF_Size(MSEBoxModel *bm, int fid, int *dump, char *fileName,
 		}
 		*dump = 0;
 
+		/* Measure the new file's header next time round */
+		ncSizeKnown[sizeIndex] = FALSE;
 
 		return newFid;
 
 	}
 	return fid;
 }
+
+/**
+ * \brief Number of threads to use in the parallelised submodels.
+ *
+ * Returns bm->nthreads when the code has been built with OpenMP support
+ * (configure --enable-openmp), otherwise 1 so the serial code path is always used.
+ */
+int Util_Get_Num_Threads(MSEBoxModel *bm) {
+#ifdef _OPENMP
+	if (bm->nthreads > 1)
+		return bm->nthreads;
+#endif
+	return 1;
+}
+
+/**
+ * \brief Index of the calling thread - 0 outside a parallel region or in serial builds.
+ */
+int Util_Get_Thread_Num(void) {
+#ifdef _OPENMP
+	return omp_get_thread_num();
+#else
+	return 0;
+#endif
+}
+
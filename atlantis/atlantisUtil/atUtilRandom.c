@@ -0,0 +1,176 @@
+/**
+ * \ingroup atUtil
+ * \file atUtilRandom.c
+ * \brief Named, counter based random number streams.
+ *
+ * Each subsystem (ecology, recruitment, survey sampling, assessment, close kin,
+ * management, economics) draws from its own stream. A stream is keyed on the run
+ * seed and the stream id, and value n of a stream is a pure function of
+ * (seed, stream, substream, pass, n) - computed with the Philox4x32-10 generator
+ * (Salmon et al. 2011, "Parallel random numbers: as easy as 1, 2, 3"). This means
+ * one subsystem's draws do not depend on how many draws the others made, and a
+ * stream can be jumped ahead without generating the skipped values.
+ *
+ * The shared streams in bm (substream 0) keep a draw counter, so they are only drawn
+ * from serial code through Util_Random(). Threaded loops start a new pass of the stream
+ * from serial code with Util_Rand_New_Pass() and then give each box (or sample year etc.)
+ * its own keyed substream with Util_Rand_Substream(). The values a box gets then only
+ * depend on the seed, the pass, the box and how many values that box has drawn, so they
+ * are the same whatever the number of threads.
+ *
+ * The streams are only used if the run parameter rand_seed is set (> 0), otherwise
+ * Util_Random() and Util_Random_Substream() fall back on drandom() so existing runs
+ * reproduce exactly. Threaded loops that draw must then stay on one thread.
+ *
+ *    <b>Revisions</b>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <sjwlib.h>
+#include "atlantisboxmodel.h"
+#include "atUtilLib.h"
+
+#define PHILOX_M0 0xD2511F53U
+#define PHILOX_M1 0xCD9E8D57U
+#define PHILOX_W0 0x9E3779B9U
+#define PHILOX_W1 0xBB67AE85U
+#define PHILOX_ROUNDS 10
+
+/* Values are made from 32 bits so scale into the open interval (0, 1) */
+#define RAND_SCALE (1.0 / 4294967296.0)
+
+/**
+ * \brief Philox4x32-10 block function - encrypt the 128 bit counter ctr with the 64 bit key.
+ */
+static void Philox4x32(const unsigned int ctr[4], const unsigned int key[2], unsigned int out[4]) {
+	unsigned int c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+	unsigned int k0 = key[0], k1 = key[1];
+	unsigned long long prod0, prod1;
+	int round;
+
+	for (round = 0; round < PHILOX_ROUNDS; round++) {
+		if (round > 0) {
+			k0 += PHILOX_W0;
+			k1 += PHILOX_W1;
+		}
+		prod0 = (unsigned long long)PHILOX_M0 * c0;
+		prod1 = (unsigned long long)PHILOX_M1 * c2;
+
+		c0 = (unsigned int)(prod1 >> 32) ^ c1 ^ k0;
+		c2 = (unsigned int)(prod0 >> 32) ^ c3 ^ k1;
+		c1 = (unsigned int)prod1;
+		c3 = (unsigned int)prod0;
+	}
+
+	out[0] = c0;
+	out[1] = c1;
+	out[2] = c2;
+	out[3] = c3;
+}
+
+/**
+ * \brief Value counter (0, 1, 2, ...) of the given seed, stream, substream and pass, uniform on (0, 1).
+ *
+ * This has no state so it can be called from threaded code.
+ */
+double Util_Rand_Counter_Uniform(unsigned int seed, int stream, unsigned int substream, unsigned int pass, unsigned long long counter) {
+	unsigned int ctr[4], key[2], out[4];
+	unsigned long long block = counter >> 2;
+
+	key[0] = seed;
+	key[1] = (unsigned int)stream;
+	ctr[0] = (unsigned int)block;
+	ctr[1] = (unsigned int)(block >> 32);
+	ctr[2] = substream;
+	ctr[3] = pass;
+
+	Philox4x32(ctr, key, out);
+
+	return ((double)out[counter & 3] + 0.5) * RAND_SCALE;
+}
+
+/**
+ * \brief Set up a stream at its first value.
+ */
+void Util_Rand_Stream_Init(RandStream *rs, unsigned int seed, int stream, unsigned int substream, unsigned int pass) {
+	rs->key[0] = seed;
+	rs->key[1] = (unsigned int)stream;
+	rs->substream = substream;
+	rs->pass = pass;
+	rs->npass = 0;
+	rs->ndraws = 0;
+}
+
+/**
+ * \brief Next value of the stream, uniform on (0, 1).
+ */
+double Util_Rand_Stream_Uniform(RandStream *rs) {
+	double ret = Util_Rand_Counter_Uniform(rs->key[0], (int)rs->key[1], rs->substream, rs->pass, rs->ndraws);
+
+	rs->ndraws++;
+
+	return ret;
+}
+
+/**
+ * \brief Skip the next ndraws values of the stream without generating them.
+ */
+void Util_Rand_Jump(RandStream *rs, unsigned long long ndraws) {
+	rs->ndraws += ndraws;
+}
+
+/**
+ * \brief Initialise the named streams from the run seed (rand_seed in the run parameter file).
+ */
+void Util_Rand_Init(MSEBoxModel *bm) {
+	int stream;
+
+	for (stream = 0; stream < num_rand_streams; stream++) {
+		Util_Rand_Stream_Init(&bm->randStreams[stream], (unsigned int)bm->rand_seed, stream, 0, 0);
+	}
+}
+
+/**
+ * \brief Random number between min and max from the named stream (one of RAND_STREAMS, e.g. rand_survey_id).
+ *
+ * Without a run seed this is drandom(min, max), so the original shared sequence is kept.
+ */
+double Util_Random(MSEBoxModel *bm, int stream, double min, double max) {
+	if (bm->rand_seed <= 0)
+		return drandom(min, max);
+
+	return (min + (max - min) * Util_Rand_Stream_Uniform(&bm->randStreams[stream]));
+}
+
+/**
+ * \brief Start a new pass of the named stream for a threaded loop. Call from serial code, before the loop.
+ *
+ * Each pass has its own set of substreams, so the values drawn in one pass are never reused in another.
+ */
+unsigned int Util_Rand_New_Pass(MSEBoxModel *bm, int stream) {
+	return ++bm->randStreams[stream].npass;
+}
+
+/**
+ * \brief Set up rs as the substream of the named stream for box (or thread, sample year etc.) id in the given pass.
+ *
+ * Only reads bm, so it can be called from inside the threaded loop.
+ */
+void Util_Rand_Substream(MSEBoxModel *bm, int stream, unsigned int pass, unsigned int id, RandStream *rs) {
+	/* Substream 0 is the shared stream */
+	Util_Rand_Stream_Init(rs, (unsigned int)bm->rand_seed, stream, id + 1, pass);
+}
+
+/**
+ * \brief Random number between min and max from a substream set up by Util_Rand_Substream.
+ *
+ * Without a run seed this is drandom(min, max), as in Util_Random, so the caller must keep to one thread.
+ */
+double Util_Random_Substream(MSEBoxModel *bm, RandStream *rs, double min, double max) {
+	if (bm->rand_seed <= 0)
+		return drandom(min, max);
+
+	return (min + (max - min) * Util_Rand_Stream_Uniform(rs));
+}
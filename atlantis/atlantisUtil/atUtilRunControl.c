@@ -0,0 +1,179 @@
+/**
+ * \ingroup atUtil
+ * \file atUtilRunControl.c
+ * \brief Run control - deciding when a run should stop early.
+ *
+ * A run can be halted in three ways:
+ *
+ *  - deleting (or renaming) the delete_to_halt_run file in the output folder, as before.
+ *    On Linux this is picked up by an inotify watch on the output folder, so the main
+ *    loop does not have to open the file every timestep.
+ *  - sending the process SIGUSR1.
+ *  - sending the process SIGTERM.
+ *
+ * The signal handlers only set a flag, which is checked once per timestep. They are
+ * installed just before the time loop starts (not for broker linked runs, which wait on
+ * the broker), with SA_RESTART so a signal does not make NetCDF writes or network reads
+ * fail with EINTR. A second SIGTERM gets the default action so a stuck run can still be
+ * killed.
+ *
+ * inotify does not see files deleted from another host on a network filesystem, so the
+ * halt file is still opened now and then (every RUN_CONTROL_POLL_SECONDS of wall time).
+ * Where inotify is not available the file is opened every timestep, as in older versions.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sjwlib.h>
+#include <atlantisboxmodel.h>
+#include <atUtilLib.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+#define RUN_CONTROL_HALT_FILE "delete_to_halt_run"
+#define RUN_CONTROL_POLL_SECONDS 60
+
+static volatile sig_atomic_t runControlSignal = 0;
+static int runControlFd = -1;
+static time_t runControlLastPoll = 0;
+
+#ifndef _WIN32
+static void Util_Run_Control_Handler(int sig) {
+	runControlSignal = sig;
+}
+#endif
+
+/**
+ * Open the halt file, returning TRUE if it is missing.
+ */
+static int Util_Run_Control_Poll(MSEBoxModel *bm) {
+	FILE *fp;
+
+	runControlLastPoll = time(NULL);
+	if ((fp = Util_fopen(bm, RUN_CONTROL_HALT_FILE, "r")) == NULL)
+		return TRUE;
+	fclose(fp);
+	return FALSE;
+}
+
+#ifdef __linux__
+/**
+ * Read any pending inotify events, returning TRUE if the halt file has gone.
+ * If the watch can no longer be trusted it is closed, and the halt file is checked
+ * directly from then on.
+ */
+static int Util_Run_Control_Read_Events(MSEBoxModel *bm) {
+	char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+	const struct inotify_event *event;
+	ssize_t len;
+	char *ptr;
+	int halt = FALSE, lost = FALSE;
+
+	while ((len = read(runControlFd, buf, sizeof(buf))) > 0) {
+		for (ptr = buf; ptr < buf + len; ptr += sizeof(struct inotify_event) + event->len) {
+			event = (const struct inotify_event *) ptr;
+			if (event->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED | IN_UNMOUNT))
+				lost = TRUE;
+			else if (event->len > 0 && strcmp(event->name, RUN_CONTROL_HALT_FILE) == 0)
+				halt = TRUE;
+		}
+	}
+	if (len < 0 && errno != EAGAIN && errno != EINTR)
+		lost = TRUE;
+
+	if (lost) {
+		fprintf(bm->logFile, "Run control - lost the watch on the output folder, checking the halt file every timestep\n");
+		close(runControlFd);
+		runControlFd = -1;
+		if (!halt)
+			halt = Util_Run_Control_Poll(bm);
+	}
+	return halt;
+}
+#endif
+
+/**
+ * Install the signal handlers and start watching the output folder for the halt
+ * file being removed. Call just before the time loop, after the halt file has been created.
+ */
+void Util_Run_Control_Init(MSEBoxModel *bm) {
+#ifndef _WIN32
+	struct sigaction action;
+
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = Util_Run_Control_Handler;
+	sigemptyset(&action.sa_mask);
+
+	/* Restart interrupted system calls, so blocking writes and reads in the time loop carry on */
+	action.sa_flags = SA_RESTART;
+	sigaction(SIGUSR1, &action, NULL);
+
+	/* The handler is removed once it has run, so a second SIGTERM kills the process */
+	action.sa_flags = SA_RESTART | SA_RESETHAND;
+	sigaction(SIGTERM, &action, NULL);
+#endif
+
+	runControlSignal = 0;
+	runControlLastPoll = 0;
+
+#ifdef __linux__
+	runControlFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (runControlFd >= 0) {
+		if (inotify_add_watch(runControlFd, strlen(bm->destFolder) ? bm->destFolder : ".",
+				IN_DELETE | IN_MOVED_FROM | IN_DELETE_SELF | IN_MOVE_SELF) < 0) {
+			close(runControlFd);
+			runControlFd = -1;
+		}
+	}
+	if (runControlFd < 0)
+		fprintf(bm->logFile, "Run control - unable to watch %s (%s), checking the halt file every timestep\n",
+				strlen(bm->destFolder) ? bm->destFolder : ".", strerror(errno));
+#endif
+}
+
+/**
+ * Returns TRUE if the run has been asked to stop.
+ */
+int Util_Run_Control_Halt(MSEBoxModel *bm) {
+	int halt = FALSE;
+
+	if (runControlSignal) {
+		printf("warning: Received signal %d so ending the run\n", (int) runControlSignal);
+		return TRUE;
+	}
+
+#ifdef __linux__
+	if (runControlFd >= 0) {
+		halt = Util_Run_Control_Read_Events(bm);
+		if (!halt && runControlFd >= 0 && time(NULL) - runControlLastPoll >= RUN_CONTROL_POLL_SECONDS)
+			halt = Util_Run_Control_Poll(bm);
+	} else
+		halt = Util_Run_Control_Poll(bm);
+#else
+	halt = Util_Run_Control_Poll(bm);
+#endif
+
+	if (halt)
+		printf("warning: Can't open %s file so ending the run\n", RUN_CONTROL_HALT_FILE);
+	return halt;
+}
+
+void Util_Run_Control_Free(void) {
+#ifndef _WIN32
+	signal(SIGUSR1, SIG_DFL);
+	signal(SIGTERM, SIG_DFL);
+#endif
+#ifdef __linux__
+	if (runControlFd >= 0)
+		close(runControlFd);
+#endif
+	runControlFd = -1;
+}
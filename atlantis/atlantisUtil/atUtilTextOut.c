@@ -0,0 +1,385 @@
+/**
+ * \ingroup atUtil
+ * \file atUtilTextOut.c
+ * \brief Buffered, asynchronous writing of the text diagnostic files.
+ *
+ * Util_TextOut_fopen returns an ordinary FILE *, so the existing fprintf based writers
+ * are unchanged, but on glibc the stream is a fopencookie stream. Output is collected
+ * in large per-file chunks, and full chunks are handed to a single background thread
+ * that does the actual writes, so the model does not wait on the filesystem. A chunk
+ * is also handed over once it is TEXTOUT_MAX_AGE seconds old, so the files still grow
+ * while a long run is going. Closing the stream waits for its data to be written.
+ *
+ * Util_TextOut_E is a fast replacement for fprintf(fp, " %e", value) for the large
+ * per value loops (diet and mortality output). It gives exactly the same text.
+ *
+ * Elsewhere (no fopencookie) the file is opened normally with a large stdio buffer.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sjwlib.h>
+#include <atlantisboxmodel.h>
+#include <atUtilLib.h>
+
+#ifdef __GLIBC__
+#include <pthread.h>
+#endif
+
+#define TEXTOUT_CHUNK (1 << 20)     /* Bytes collected before a write is queued */
+#define TEXTOUT_MAX_PENDING 64      /* Queued chunks (over all files) before writers wait */
+#define TEXTOUT_MAX_AGE 5           /* Seconds before a part full chunk is queued anyway */
+
+/* Range of decimal exponents handled by the fast %e path */
+#define TEXTOUT_MIN_EXP (-290)
+#define TEXTOUT_MAX_EXP 290
+
+static double textOutPow10[TEXTOUT_MAX_EXP - TEXTOUT_MIN_EXP + 7];
+static int textOutPow10Ready = FALSE;
+
+static void Util_TextOut_Init_Pow10(void) {
+	char str[16];
+	int i;
+
+	if (textOutPow10Ready)
+		return;
+	/* strtod gives the correctly rounded power for every exponent */
+	for (i = 0; i < TEXTOUT_MAX_EXP - TEXTOUT_MIN_EXP + 7; i++) {
+		sprintf(str, "1e%d", 6 - TEXTOUT_MAX_EXP + i);
+		textOutPow10[i] = strtod(str, NULL);
+	}
+	textOutPow10Ready = TRUE;
+}
+
+/* 10^(6 - exp10) */
+#define TEXTOUT_SCALE(exp10) (textOutPow10[TEXTOUT_MAX_EXP - (exp10)])
+
+/**
+ * \brief Format value as printf("%e") does, returning the length. str needs 32 chars.
+ *
+ * The value is scaled to seven significant digits in double precision. The scaling
+ * error is far below half a unit in the last digit, so the result only differs from
+ * correct rounding when the value is almost exactly half way between two outputs -
+ * those few cases (and zero, non finite and extreme values) go through snprintf.
+ */
+int Util_TextOut_Format_E(char *str, double value) {
+	double a, scaled, frac;
+	long digits;
+	int exp10, len = 0, e, i;
+	char tmp[8];
+
+	a = fabs(value);
+	if (!(a > 0) || !isfinite(a) || a < 1e-280 || a > 1e280)
+		return snprintf(str, 32, "%e", value);
+
+	if (!textOutPow10Ready)
+		Util_TextOut_Init_Pow10();
+
+	exp10 = (int) floor(log10(a));
+	scaled = a * TEXTOUT_SCALE(exp10);
+	/* log10 can be out by one either side of a power of ten */
+	if (scaled < 1e6) {
+		exp10--;
+		scaled = a * TEXTOUT_SCALE(exp10);
+	} else if (scaled >= 1e7) {
+		exp10++;
+		scaled = a * TEXTOUT_SCALE(exp10);
+	}
+
+	digits = (long) scaled;
+	frac = scaled - (double) digits;
+	if (fabs(frac - 0.5) < 1e-6)
+		return snprintf(str, 32, "%e", value);
+	if (frac > 0.5)
+		digits++;
+	if (digits >= 10000000) {
+		digits /= 10;
+		exp10++;
+	}
+
+	if (value < 0)
+		str[len++] = '-';
+	for (i = 6; i >= 0; i--) {
+		tmp[i] = (char) ('0' + digits % 10);
+		digits /= 10;
+	}
+	str[len++] = tmp[0];
+	str[len++] = '.';
+	memcpy(&str[len], &tmp[1], 6);
+	len += 6;
+
+	str[len++] = 'e';
+	str[len++] = (exp10 < 0) ? '-' : '+';
+	e = abs(exp10);
+	if (e >= 100)
+		str[len++] = (char) ('0' + e / 100);
+	str[len++] = (char) ('0' + (e / 10) % 10);
+	str[len++] = (char) ('0' + e % 10);
+	str[len] = '\0';
+
+	return len;
+}
+
+/**
+ * \brief Equivalent to fprintf(fp, " %e", value).
+ */
+void Util_TextOut_E(FILE *fp, double value) {
+	char str[40];
+	int len;
+
+	str[0] = ' ';
+	len = Util_TextOut_Format_E(&str[1], value);
+	fwrite(str, 1, (size_t) len + 1, fp);
+}
+
+#ifdef __GLIBC__
+
+typedef struct TextOutChunk TextOutChunk;
+typedef struct TextOutStream TextOutStream;
+
+struct TextOutChunk {
+	TextOutChunk *next;
+	TextOutStream *stream;
+	size_t size;
+	char *data;
+};
+
+struct TextOutStream {
+	TextOutStream *next; /* Open streams list */
+	FILE *fp;           /* The real file */
+	TextOutChunk *fill; /* Chunk being filled by the model */
+	time_t fillStart;
+	long bytes;         /* Bytes accepted so far (for ftell) */
+	int pending;        /* Chunks queued or being written */
+	int error;
+};
+
+static pthread_mutex_t textOutLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t textOutWork = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t textOutDone = PTHREAD_COND_INITIALIZER;
+static TextOutChunk *textOutHead = NULL, *textOutTail = NULL;
+static TextOutStream *textOutStreams = NULL;
+static int textOutPending = 0;
+static int textOutStarted = FALSE;
+static pthread_t textOutThread;
+
+static void *Util_TextOut_Writer(void *arg) {
+	TextOutChunk *chunk;
+	int failed;
+
+	for (;;) {
+		pthread_mutex_lock(&textOutLock);
+		while (textOutHead == NULL)
+			pthread_cond_wait(&textOutWork, &textOutLock);
+		chunk = textOutHead;
+		textOutHead = chunk->next;
+		if (textOutHead == NULL)
+			textOutTail = NULL;
+		pthread_mutex_unlock(&textOutLock);
+
+		failed = (fwrite(chunk->data, 1, chunk->size, chunk->stream->fp) != chunk->size);
+
+		pthread_mutex_lock(&textOutLock);
+		if (failed)
+			chunk->stream->error = TRUE;
+		chunk->stream->pending--;
+		textOutPending--;
+		pthread_cond_broadcast(&textOutDone);
+		pthread_mutex_unlock(&textOutLock);
+
+		free(chunk->data);
+		free(chunk);
+	}
+	return arg;
+}
+
+static TextOutChunk *Util_TextOut_New_Chunk(TextOutStream *stream) {
+	TextOutChunk *chunk = (TextOutChunk *) malloc(sizeof(TextOutChunk));
+
+	if (chunk == NULL)
+		return NULL;
+	chunk->data = (char *) malloc(TEXTOUT_CHUNK);
+	if (chunk->data == NULL) {
+		free(chunk);
+		return NULL;
+	}
+	chunk->next = NULL;
+	chunk->stream = stream;
+	chunk->size = 0;
+	stream->fillStart = time(NULL);
+	return chunk;
+}
+
+/**
+ * Queue the chunk being filled for the writer thread. Called with textOutLock held.
+ */
+static void Util_TextOut_Queue(TextOutStream *stream) {
+	TextOutChunk *chunk = stream->fill;
+
+	stream->fill = NULL;
+	if (chunk == NULL)
+		return;
+	if (chunk->size == 0) {
+		free(chunk->data);
+		free(chunk);
+		return;
+	}
+
+	while (textOutPending >= TEXTOUT_MAX_PENDING)
+		pthread_cond_wait(&textOutDone, &textOutLock);
+
+	if (textOutTail != NULL)
+		textOutTail->next = chunk;
+	else
+		textOutHead = chunk;
+	textOutTail = chunk;
+	stream->pending++;
+	textOutPending++;
+	pthread_cond_signal(&textOutWork);
+}
+
+/**
+ * Queue whatever the open streams hold and wait until it has all been written. Run
+ * at exit so that streams that are never closed still end up complete on disk.
+ */
+static void Util_TextOut_Drain(void) {
+	TextOutStream *stream;
+
+	fflush(NULL);
+	pthread_mutex_lock(&textOutLock);
+	for (stream = textOutStreams; stream != NULL; stream = stream->next)
+		Util_TextOut_Queue(stream);
+	while (textOutPending > 0)
+		pthread_cond_wait(&textOutDone, &textOutLock);
+	pthread_mutex_unlock(&textOutLock);
+}
+
+static ssize_t Util_TextOut_Write(void *cookie, const char *buf, size_t size) {
+	TextOutStream *stream = (TextOutStream *) cookie;
+	size_t done = 0, n;
+
+	pthread_mutex_lock(&textOutLock);
+	while (done < size) {
+		if (stream->fill == NULL)
+			stream->fill = Util_TextOut_New_Chunk(stream);
+		if (stream->fill == NULL) {
+			/* Out of memory - wait for the queue to clear and write directly */
+			while (stream->pending > 0)
+				pthread_cond_wait(&textOutDone, &textOutLock);
+			if (fwrite(buf + done, 1, size - done, stream->fp) != size - done)
+				stream->error = TRUE;
+			done = size;
+			break;
+		}
+		n = TEXTOUT_CHUNK - stream->fill->size;
+		if (n > size - done)
+			n = size - done;
+		memcpy(stream->fill->data + stream->fill->size, buf + done, n);
+		stream->fill->size += n;
+		done += n;
+		if (stream->fill->size == TEXTOUT_CHUNK)
+			Util_TextOut_Queue(stream);
+	}
+	if (stream->fill != NULL && time(NULL) - stream->fillStart >= TEXTOUT_MAX_AGE)
+		Util_TextOut_Queue(stream);
+	stream->bytes += (long) size;
+	pthread_mutex_unlock(&textOutLock);
+
+	return (ssize_t) size;
+}
+
+/**
+ * Only the current position can be asked for (so ftell works), the streams
+ * can't be repositioned.
+ */
+static int Util_TextOut_Seek(void *cookie, off64_t *offset, int whence) {
+	TextOutStream *stream = (TextOutStream *) cookie;
+
+	if (whence != SEEK_CUR || *offset != 0)
+		return -1;
+	pthread_mutex_lock(&textOutLock);
+	*offset = (off64_t) stream->bytes;
+	pthread_mutex_unlock(&textOutLock);
+	return 0;
+}
+
+static int Util_TextOut_Close(void *cookie) {
+	TextOutStream *stream = (TextOutStream *) cookie;
+	TextOutStream **link;
+	int result;
+
+	pthread_mutex_lock(&textOutLock);
+	Util_TextOut_Queue(stream);
+	while (stream->pending > 0)
+		pthread_cond_wait(&textOutDone, &textOutLock);
+	for (link = &textOutStreams; *link != NULL; link = &(*link)->next) {
+		if (*link == stream) {
+			*link = stream->next;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&textOutLock);
+
+	result = fclose(stream->fp);
+	if (stream->error)
+		result = EOF;
+	free(stream);
+
+	return result == 0 ? 0 : -1;
+}
+
+#endif
+
+/**
+ * \brief Open a text output file in the output folder for buffered, asynchronous writing.
+ *
+ * Returns NULL if the file can't be opened. Close with fclose (or Util_Close_Output_File).
+ */
+FILE *Util_TextOut_fopen(MSEBoxModel *bm, const char *name) {
+	FILE *fp;
+#ifdef __GLIBC__
+	cookie_io_functions_t functions;
+	TextOutStream *stream;
+	FILE *textfp;
+#endif
+
+	Util_TextOut_Init_Pow10();
+
+	if ((fp = Util_fopen(bm, name, "w")) == NULL)
+		return NULL;
+
+#ifdef __GLIBC__
+	pthread_mutex_lock(&textOutLock);
+	if (!textOutStarted) {
+		if (pthread_create(&textOutThread, NULL, Util_TextOut_Writer, NULL) == 0) {
+			pthread_detach(textOutThread);
+			atexit(Util_TextOut_Drain);
+			textOutStarted = TRUE;
+		}
+	}
+	pthread_mutex_unlock(&textOutLock);
+
+	if (textOutStarted && (stream = (TextOutStream *) calloc(1, sizeof(TextOutStream))) != NULL) {
+		stream->fp = fp;
+		functions.read = NULL;
+		functions.write = Util_TextOut_Write;
+		functions.seek = Util_TextOut_Seek;
+		functions.close = Util_TextOut_Close;
+		if ((textfp = fopencookie(stream, "w", functions)) != NULL) {
+			pthread_mutex_lock(&textOutLock);
+			stream->next = textOutStreams;
+			textOutStreams = stream;
+			pthread_mutex_unlock(&textOutLock);
+			return textfp;
+		}
+		free(stream);
+	}
+#endif
+
+	setvbuf(fp, NULL, _IOFBF, TEXTOUT_CHUNK);
+	return fp;
+}
@@ -48,6 +48,8 @@ typedef struct {
     double *WEIGHT;
     double *RBC;
     
+    double **SEL;       /* Selectivity per age and fleet, fixed for the duration of a projection */
+
     double *Fused;
     double *totavailB;
     double *SSB;
@@ -32,7 +32,6 @@ extern int do_CLAMLinkage;
 extern int not_tracking_flux;
 
 extern FILE *logfp;
-extern FILE *haltfp;
 
 extern int *groupEatOrder;
 extern int *groupMovementOrder;
@@ -79,11 +78,21 @@ void Util_Free(MSEBoxModel *bm);
 FILE *Util_fopen(MSEBoxModel *bm, const char *name, const char *mode);
 int Util_ncopen(const char *destFolder, const char* name ,int mode);
 
+/* Run control - halt file watch and signals */
+void Util_Run_Control_Init(MSEBoxModel *bm);
+int Util_Run_Control_Halt(MSEBoxModel *bm);
+void Util_Run_Control_Free(void);
+
+/* Buffered, asynchronous text output files */
+FILE *Util_TextOut_fopen(MSEBoxModel *bm, const char *name);
+int Util_TextOut_Format_E(char *str, double value);
+void Util_TextOut_E(FILE *fp, double value);
+
 /* General useage subroutine prototypes */
 double Util_Lognorm_Distrib(double mu, double sigma, double x_b);
-double Util_Logx_Result(double mu, double sigma);
+double Util_Logx_Result(MSEBoxModel *bm, double mu, double sigma);
 double Util_Mich_Ment(double x, double m);
-double Util_Normx_Result(double mu, double sigma);
+double Util_Normx_Result(MSEBoxModel *bm, double mu, double sigma);
 
 int Util_Read_Functional_Group_XML(MSEBoxModel *bm, char *fileName, FILE *llogfp);
 
@@ -148,4 +157,21 @@ int **Util_ReAlloc_2D_Int(int newdim1, int olddim1, int newdim2, int olddim2, in
 /* Utility functions */
 void Util_GenMnorm(double *vec, double *means, int *iseed, int np, double **tt, double *sg);
 double Util_xnorm(double mean, double sigg, int *iiseed);
+void Util_Cumulative_Probs(double *p, double *cumprob, int n);
+int Util_Sample_Cumulative(double *cumprob, int n, double u);
+
+/* Named counter based random number streams */
+void Util_Rand_Init(MSEBoxModel *bm);
+void Util_Rand_Stream_Init(RandStream *rs, unsigned int seed, int stream, unsigned int substream, unsigned int pass);
+double Util_Rand_Stream_Uniform(RandStream *rs);
+double Util_Rand_Counter_Uniform(unsigned int seed, int stream, unsigned int substream, unsigned int pass, unsigned long long counter);
+void Util_Rand_Jump(RandStream *rs, unsigned long long ndraws);
+double Util_Random(MSEBoxModel *bm, int stream, double min, double max);
+unsigned int Util_Rand_New_Pass(MSEBoxModel *bm, int stream);
+void Util_Rand_Substream(MSEBoxModel *bm, int stream, unsigned int pass, unsigned int id, RandStream *rs);
+double Util_Random_Substream(MSEBoxModel *bm, RandStream *rs, double min, double max);
 int Util_Check_NetCDF_Size(MSEBoxModel *bm, int fid, int *dump, char *fileName, int *index, int type);
+
+/* Threading helpers for the parallelised submodels */
+int Util_Get_Num_Threads(MSEBoxModel *bm);
+int Util_Get_Thread_Num(void);
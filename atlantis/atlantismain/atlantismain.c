@@ -180,7 +180,6 @@ static void checknetCDFFiles(MSEBoxModel *bm);
 void Util_Usage(int dummy);
 
 FILE *logfp;
-FILE *haltfp;
 
 double ***newwctr; /* new water column tracer */
 double ***newsedtr; /* new sediment tracer */
@@ -484,6 +483,9 @@ int runNextTimeStep(MSEBoxModel *bm){
             fflush(stderr);
         }
         
+        /* Work out which fisheries can take each group this timestep */
+        Harvest_Set_Active_Catch_Lists(bm);
+
         /* Do biological processes - step through biology for each box */
 		for (b = 0; b < bm->nbox; b++) {
 
@@ -590,13 +592,9 @@ int runNextTimeStep(MSEBoxModel *bm){
 	bm->t += bm->dt;
 	bm->nt++;
     
-	/* Check to see if can continue run or need to come to premature stop.
-	To do this check to see if can open dummy halt file in current directory */
-	if( (haltfp=Util_fopen(bm, "delete_to_halt_run","r")) == NULL ){
-		printf("warning: Can't open delete_to_halt_run file so ending the run\n");
-		halt = 1;
-	} else
-		fclose(haltfp);
+	/* Check to see if can continue run or need to come to premature stop -
+	 the halt file has been deleted or the run has been signalled (see atUtilRunControl.c) */
+	halt = Util_Run_Control_Halt(bm);
 
 	logfp = checkLogFileSize(logfp, bm);
 	/* Only check netcdf file size every 5 days */
@@ -628,11 +626,6 @@ int main(int argc, char *argv[]) {
 		quit("logfp is null\n");
 	}
 
-#if 0
-	/* Set signal to allow clean up on SIGTERM */
-	signal(SIGTERM,setkill);
-#endif
-
 	/* Allocate memory for new values at each time step */
 	/* Need to keep these */
 	newwctr = (double ***) alloc3d(bm.ntracer, bm.wcnz, bm.nbox);
@@ -661,15 +654,8 @@ int main(int argc, char *argv[]) {
     
 #endif
     
-    /* First check to see if can continue run or need to come to premature stop.
-	 To do this check to see if can open dummy halt file in current directory */
-	if ((haltfp = Util_fopen(&bm, "delete_to_halt_run", "r")) == NULL) {
-		printf("warning: Can't open delete_to_halt_run file so ending the run\n");
-		halt = 1;
-	} else {
-		halt = 0;
-		fclose(haltfp);
-	}
+    /* First check to see if can continue run or need to come to premature stop */
+	halt = Util_Run_Control_Halt(&bm);
 	if(do_BrokerLinkage){
 #ifdef BROKER_LINK_ENABLED
 		/* If we are linking to the broker then we wait for the broker to tell us to start */
@@ -678,6 +664,10 @@ int main(int argc, char *argv[]) {
 		quit("You are trying to link to the broker but you must compile the code with the '--with-brokerlink' flag\n");
 #endif
 	} else {
+		/* Start watching for the halt file to be removed or a SIGUSR1/SIGTERM. Only done
+		 * now so a signal during setup still stops the run straight away */
+		Util_Run_Control_Init(&bm);
+
 		/* Loop for each time step */
 		while (!killed && (bm.t < bm.tstop) && !halt) {
 			halt = runNextTimeStep(&bm);
@@ -757,6 +747,8 @@ int main(int argc, char *argv[]) {
 	/* Write out final comments to log and text files (so have summary of system state) */
 	Textfile_Dump(&bm, logfp);
 
+	Util_Run_Control_Free();
+
 	/* Close the log file */
 	fclose(logfp);
 
@@ -784,7 +776,6 @@ void setupMSEBoxModel(int argc, char *argv[], MSEBoxModel *bm) {
 	char commandTempStr[STRLEN];
 
 	logfp = NULL;
-	haltfp = NULL;
 
 #ifdef _STUDIO
 	_CrtSetDbgFlag(_CRTDBG_CHECK_ALWAYS_DF);
@@ -2131,6 +2122,10 @@ FILE * initLogFile(MSEBoxModel *bm) {
  *
  * \brief Check the size of the log file. If its too big create a now one.
  *
+ *	The size is the number of bytes written through the log stream (its position, as
+ *	the file is opened for writing from the start), so no call to the filesystem is
+ *	needed. stat is only used if the stream can't report its position.
+ *
  *	This is critical code - can't be multithreaded.
  *
  */
@@ -2139,16 +2134,21 @@ FILE *checkLogFileSize(FILE *llogfp, MSEBoxModel *bm) {
 	struct stat buffer;
 	FILE *fp;
 	char fname[STRLEN];
+	long logBytes;
 
-	sprintf(fname, "%s%s", bm->destFolder, bm->logFileName);
+	logBytes = ftell(llogfp);
+	if (logBytes < 0) {
+		sprintf(fname, "%s%s", bm->destFolder, bm->logFileName);
 
-	/* Might need to close the file and then open it after we have checked its size */
-	/* Check the size of the diff file. */
-	if(stat(fname, &buffer) < 0){
-		quit("Unable to get information about file %s\n", fname);
+		/* Check the size of the log file. */
+		if(stat(fname, &buffer) < 0){
+			quit("Unable to get information about file %s\n", fname);
+		}
+		logBytes = (long) buffer.st_size;
 	}
 
-	if (buffer.st_size > MAX_LOG_FILE_SIZE) {
+	/* Might need to close the file and then open it after we have checked its size */
+	if (logBytes > MAX_LOG_FILE_SIZE) {
 
 		fflush(llogfp);
 		fclose(llogfp);
@@ -2234,6 +2234,10 @@ void modelshutdown(MSEBoxModel *bm) {
 
         free(bm->boxes[b].distID);
     }
+    free2d(bm->box_dist);
+    i_free1d(bm->adj_start);
+    i_free1d(bm->adj_box);
+    free1d(bm->adj_dist);
 
 	/* Free Memory for top level boxmodel arrays */
     i_free1d((int*) bm->is_boundary);
@@ -629,6 +629,7 @@ typedef enum {
 #define humped_griffith_q10_id 1
 #define Heinichen_q10_id 2
 #define CEATTLE_q10_id 3
+#define num_q10_methods 4
 
 /* Temperature effects on efficiency */
 #define no_effect 0
@@ -2955,6 +2956,7 @@ typedef struct {
     // SS relevant parameters
     int UseAtlantisPGMSY; /* Flag to indicate whether to use Atlantis version of PGMSY */
     int UseSS;	         /* Flag indicating whether using SS for Tier 1 (1) or if using perfect info + error (0) */
+    int SS3BinaryDump;   /* Flag indicating whether to also write the generated SS3 data as compact binary files each year */
     int UseTierBuffers;  /* Flag indicating whether using tier buffers (used to say US tiers) */
     double myTACbuffer;  /* Buffer used for myTAC multi-year TACs in subsequent years */
     int myTACperiod;     /* Length of myTAC */
@@ -3107,6 +3109,22 @@ typedef struct {
 
     double ***samp_prop_to;  // size MaxAge, years, Nsexes
 
+    /* CKsimulator work arrays - allocated on the first call and reused (reset) on later calls */
+    double *nsamps_y;            // size years
+    double ***nsamps_sya;        // size Nsexes, years, MaxAge
+    double *x;                   // size MaxAge
+    double *sx;                  // size Nsexes
+    double **inv_totfec_sy;      // size Nsexes, years
+    double ***n_sya;             // size Nsexes, years, MaxAge + 1 (plus group)
+    double ****psurv_syay;       // size Nsexes, years, MaxAge + 1, years
+    double *****Pr_PO_syaya;     // size Nsexes, years, MaxAge, years, MaxAge
+    double *****Pr_HS_syaya;     // size Nsexes, years, MaxAge, years, MaxAge
+    double ****Pr_HS_yaya;       // size years, MaxAge, years, MaxAge
+    double *****ncomps_PO_syaya; // size Nsexes, years, MaxAge, years, MaxAge
+    double ****ncomps_HS_yaya;   // size years, MaxAge, years, MaxAge
+    double *****sim_nkin_PO;     // size Nsexes, years, MaxAge, years, MaxAge
+    double *****sim_nkin_HS;     // size Nsexes, years, MaxAge, years, MaxAge
+
 } CloseKinstructure;
 /*******************************************************************//**
  The fisheries information structure - kept separate from FstatInfo and
@@ -4023,6 +4041,62 @@ typedef struct {
 #define simple_industry_model 1
 #define dyn_industry_model 2
 
+/* Named random number streams - each subsystem draws from its own stream (see atUtilRandom.c) */
+typedef enum {
+	rand_ecology_id = 0,
+	rand_recruit_id,
+	rand_survey_id,
+	rand_assess_id,
+	rand_closekin_id,
+	rand_manage_id,
+	rand_econ_id,
+	num_rand_streams
+} RAND_STREAMS;
+
+/**
+ * A counter based random number stream - the next value is a function of the key, substream, pass and ndraws only.
+ * The shared streams in bm must not be drawn from inside a threaded loop - use a keyed substream (Util_Rand_Substream) there.
+ */
+typedef struct {
+	unsigned int key[2]; /**< Run seed and stream id */
+	unsigned int substream; /**< 0 for the shared stream, box (or thread) id + 1 for a keyed substream */
+	unsigned int pass; /**< Pass of the stream the substream belongs to */
+	unsigned int npass; /**< Number of passes started from this (shared) stream */
+	unsigned long long ndraws; /**< Number of values drawn (or jumped) so far */
+} RandStream;
+
+/**
+ * Working arrays for the classical (Schaefer and VPA) assessment fits. The objective function
+ * reaches these through its FunkArgs, so a fit only touches the workspace it is handed.
+ * Values carry over between fits (and assessment years) exactly as the old file scope arrays did.
+ */
+typedef struct {
+	double SSmin; /**< Smallest sum of squares found for the current species */
+
+	double **CData; /**< Observed catch at age [yr][age] */
+	double **IData; /**< Observed cpue at age [yr][age] */
+	double **IDatahat; /**< Fitted cpue at age [yr][age] */
+	double *CTData; /**< Observed total catch [yr] (allocated per production model fit) */
+	double *ITData; /**< Observed total cpue [yr] (allocated per production model fit) */
+	double **CPUEtrend; /**< Cpue series per species [sp][yr] */
+
+	double **NEst; /**< Estimated numbers (VPA) or production model parameters and states [yr][id] */
+	double **F; /**< Estimated fishing mortality at age [yr][age] */
+	double **Resu; /**< Residuals of the fit [yr][age] */
+
+	double **P; /**< Simplex vertices */
+	double *X; /**< Trial point */
+	double *Y; /**< Objective value at each vertex */
+	double **PP; /**< Simplex vertices for the catchability regression */
+	double *XX; /**< Trial point for the catchability regression */
+	double *YY; /**< Objective value at each regression vertex */
+
+	double *BootResu; /**< Pooled residuals to resample when bootstrapping */
+	double ***NResult; /**< Estimates per bootstrap run [yr][id][nbs] */
+	double *ResultToSort; /**< Bootstrap estimates to sort for the percentiles */
+	double *ResultSorted; /**< Sorted bootstrap estimates */
+} AssessFitStruct;
+
 /*******************************************************************//**
  The Box Model structure
  *********************************************************************/
@@ -4141,6 +4215,11 @@ typedef struct {
 	polyline *bnd; /* boundary of the model */
 	Box *boxes; /* array of boxes */
 	Face *faces; /* array of open faces */
+	/* Box connectivity - built once when the geometry is read in (see Build_Box_Graph() in atgeomIO.c) */
+	int *adj_start; /* Index of the first neighbour of each box in adj_box and adj_dist (nbox + 1 entries, compressed sparse row layout) */
+	int *adj_box; /* Ids of the unique adjacent boxes of each box */
+	double *adj_dist; /* Distance between the centre of each box and the centre of each of its adjacent boxes */
+	double **box_dist; /* Distance between the centres of every pair of boxes */
 	MapProjection *projection; /* Information about the model projection */
 
 	/* Run parameters */
@@ -4212,6 +4291,7 @@ typedef struct {
 	int horiz_diffusion; /**< Horizontal diffusion switch */
 	int vert_diffusion; /**< Vertical diffusion switch */
 	int vert_mix; /**< Forced vertical mixing switch */
+	int vert_mix_implicit; /**< Solve forced vertical mixing implicitly (1) rather than by explicit slab mixing (0) */
 	int advect_diffusion;/**< Transport model (advection diffusion) switch */
     int fill_zero_exchange; /**< Whether patching holes in advection model with horiz_diffusion */
     double flush_threshold; /**< Theshold number of days without fluxes before force horizontal diffusion */
@@ -4308,6 +4388,9 @@ typedef struct {
 	int flagannual_Mest; /**< Flag checking whether mortality per predator outputs only annually
 	 - its useful to do it less than annually if calibrating */
 	int fishmove; /**< Flag turning fish movement on/off */
+	int nthreads; /**< Number of threads used by the parallelised submodels (only used if built with --enable-openmp) */
+	int rand_seed; /**< Seed of the named random number streams - 0 keeps the original drandom() sequence */
+	RandStream randStreams[num_rand_streams]; /**< Named random number streams, one per subsystem */
 	int which_fleet; /**< Flag indicating which fleet to track fluxes for */
 	int which_check; /**< Flag indicating which group to track fluxes for */
 	HABITAT_TYPES habitat_check; /**< Flag indicating which habitat to track fluxes in */
@@ -4327,6 +4410,8 @@ typedef struct {
      initial conditions */
     int flagagecheck; /**< Flag check age structure when reporting on size of vertebrates (flagchecksize) */
     int flagdietcheck; /**< Flag indicating whether want to output detailed diets */
+    int flagdietoutput; /**< Flag indicating whether to track diets and write DietCheck.txt (on unless turned off) */
+    int flagmortoutput; /**< Flag indicating whether to write the mortality estimate text files (on unless turned off) */
     int flagenviro_warn; /**< Flag indicating that whether want earnings anout environmental constraints on movement recorded to the logfile */
     int flagenviro_displace; /**< Flag indicating whether environment displaces the species or allows it to disappear */
     int flagenviro_kill; /**< Flag indicating whether environment displaces the species or allows it to disappear */
@@ -5302,6 +5387,7 @@ typedef struct {
     double **alloced_discard;   /**< Discard in each box for each species already allocated in ShotData */
     double *prop_depth;     /**< Proportional remaining catch at each depth - for allocating shot */
     double *prop_effort;     /**< Proportional remaining effort in each box - for allocating shot */
+    double *cum_effort;      /**< Cumulative proportional effort over the boxes - for locating shots */
     double ***ShotData;     /**< Final generated shot by shot data - written over for each fishery 
                              at each time step, so needs to be written out as soon as generated */
     
@@ -5415,6 +5501,7 @@ typedef struct {
 	double *estinitpop; /**< Estimated virgin biomass */
 
 	char **NAssessNAME; /**< name of estimated assessment parameters and variables */
+	AssessFitStruct *assessFit; /**< Working arrays for the classical assessment fits */
 
 	double Assess_Tol; /**< Fractional convergence tolerance of minimisation
 	 routine (Amoeba) for assessments */
@@ -5850,13 +5937,16 @@ void Harvest_Free_Time_Series(FisheryTimeSeries *fts, int nnts);
 // Used to be in atsample.h but put here as also called from atManageTier
 // (for the downhill_simplex component of that code)
 double Assess_Add_Error(MSEBoxModel *bm, int er_case, double true_val, double a, double v);
-double Funk(MSEBoxModel *bm, int funkflag, int sp, int nchrt, int ndim, int YrMax, double prm_sp, double *X, FILE *ofp, double *xpar);
 double EquilF_Funk(MSEBoxModel *bm, int species, double *xpar, FILE *llogfp);
 double SurplusProduction(MSEBoxModel *bm, int species, double *xpar, FILE *llogfp);
 
-void Amoeba(MSEBoxModel *bm, int assessing, int sp, double dayt, char* speciesname, double **p, double *y, int ndim, double ftol, int itmax, int funkflag, int nchrt, int YrMax,
-		double prm_sp, int *nfunk, int *ilow, FILE *ofp, double *xpar);
-void powell(MSEBoxModel *bm, int sp, double *xf, double **xunit, int npar, double ftol, int *iter, double *ss, int funkflag);
+/* Reentrant simplex search - objectives get their state through the userdata pointer */
+typedef double (*SolveObjective)(double *x, int ndim, void *userdata);
+int Solve_Simplex(double **p, double *y, int ndim, double ftol, int itmax, SolveObjective funk, void *userdata, int *nfunk, int *ilow);
+void Solve_Evaluate_Points(double **p, double *y, int npts, int ndim, SolveObjective funk, void **userdata, int nthreads);
+int Solve_Simplex_Multistart(double ***p, double **y, int nstart, int ndim, double ftol, int itmax, SolveObjective funk, void **userdata,
+		int nthreads, int *nfunk, int *ilow, int *converged);
+int Solve_Powell(double *p, double **xi, int ndim, double ftol, int itmax, SolveObjective funk, void *userdata, int *iter, double *fret);
 
 
 /* Economics related prototypes */
@@ -5881,6 +5971,7 @@ FILE * initDynTier4CTLFile(MSEBoxModel *bm);
 /* RAssess related */
 void RRAssess_Linkage_Start(MSEBoxModel *bm);
 void Do_RAssess(MSEBoxModel *bm, int species, int year, FILE *llogfp);
+void Run_RAssess_All(MSEBoxModel *bm, int year, FILE *llogfp);
 int freeRRAssess();
 
 /* Redus management related prototypes */
@@ -5891,8 +5982,10 @@ void RAssessSurvey(MSEBoxModel *bm, FILE *llogfp);
 #endif
 
 void CKsimulator(MSEBoxModel *bm, int sp, int year);
+void CKsimulator_Free(MSEBoxModel *bm, int sp);
 void GenData(MSEBoxModel *bm, int groupIndex, int yearIndex);
 void WriteSS330Files(MSEBoxModel *bm, int sp, int maxyr, char *baseFolder, char *fileName);
+void Write_SS3_Binary_Data(MSEBoxModel *bm, int year);
 void WriteSSCtl(MSEBoxModel *bm, FILE *fid, int sp, int maxyr);
 void WriteSSFor(MSEBoxModel *bm, FILE *fid, int sp, int maxyr);
 
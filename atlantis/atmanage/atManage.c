@@ -61,7 +61,7 @@ static double Effort_Restrict_Check(MSEBoxModel *bm, int fishery_id, int flagman
 static double Endangered_Check(MSEBoxModel *bm, int fishery_id, double EFF_scale1, int *end_trigger_tripped, FILE *llogfp);
 static void Check_For_Active_MPA(MSEBoxModel *bm, int fishery_id);
 static double Forced_Effort_Change(MSEBoxModel *bm, int fishery_id, int flagspeffortmodel, FILE *llogfp);
-static double Season_Check(MSEBoxModel *bm, int fishery_id, int ij, FILE *llogfp);
+static double Season_Check(MSEBoxModel *bm, int fishery_id, FILE *llogfp);
 static double Allocate_Immediate_Effort(MSEBoxModel *bm, int fishery_id, int ij, int flagspeffortmodel, double prop_pop_fish, FILE *llogfp);
 
 static void Effort_Displacement(MSEBoxModel *bm, int fishery_id, int ij, double orig_FCpressure, double *FCpressure, double *FCdisplaced, int *new_fish_loc,
@@ -71,6 +71,7 @@ static void Check_CAP(MSEBoxModel *bm, FILE *llogfp);
 static void Calculate_Port_Contrib(MSEBoxModel *bm, int fishery_id, int flagspeffortmodel, FILE *llogfp);
 static void Update_Port_Population(MSEBoxModel *bm, FILE *llogfp);
 static void GenerateCPUE(MSEBoxModel *bm, FILE *llogfp);
+static int Find_Shot_Location(double *cum_effort, int nbox, double u);
 static void allocate_catch(MSEBoxModel *bm, int sp, int nf, int ij, int k, double *catch_unalloced, double *weighted_depth, double this_catch, FILE *llogfp);
 
 int POP_max_num_changes,
@@ -83,7 +84,7 @@ double k_proprecfish;
  * are carried out in Annual_Fisheries_Mgmt()
  */
 void Manage_Calculate_Total_Effort(MSEBoxModel *bm, FILE *llogfp) {
-	double EFF_scale1 = 0.0, EFF_scale2 = 0.0, EFF_scale3 = 0.0, EFF_scale4, FCpressure, orig_FCpressure, fish_infringe, FCdisplaced, prop_pop_fish = 0.0, localcell_vol, FC_likeREEF, FC_likeFLAT, FC_likeSOFT, FC_dempel, reef_area, flat_area, soft_area, otherFC_likeREEF, otherFC_likeFLAT, totconflict, otherFC_likeSOFT, otherFC_dempel, dempel_match, K_GearConflict, conflict_contrib, active_scale, step1_cpue, totcatch, dummy, mpa_scale, mpa_infringe, F_displaced, F_rescale;
+	double EFF_scale1 = 0.0, EFF_scale2 = 0.0, EFF_scale3 = 0.0, EFF_scale4, FCpressure, orig_FCpressure, fish_infringe, FCdisplaced, prop_pop_fish = 0.0, FC_likeREEF, FC_likeFLAT, FC_likeSOFT, FC_dempel, reef_area, flat_area, soft_area, otherFC_likeREEF, otherFC_likeFLAT, totconflict, otherFC_likeSOFT, otherFC_dempel, dempel_match, K_GearConflict, conflict_contrib, active_scale, step1_cpue, totcatch, dummy, mpa_scale, mpa_infringe, F_displaced, F_rescale;
 	int ij, k, sp, nf, flagspeffortmodel, fishery_id, flagmanage, end_trigger_tripped, new_fish_loc = 0, nstock, flagfcmpa,
     crunch_id;
     //int do_debug_nf;
@@ -91,6 +92,7 @@ void Manage_Calculate_Total_Effort(MSEBoxModel *bm, FILE *llogfp) {
 	int ncells = bm->nbox;
 	//double record_period = (bm->t - (bm->tfishout - bm->toutfinc)) + 1;
 	double EFF_scale0 = 0.0;
+	double season_scale = 1.0;
 	int trigger_tripped;
 
     /*
@@ -275,14 +277,6 @@ void Manage_Calculate_Total_Effort(MSEBoxModel *bm, FILE *llogfp) {
 					step1_cpue = 0.0;
 					for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
 						if (FunctGroupArray[sp].isFished == TRUE) {
-
-							localcell_vol = 0;
-							for (k = 0; k < bm->boxes[ij].nz; k++) {
-								localcell_vol += bm->boxes[ij].dz[k] * ceil(Effort_vdistrib[ij][k][nf]);
-							}
-							localcell_vol *= bm->boxes[ij].area;
-
-							//step1_cpue += ((bm->boxes[ij].fishstat[catid] / (localcell_vol + small_num)) / record_period);
 							if (bm->FISHERYprms[nf][flaguseall_id]) {
 								step1_cpue += bm->LastCatch[sp][nf][ij];
 							} else {
@@ -394,6 +388,10 @@ void Manage_Calculate_Total_Effort(MSEBoxModel *bm, FILE *llogfp) {
             /* If general change in fishing pressure through time (gradual change) calculate
 			 new levels here. */
 			EFF_scale3 = Forced_Effort_Change(bm, fishery_id, flagspeffortmodel, llogfp);
+
+            /* Seasonal closures - whether the season is open only depends on the time of year so
+             is worked out once here, the regions that don't use the season are dealt with per box below */
+            season_scale = Season_Check(bm, fishery_id, llogfp);
             
             /* If recreational fishery determine human population actually fishing */
             if(FisheryArray[fishery_id].isRec) {
@@ -425,7 +423,10 @@ void Manage_Calculate_Total_Effort(MSEBoxModel *bm, FILE *llogfp) {
 					FCpressure = Allocate_Immediate_Effort(bm, fishery_id, ij, flagspeffortmodel, prop_pop_fish, llogfp);
 
 					/* Seasonal closures */
-					EFF_scale4 = Season_Check(bm, fishery_id, ij, llogfp);
+					if ((bm->K_num_active_reg > 1) && !bm->reg_season[bm->regID[ij]])
+						EFF_scale4 = 1.0;
+					else
+						EFF_scale4 = season_scale;
 
 					/* Adjust based on spatially independent effort management (or changes) above */
 					FCpressure = EFF_scale0 * EFF_scale1 * EFF_scale2 * EFF_scale3 * EFF_scale4 * FCpressure;
@@ -1324,22 +1325,18 @@ double Forced_Effort_Change(MSEBoxModel *bm, int fishery_id, int flagspeffortmod
 /**
  * \brief Seasonal fisheries checking
  *
+ *	Regions that don't use the season (reg_season) are left open by the caller.
+ *
  *	@return Returns a scalar to adjust realised effort to take into account seasonal issues
  */
-double Season_Check(MSEBoxModel *bm, int fishery_id, int ij, FILE *llogfp) {
-	int flagseasonal, nreg, use_reg;
+double Season_Check(MSEBoxModel *bm, int fishery_id, FILE *llogfp) {
+	int flagseasonal;
 	double fishstartday, fishendday;
 	double EFF_scale4 = 1.0;
 
 	flagseasonal = (int) (bm->FISHERYprms[fishery_id][flagseasonal_id]);
 
-	if (bm->K_num_active_reg > 1) {
-		nreg = bm->regID[ij];
-		use_reg = bm->reg_season[nreg];
-	} else
-		use_reg = 1;
-
-	if (flagseasonal && use_reg) {
+	if (flagseasonal) {
 		fishstartday = SEASONAL[fishery_id][0];
 		fishendday = SEASONAL[fishery_id][1];
 		if (fishstartday < fishendday) {
@@ -2227,7 +2224,7 @@ void Update_Port_Population(MSEBoxModel *bm, FILE *llogfp) {
  */
 void Calculate_Port_Contrib(MSEBoxModel *bm, int fishery_id, int flagspeffortmodel, FILE *llogfp) {
 	int porti, b, flagfishhere, peak_effort, peak_cpue_port;
-	double CPUE_and_port, max_effort, max_cpue_port, step1, xdiff, ydiff, port_bit, cpue_bit, newport;
+	double CPUE_and_port, max_effort, max_cpue_port, port_bit, cpue_bit, newport;
 	double mEffscale = bm->FISHERYprms[fishery_id][mFCscale_id];
 
 	bm->totPortContrib[fishery_id][simple_id] = 0.0;
@@ -2324,11 +2321,8 @@ void Calculate_Port_Contrib(MSEBoxModel *bm, int fishery_id, int flagspeffortmod
 		}
 		bm->totPortContrib[fishery_id][compound_id] = CPUE_and_port;
 
-		/* Calculate peak distance */
-		xdiff = fabs(bm->boxes[peak_effort].inside.x - bm->boxes[peak_cpue_port].inside.x);
-		ydiff = fabs(bm->boxes[peak_effort].inside.y - bm->boxes[peak_cpue_port].inside.y);
-		step1 = xdiff * xdiff + ydiff * ydiff;
-		DistPeak[fishery_id] = sqrt(step1);
+		/* Peak distance - box centre distances are stored when the geometry is read in */
+		DistPeak[fishery_id] = bm->box_dist[peak_effort][peak_cpue_port];
 	}
 
 	return;
@@ -2643,7 +2637,7 @@ void GenerateCPUE(MSEBoxModel *bm, FILE *llogfp) {
     int sp, nf, ij, k, ns, this_shot, nc, just_spotted, this_gun, this_catchbin;
     double tot_nboat, tot_hold, shotcount, step1, max_prob, weighted_depth, catch_unalloced, final_shot_catch, abscatch, x,
         min_shots, max_shots, tot_effort, sum_prob, effort_contrib, tot_effort_contrib, this_catch, catch_left, this_discards,
-        prop_discard, min_catch, max_catch, diff_Catch, final_shot_discards, min_effort, this_effort, final_shot_effort, totC;
+        prop_discard, min_catch, max_catch, diff_Catch, final_shot_discards, min_effort, this_effort, final_shot_effort, totC, catch_kg;
     double hr_per_dt = (bm->dt / 86400) * 24.0;  // So converting dt in to per day rate and then multiple by 24 to see number of hours.
     int num_shots_per_day = (int)(ceil(24 / bm->K_min_shotlength));
     int max_poss_shots = bm->K_max_num_subfleet * bm->K_max_num_boats * num_shots_per_day + bm->nbox + 1;
@@ -2665,7 +2659,6 @@ void GenerateCPUE(MSEBoxModel *bm, FILE *llogfp) {
                     Also find min and max number of potential shots per day possible given number of boats, fishable time and
                     minimum down time
                 */
-                Util_Init_3D_Double(bm->ShotData, max_poss_shots, bm->K_num_tot_sp, K_num_shot_data_entries, 0.0);
                 Util_Init_1D_Int(bm->box_done, bm->nbox, 0);
                 Util_Init_1D_Double(bm->alloced_effort, bm->nbox, 0.0);
                 Util_Init_3D_Double(bm->alloced_catch, bm->K_num_tot_sp, bm->nbox, bm->wcnz, 0.0);
@@ -2690,11 +2683,11 @@ void GenerateCPUE(MSEBoxModel *bm, FILE *llogfp) {
                 // Find number of shots to take
                 if (min_shots > max_shots)
                     max_shots = min_shots;
-                step1 = drandom(0.0, min_shots);  // As getting too many shots so reset starting point a bit lower
+                step1 = Util_Random(bm, rand_manage_id, 0.0, min_shots);  // As getting too many shots so reset starting point a bit lower
                 min_shots = step1;
                 shotcount = ceil(max_shots - min_shots);
                 if(shotcount)
-                    step1 = drandom(0.0, shotcount);
+                    step1 = Util_Random(bm, rand_manage_id, 0.0, shotcount);
                 step1 += min_shots;
                 nshot = (int)ceil(step1);
                 
@@ -2706,24 +2699,23 @@ void GenerateCPUE(MSEBoxModel *bm, FILE *llogfp) {
                     bm->prop_effort[ij] += bm->Effort_hdistrib[ij][nf][today_effort];
                     tot_effort += bm->Effort_hdistrib[ij][nf][today_effort];
                 }
+                sum_prob = 0.0;
                 for (ij = 0; ij < bm->nbox; ij++) {
                     bm->prop_effort[ij] /= (tot_effort + small_num);
+                    sum_prob += bm->prop_effort[ij];
+                    bm->cum_effort[ij] = sum_prob;
                 }
                 
+                /* Locate each shot by bisection on the cumulative effort (if the draw is past the total redraw) */
                 this_shot = 0;
                 max_prob = 1.0;
-                Util_Init_1D_Int(bm->shot_loc, max_poss_shots, 0);
                 while (this_shot < nshot) {
-                    step1 = drandom(0.0, max_prob);
-                    sum_prob = 0.0;
-                    for (ij = 0; ij < bm->nbox; ij++) {
-                        sum_prob += bm->prop_effort[ij];
-                        if (step1 <= sum_prob) {
-                            bm->shot_loc[this_shot] = ij;
-                            bm->box_done[ij] = 1;
-                            this_shot++;
-                            break;
-                        }
+                    step1 = Util_Random(bm, rand_manage_id, 0.0, max_prob);
+                    ij = Find_Shot_Location(bm->cum_effort, bm->nbox, step1);
+                    if (ij >= 0) {
+                        bm->shot_loc[this_shot] = ij;
+                        bm->box_done[ij] = 1;
+                        this_shot++;
                     }
                 }
                 // Make sure all the boxes with catch are included - if not pad out the list now
@@ -2747,6 +2739,9 @@ void GenerateCPUE(MSEBoxModel *bm, FILE *llogfp) {
                     }
                 }
                 
+                /* Only the shots taken (and the left overs entry after them) are used so only clear those */
+                Util_Init_3D_Double(bm->ShotData, min(nshot + 1, max_poss_shots), bm->K_num_tot_sp, K_num_shot_data_entries, 0.0);
+
                 /* Get catch and effort */
                 this_shot = 0;
                 while (this_shot < nshot) {
@@ -2767,7 +2762,7 @@ void GenerateCPUE(MSEBoxModel *bm, FILE *llogfp) {
                             effort_contrib += bm->SpatialBlackBook[nf][ns][bm->MofY][ij][current_id];
                     }
                     effort_contrib /= (tot_effort_contrib + small_num);
-                    step1 = drandom(0.0, 1.0);
+                    step1 = Util_Random(bm, rand_manage_id, 0.0, 1.0);
                     if (step1 < effort_contrib)  // Drawn someone who is not a gun skipper
                         this_gun = 0;
                     else                        // Gun skipper picked
@@ -2806,7 +2801,7 @@ void GenerateCPUE(MSEBoxModel *bm, FILE *llogfp) {
                         prop_discard = this_discards / (this_catch + small_num);
                         
                         // Now get the size of the catch - draw from a negative bionomial
-                        step1 = drandom(0.0, 1.0);
+                        step1 = Util_Random(bm, rand_manage_id, 0.0, 1.0);
                         sum_prob = 0.0;
                         this_catchbin = 0;
                         for (nc = 0; nc < bm->K_num_catchbin; nc++){
@@ -2824,7 +2819,7 @@ void GenerateCPUE(MSEBoxModel *bm, FILE *llogfp) {
                             min_catch = 0.0;
                         max_catch = this_catchbin * bm->size_catchbin;
                         diff_Catch = max_catch - min_catch;
-                        step1 = drandom(0.0, diff_Catch);
+                        step1 = Util_Random(bm, rand_manage_id, 0.0, diff_Catch);
                         final_shot_catch = step1 + min_catch;
                         if(final_shot_catch > this_catch)
                             final_shot_catch = this_catch;
@@ -2852,7 +2847,7 @@ void GenerateCPUE(MSEBoxModel *bm, FILE *llogfp) {
                         // Start with random allocation
                         numstep = 0;
                         while ((catch_unalloced > 0.0) && (numstep < step_tolerance)) {
-                            step1 = drandom(0.0, 1.0);
+                            step1 = Util_Random(bm, rand_manage_id, 0.0, 1.0);
                             for (k = 0; k < bm->boxes[ij].nz; k++) {
                                 sum_prob += bm->prop_depth[k];
                                 if (step1 < sum_prob) {
@@ -2921,34 +2916,31 @@ void GenerateCPUE(MSEBoxModel *bm, FILE *llogfp) {
 
                 }
             
-                /* Get the left overs */
-                if(bm->flagfullCPUEreport){
-                    for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
-                        weighted_depth = 0.0;
-                        bm->ShotData[this_shot][sp][tcatch_id] = 0.0;
-                        for (ij=0; ij < bm->nbox; ij++) {
-                            bm->ShotData[this_shot][sp][tloc_id] = ij;
-                            bm->ShotData[this_shot][sp][teffort_id] += ((bm->Effort_hdistrib[ij][nf][today_effort] / 24.0 ) - bm->alloced_effort[ij]);
-                            for (k = 0; k < bm->boxes[ij].nz; k++) {
-                                bm->ShotData[this_shot][sp][wdepth_id] += (bm->Catch[ij][sp][nf][k] * bm->X_CN * mg_2_kg) - bm->alloced_catch[sp][ij][k];
-                                bm->ShotData[this_shot][sp][tcatch_id] += (bm->Catch[ij][sp][nf][k] * bm->X_CN * mg_2_kg) - bm->alloced_catch[sp][ij][k];
-                                bm->ShotData[this_shot][sp][tdiscard_id] += (bm->Discards[ij][sp][nf] * bm->X_CN * mg_2_kg) - bm->alloced_discard[sp][ij];
-                            }
-                        }
-                        bm->ShotData[this_shot][sp][wdepth_id] /= (bm->ShotData[this_shot][sp][tcatch_id] + small_num);
-                    }
-                }
-                
-                /* Find amount allocated overall for repoprting purposes */
+                /* Get the left overs and the amount allocated overall for reporting purposes
+                 - both from the one pass over the catch */
                 for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
                     tot_alloced[sp] = 0.0;
                     totC = 0.0;
+                    if(bm->flagfullCPUEreport)
+                        bm->ShotData[this_shot][sp][tcatch_id] = 0.0;
                     for (ij=0; ij < bm->nbox; ij++) {
+                        if(bm->flagfullCPUEreport) {
+                            bm->ShotData[this_shot][sp][tloc_id] = ij;
+                            bm->ShotData[this_shot][sp][teffort_id] += ((bm->Effort_hdistrib[ij][nf][today_effort] / 24.0 ) - bm->alloced_effort[ij]);
+                        }
                         for (k = 0; k < bm->boxes[ij].nz; k++) {
-                            totC += (bm->Catch[ij][sp][nf][k] * bm->X_CN * mg_2_kg);
+                            catch_kg = bm->Catch[ij][sp][nf][k] * bm->X_CN * mg_2_kg;
+                            if(bm->flagfullCPUEreport) {
+                                bm->ShotData[this_shot][sp][wdepth_id] += catch_kg - bm->alloced_catch[sp][ij][k];
+                                bm->ShotData[this_shot][sp][tcatch_id] += catch_kg - bm->alloced_catch[sp][ij][k];
+                                bm->ShotData[this_shot][sp][tdiscard_id] += (bm->Discards[ij][sp][nf] * bm->X_CN * mg_2_kg) - bm->alloced_discard[sp][ij];
+                            }
+                            totC += catch_kg;
                             tot_alloced[sp] += bm->alloced_catch[sp][ij][k];
                         }
                     }
+                    if(bm->flagfullCPUEreport)
+                        bm->ShotData[this_shot][sp][wdepth_id] /= (bm->ShotData[this_shot][sp][tcatch_id] + small_num);
                     if ( totC > 0.0 )
                         tot_alloced[sp] /= totC;
                     else
@@ -2968,6 +2960,26 @@ void GenerateCPUE(MSEBoxModel *bm, FILE *llogfp) {
  
 }
 
+/*
+ * \brief Find the box for a shot - the first box whose cumulative effort reaches u, or -1 if u is past the total
+ */
+int Find_Shot_Location(double *cum_effort, int nbox, double u) {
+    int lo = 0, hi = nbox - 1, mid;
+
+    if ((nbox < 1) || (u > cum_effort[nbox - 1]))
+        return -1;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (u <= cum_effort[mid])
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+
+    return lo;
+}
+
 /*
  * \brief Allocating geenrated catch to actual depths in selected box 
  */
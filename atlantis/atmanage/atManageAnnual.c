@@ -302,6 +302,16 @@ void Make_Mgmt_Decisions(MSEBoxModel *bm, FILE *llogfp) {
             AMS_Tiered_Assessment(bm, sp, llogfp);
         }
 	}
+#ifdef RASSESS_LINK_ENABLED
+    // The embedded R assessments are run together once their input files are written
+    if (bm->UsingRAssess == 1) {
+        Run_RAssess_All(bm, year, llogfp);
+    }
+#endif
+    // Optional binary copy of the data generated for the tiered assessments
+    if (bm->useRBCTiers && bm->RBCestimation.SS3BinaryDump) {
+        Write_SS3_Binary_Data(bm, year);
+    }
     
     // Allow for F based assessment rule her etoo, judt in case, especiallyfor Norway
     if ((bm->thisyear > 0) && do_assessing){
@@ -1228,8 +1228,14 @@ void Allocate_Arrays_Pre_Load(MSEBoxModel *bm) {
 
 	oldFishEndDay = Util_Alloc_Init_1D_Double(nfleets, 0.0);
 
-	p_fishi = Util_Alloc_Init_3D_Double(nfleets, bm->K_num_max_stages, bm->K_num_tot_sp, 0.0);
 	p_fish_origi = Util_Alloc_Init_4D_Double(nfleets, bm->K_num_max_stages, bm->K_num_tot_sp, bm->nbox, 0.0);
+	/* Scaled overlaps are cached per box - p_fishi just points at the current box's entry */
+	p_fish_scaledi = Util_Alloc_Init_4D_Double(nfleets, bm->K_num_max_stages, bm->K_num_tot_sp, bm->nbox, 0.0);
+	p_fish_scale_used = Util_Alloc_Init_2D_Double(nfleets, bm->nbox, 0.0);
+	p_fish_scale_valid = Util_Alloc_Init_2D_Int(nfleets, bm->nbox, FALSE);
+	p_fishi = p_fish_scaledi[0];
+	catch_active_nf = Util_Alloc_Init_2D_Int(nfleets, bm->K_num_tot_sp, 0);
+	catch_num_active_nf = Util_Alloc_Init_1D_Int(bm->K_num_tot_sp, 0);
 	prev_mult = Util_Alloc_Init_1D_Double(nfleets, 1.0);
     
 	scale_effort = Util_Alloc_Init_1D_Double(nfleets, 0.0);
@@ -1415,8 +1421,13 @@ void Manage_Free(MSEBoxModel *bm) {
 
 	free1d(oldFishEndDay);
 
-	free3d(p_fishi);
+	p_fishi = 0;
 	free4d(p_fish_origi);
+	free4d(p_fish_scaledi);
+	free2d(p_fish_scale_used);
+	i_free2d(p_fish_scale_valid);
+	i_free2d(catch_active_nf);
+	i_free1d(catch_num_active_nf);
 	free1d(prev_mult);
     
     free3d(qSTOCK);
@@ -1448,6 +1459,7 @@ void Manage_Free(MSEBoxModel *bm) {
         free2d(bm->alloced_discard);
         free1d(bm->prop_depth);
         free1d(bm->prop_effort);
+        free1d(bm->cum_effort);
         free3d(bm->ShotData);
         free1d(tot_alloced);
 
@@ -1594,6 +1606,7 @@ void CreateCPUEGenArrays(MSEBoxModel *bm, FILE *llogfp) {
     bm->alloced_discard = Util_Alloc_Init_2D_Double(bm->nbox, bm->K_num_tot_sp, 0.0);
     bm->prop_depth = Util_Alloc_Init_1D_Double(bm->wcnz, 0.0);
     bm->prop_effort = Util_Alloc_Init_1D_Double(bm->nbox, 0.0);
+    bm->cum_effort = Util_Alloc_Init_1D_Double(bm->nbox, 0.0);
     bm->ShotData = Util_Alloc_Init_3D_Double(K_num_shot_data_entries, bm->K_num_tot_sp, max_poss_shots, 0.0);
     tot_alloced = Util_Alloc_Init_1D_Double(bm->K_num_tot_sp, 0.0);
 
@@ -1399,7 +1399,7 @@ void TierThree_CCsel(MSEBoxModel *bm, int species, int year, FILE *llogfp){
 			}
 
 			downhill_simplex(bm, EquilF_Funk_model, species, bm->RBCestimation.RBCspeciesArray[species].simplex, bm->RBCestimation.RBCspeciesArray[species].func, npar, ftol, iter, &ok, llogfp, bm->RBCestimation.RBCspeciesArray[species].xpar);
-			//powell(bm->RBCestimation.RBCspeciesArray[species].xpar,bm->RBCestimation.RBCspeciesArray[species].xunit,npar,ftol,&iter,&ss,EquilF_Funk);
+			//Solve_Powell(bm->RBCestimation.RBCspeciesArray[species].xpar, bm->RBCestimation.RBCspeciesArray[species].xunit, npar, ftol, iter, EquilF_Objective, &args, &niter, &ss);
 
 			nF++;
             
@@ -3386,6 +3386,32 @@ void WriteResults(MSEBoxModel *bm, int species, int region, int year, FILE *llog
 
 }
 
+/*********************************************************************************
+ * Objective functions for the simplex search - all the state they need is in TierFunkArgs
+ * so the search for one species doesn't touch any other species' workings
+*********************************************************************************/
+typedef struct {
+	MSEBoxModel *bm;
+	int species;
+	FILE *llogfp;
+	double *xpar;
+} TierFunkArgs;
+
+/* As in Funk() these are run at the caller's xpar rather than the trial vertex, and score it as 0 */
+static double EquilF_Objective(double *x, int ndim, void *userdata) {
+	TierFunkArgs *args = (TierFunkArgs *) userdata;
+
+	EquilF_Funk(args->bm, args->species, args->xpar, args->llogfp);
+	return 0.0;
+}
+
+static double SurplusProduction_Objective(double *x, int ndim, void *userdata) {
+	TierFunkArgs *args = (TierFunkArgs *) userdata;
+
+	SurplusProduction(args->bm, args->species, args->xpar, args->llogfp);
+	return 0.0;
+}
+
 /*********************************************************************************
  * Calls amoeba search (also known as downhill_simplex) - from numerical recipes
 *********************************************************************************/
@@ -3394,11 +3420,30 @@ void downhill_simplex(MSEBoxModel *bm, int funkflag, int species, double **simpl
 
 	int Ilow = 0;
 	int nfunk = 0;
-	int nyears = (int)(ceil(bm->dayt/365.0));
+	TierFunkArgs args;
+	SolveObjective funk = NULL;
+
+	args.bm = bm;
+	args.species = species;
+	args.llogfp = llogfp;
+	args.xpar = xpar;
+
+	switch (funkflag) {
+	case EquilF_Funk_model:
+		funk = EquilF_Objective;
+		break;
+	case SurplusProduction_model:
+		funk = SurplusProduction_Objective;
+		break;
+	default:
+		quit("downhill_simplex - no tier objective function for funkflag %d\n", funkflag);
+		break;
+	}
 
-	// Point to the amoeba routine in the atassess library
-	Amoeba(bm, 0, species, bm->dayt, FunctGroupArray[species].groupCode, simplex, func, npar, ftol, iter, funkflag,
-			FunctGroupArray[species].numCohorts, nyears, 0, &nfunk, &Ilow, llogfp, xpar);
+	// Point to the simplex routine in the atassess library
+	*ok = Solve_Simplex(simplex, func, npar, ftol, iter, funk, &args, &nfunk, &Ilow);
+	if (!(*ok))
+		fprintf(llogfp, "Time %e downhill_simplex (amoeba) failed to converge\n", bm->dayt);
 
 }
 
@@ -3436,7 +3481,7 @@ static FILE * Init_tierRBC_File(MSEBoxModel *bm) {
 	sprintf(fname, "%sTierRBC.txt", bm->startfname);
     
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("Init_tierRBC_File: Can't open %s\n",fname);
     
     /** Column definitions **/
@@ -3466,7 +3511,7 @@ static FILE * Init_histCPUE_File(MSEBoxModel *bm) {
 	sprintf(fname, "%sHistCPUE.txt", bm->startfname);
     
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("Init_tierRBC_File: Can't open %s\n",fname);
     
     /** Column definitions **/
@@ -3488,7 +3533,7 @@ static FILE * Init_tier5_File(MSEBoxModel *bm) {
 	sprintf(fname, "%sTier5.txt", bm->startfname);
     
     /** Create file **/
-    if ( (fid=Util_fopen(bm, fname, "w")) == NULL )
+    if ( (fid=Util_TextOut_fopen(bm, fname)) == NULL )
         quit("Init_tier5_File: Can't open %s\n",fname);
     
 
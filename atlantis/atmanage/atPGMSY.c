@@ -51,6 +51,7 @@ void Initialise_PGMSY(MSEBoxModel *bm) {
             ASSESS_PROJECTION[sp].WEIGHT = Util_Alloc_Init_1D_Double(maxage, 0);
             ASSESS_PROJECTION[sp].BIO = Util_Alloc_Init_2D_Double(bm->RBCestimation.ProjYr, maxage, 0.0);
             ASSESS_PROJECTION[sp].totavailB = Util_Alloc_Init_1D_Double(bm->K_num_fisheries, 0);
+            ASSESS_PROJECTION[sp].SEL = Util_Alloc_Init_2D_Double(bm->K_num_fisheries, maxage, 0.0);
             ASSESS_PROJECTION[sp].Catch = Util_Alloc_Init_2D_Double(bm->RBCestimation.ProjYr, bm->K_num_fisheries, 0.0);
             ASSESS_PROJECTION[sp].SSB = Util_Alloc_Init_1D_Double(maxage, 0);
             ASSESS_PROJECTION[sp].Depleted = Util_Alloc_Init_1D_Double(maxage, 0);
@@ -80,6 +81,7 @@ void Free_PGMSY(MSEBoxModel *bm) {
             free(ASSESS_PROJECTION[sp].WEIGHT);
             free2d(ASSESS_PROJECTION[sp].BIO);
             free(ASSESS_PROJECTION[sp].totavailB);
+            free2d(ASSESS_PROJECTION[sp].SEL);
             free2d(ASSESS_PROJECTION[sp].Catch);
             free(ASSESS_PROJECTION[sp].SSB);
             free(ASSESS_PROJECTION[sp].Depleted);
@@ -279,6 +281,20 @@ void RunPGMSYProjection(MSEBoxModel *bm, int species, int this_year, double **Fm
             ASSESS_PROJECTION[species].RBC[f] += bm->RBCestimation.RBCspeciesArray[species].RBCupdated[nf][this_year];
         }
     }
+
+    /* Selectivity only depends on length at age and the fleet parameters so get it once here
+     rather than for every projection year */
+    for (age = 0; age < FunctGroupArray[species].numCohortsXnumGenes * ageclasssize; age++) {
+        for (nf = 0; nf < Nfleets; nf++) {
+            lsm = bm->RBCestimation.RBCspeciesArray[species].PGMSY_sel_lsm[nf];
+            sigma = bm->RBCestimation.RBCspeciesArray[species].PGMSY_sel_sigma[nf];
+            sel_curve = (int)(bm->RBCestimation.RBCspeciesArray[species].PGMSY_selcurve[nf]);
+
+            // get selectivity based on size at age
+            ASSESS_PROJECTION[species].SEL[age][nf] = Get_Projection_Selectivity(bm, species, ASSESS_PROJECTION[species].LENGTH[age], sel_curve, lsm, sigma);
+        }
+    }
+
     for (f = 0; f < Nfleets; f++) {
         ASSESS_PROJECTION[species].Fused[f] = Fmatrix[f][this_year];
         ASSESS_PROJECTION[species].Catch[f][0] = bm->RBCestimation.RBCspeciesArray[species].AvgCatFleet[this_year][f];
@@ -307,14 +323,8 @@ void RunPGMSYProjection(MSEBoxModel *bm, int species, int this_year, double **Fm
                 
                 // Get projected catch by applying F
                 for (nf = 0; nf < Nfleets; nf++) {
-                    lsm = bm->RBCestimation.RBCspeciesArray[species].PGMSY_sel_lsm[nf];
-                    sigma = bm->RBCestimation.RBCspeciesArray[species].PGMSY_sel_sigma[nf];
-                    sel_curve = (int)(bm->RBCestimation.RBCspeciesArray[species].PGMSY_selcurve[nf]);
-                    
-                    // get selectivity based on size at age
-                    sel = Get_Projection_Selectivity(bm, species, ASSESS_PROJECTION[species].LENGTH[age], sel_curve, lsm, sigma);
-                    
                     // get final catch
+                    sel = ASSESS_PROJECTION[species].SEL[age][nf];
                     q = bm->RBCestimation.RBCspeciesArray[species].PGMSY_q[nf];
                     ASSESS_PROJECTION[species].totavailB[nf] += ASSESS_PROJECTION[species].BIO[age][iYr] * sel * q;
                     catch = ASSESS_PROJECTION[species].BIO[age][iYr] * sel * q * ASSESS_PROJECTION[species].Fused[nf];
@@ -455,6 +465,9 @@ void Do_Atlantis_PGMSY(MSEBoxModel *bm, int this_year) {
     int Finished = FALSE;
     int StartIt = FALSE;
     int Nfleets, Iyr, sp, nf, f, r;
+#ifdef _OPENMP
+    int proj_threads = Util_Get_Num_Threads(bm);
+#endif
     double minDepletion = 1.0, this_minDepletion, MultBest, TAC_old;
     double MultMin = 0.0;
     double MultMax = 1.0;
@@ -565,14 +578,23 @@ void Do_Atlantis_PGMSY(MSEBoxModel *bm, int this_year) {
         }
     }
     
+    /* The per species projections only touch that species' ASSESS_PROJECTION and RBCspeciesArray
+     entries so they are spread across threads, with the PGMSY.txt output written afterwards in species order */
     // Run projections - based on fixed Fs and not a HCR - use External_Box_Ecology() variant to achieve this?
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(proj_threads) if(proj_threads > 1)
+#endif
     for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
         if (FunctGroupArray[sp].isFished == TRUE) {  // TODO: Could this be made to be isImpacted?
 
             RunPGMSYProjection(bm, sp, this_year, bm->RBCestimation.RBCspeciesArray[sp].Fhist);
     
-            // Get multipliers and depletion from the revised results and then write out the results
+            // Get multipliers and depletion from the revised results
             GetMultipliers(bm, sp, this_year, bm->RBCestimation.RBCspeciesArray[sp].Fupdated);
+        }
+    }
+    for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
+        if (FunctGroupArray[sp].isFished == TRUE) {
             WritePGMSYStep(PGMSYfp, bm, sp, this_year, 1, bm->RBCestimation.RBCspeciesArray[sp].Fupdated);
             
             // Skip RBCupdated adjustment done below as not a real intertion, just a step to switch from dynamic to fixed F
@@ -585,6 +607,9 @@ void Do_Atlantis_PGMSY(MSEBoxModel *bm, int this_year) {
     StartIt = FALSE;
     while ( Finished == FALSE) {
         // Do Tier 1 assessments on appropriate species
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(proj_threads) if(proj_threads > 1) private(tier)
+#endif
         for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
             if (FunctGroupArray[sp].isFished == TRUE) {  // TODO: Could this be made to be isImpacted?
                 tier = (int) (FunctGroupArray[sp].speciesParams[tier_id]);
@@ -597,6 +622,16 @@ void Do_Atlantis_PGMSY(MSEBoxModel *bm, int this_year) {
             
                 // Get multipliers and depletion from the basic run
                 GetMultipliers(bm, sp, this_year, bm->RBCestimation.RBCspeciesArray[sp].Fupdated);
+            }
+        }
+        for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
+            if (FunctGroupArray[sp].isFished == TRUE) {
+                tier = (int) (FunctGroupArray[sp].speciesParams[tier_id]);
+            
+                if (tier != tier1) {
+                    continue;
+                }
+
                 WritePGMSYStep(PGMSYfp, bm, sp, this_year, Iteration, bm->RBCestimation.RBCspeciesArray[sp].Fupdated);
             
                 // Adjust RBCs for average catch species
@@ -611,6 +646,9 @@ void Do_Atlantis_PGMSY(MSEBoxModel *bm, int this_year) {
         
         //Extract the information from the Tier 4 assessments
         minDepletion = 1.0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(proj_threads) if(proj_threads > 1) private(tier, this_minDepletion) reduction(min:minDepletion)
+#endif
         for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
             if (FunctGroupArray[sp].isFished == TRUE) {  // TODO: Could this be made to be isImpacted?
                 tier = (int) (FunctGroupArray[sp].speciesParams[tier_id]);
@@ -0,0 +1,166 @@
+/**
+ *
+ *  Binary data exchange with the embedded R session.
+ *
+ *  Values are handed to R as numeric vectors allocated with allocVector() and filled
+ *  through REAL(), and each year's work is one call carrying every species, rather
+ *  than one parsed text statement per species. The per year entry points are small R
+ *  functions (atlantisUpdateBiomass, atlantisAssessHCR, atlantisRAssessAll) which are
+ *  defined once at start up unless the user's R script already provides them - so a
+ *  script can replace the default per species loop with its own vectorised version.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <sjwlib.h>
+#include <stdlib.h>
+#include "atManage.h"
+#include "atRlink.h"
+
+#ifdef RASSESS_LINK_ENABLED
+
+#include <Rinternals.h>
+#include <Rembedded.h>
+#include <R_ext/Parse.h>
+#include <R_ext/Utils.h>
+
+/* Default batched entry points, only parsed if the R script has not defined them */
+static const char *Rlink_batch_src =
+	"if (!exists(\"atlantisUpdateBiomass\", mode = \"function\")) {\n"
+	"  atlantisUpdateBiomass <- function(year, biomass) {\n"
+	"    yr <- as.character(year)\n"
+	"    for (sp in names(biomass)) stock(biomassIndex[[sp]])[, yr] <<- biomass[[sp]]\n"
+	"    invisible(NULL)\n"
+	"  }\n"
+	"}\n"
+	"if (!exists(\"atlantisAssessHCR\", mode = \"function\")) {\n"
+	"  atlantisAssessHCR <- function(minyear, year, groupCodes) {\n"
+	"    vapply(groupCodes, function(sp) {\n"
+	"      tryCatch(doAssess(minyear, year, sp), error = function(e) print(e))\n"
+	"      tryCatch(as.numeric(doHCR(year, sp))[1], error = function(e) { print(e); -1 })\n"
+	"    }, numeric(1))\n"
+	"  }\n"
+	"}\n"
+	"if (!exists(\"atlantisRAssessAll\", mode = \"function\")) {\n"
+	"  atlantisRAssessAll <- function(infiles, outfiles, outdir) {\n"
+	"    vapply(seq_along(infiles), function(i)\n"
+	"      tryCatch(as.numeric(doRAssess(infiles[i], outfiles[i], outdir))[1], error = function(e) { print(e); -1 }),\n"
+	"      numeric(1))\n"
+	"  }\n"
+	"}\n";
+
+/**
+ * Define the batched R entry points. Safe to call more than once.
+ */
+void Rlink_Define_Batch_Functions(void) {
+	if (exec_r(Rlink_batch_src) != 0)
+		fprintf(stderr, "Rlink_Define_Batch_Functions: could not define the batched R functions\n");
+}
+
+/**
+ * A named R numeric vector holding a copy of values. The caller must UNPROTECT it.
+ */
+SEXP Rlink_Real_Vector(const double *values, int n, char **names) {
+	SEXP vec, vecNames;
+	int i;
+
+	PROTECT(vec = allocVector(REALSXP, n));
+	memcpy(REAL(vec), values, sizeof(double) * (size_t) n);
+
+	if (names != NULL) {
+		PROTECT(vecNames = allocVector(STRSXP, n));
+		for (i = 0; i < n; i++)
+			SET_STRING_ELT(vecNames, i, mkChar(names[i]));
+		setAttrib(vec, R_NamesSymbol, vecNames);
+		UNPROTECT(1);
+	}
+
+	return vec;
+}
+
+/**
+ * An R character vector. The caller must UNPROTECT it.
+ */
+SEXP Rlink_String_Vector(char **strs, int n) {
+	SEXP vec;
+	int i;
+
+	PROTECT(vec = allocVector(STRSXP, n));
+	for (i = 0; i < n; i++)
+		SET_STRING_ELT(vec, i, mkChar(strs[i]));
+
+	return vec;
+}
+
+/**
+ * Evaluate call and copy a numeric result of length n into result (if not NULL).
+ * Returns non zero if R reported an error or the result was the wrong shape.
+ */
+int Rlink_Eval_Real(SEXP call, double *result, int n) {
+	SEXP ret;
+	int errorOccurred = 0;
+
+	ret = R_tryEval(call, R_GlobalEnv, &errorOccurred);
+	if (errorOccurred) {
+		printf("Error occurred calling R\n");
+		return 1;
+	}
+	if (result == NULL)
+		return 0;
+
+	PROTECT(ret);
+	if (!isReal(ret) || LENGTH(ret) != n) {
+		printf("R returned %d values when %d numbers were expected\n", LENGTH(ret), n);
+		UNPROTECT(1);
+		return 1;
+	}
+	memcpy(result, REAL(ret), sizeof(double) * (size_t) n);
+	UNPROTECT(1);
+
+	return 0;
+}
+
+/**
+ * Store every species' biomass for the year in the R biomassIndex in one call.
+ */
+void redus_update_biomass_all(int year, int numSP, char **groupCodes, double *biomass) {
+	SEXP yr, values, call;
+
+	PROTECT(yr = ScalarInteger(year));
+	values = Rlink_Real_Vector(biomass, numSP, groupCodes);
+	PROTECT(call = lang3(install("atlantisUpdateBiomass"), yr, values));
+
+	Rlink_Eval_Real(call, NULL, 0);
+
+	UNPROTECT(3);
+
+	// Check interrupts
+	R_CheckUserInterrupt();
+}
+
+/**
+ * Run the assessment and then the HCR for each of the given species, returning the
+ * F targets in FTARG (-1 where R failed).
+ */
+void redus_do_assessment_hcr_all(int minyearC, int curyearC, int numSP, char **groupCodes, double *FTARG) {
+	SEXP minyear, curyear, codes, call;
+	int sp;
+
+	PROTECT(minyear = ScalarInteger(minyearC));
+	PROTECT(curyear = ScalarInteger(curyearC));
+	codes = Rlink_String_Vector(groupCodes, numSP);
+	PROTECT(call = lang4(install("atlantisAssessHCR"), minyear, curyear, codes));
+
+	if (Rlink_Eval_Real(call, FTARG, numSP)) {
+		for (sp = 0; sp < numSP; sp++)
+			FTARG[sp] = -1;
+	}
+
+	UNPROTECT(4);
+
+	// Check interrupts
+	R_CheckUserInterrupt();
+}
+
+#endif
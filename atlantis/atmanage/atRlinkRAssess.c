@@ -55,8 +55,10 @@ void Do_RAssess(MSEBoxModel *bm, int species, int year, FILE *llogfp) {
     // Write out for RAssess output structure
     Populate_RAssessFile(bm->RAssessFnames[idnum], bm, species);
     
-    // Call R and run RAssess
-    Run_RAssess(bm, species, bm->RAssessFnames[idnum]);
+    // Call R and run RAssess - embedded calls are made for all species at once by Run_RAssess_All
+    if (bm->RAssessRuseScript) {
+        Run_RAssess(bm, species, bm->RAssessFnames[idnum]);
+    }
     
     // If not done already (which will be if using embedded calls), read TAC and rerun information for use in Atlantis
     if (bm->RAssessRuseScript){
@@ -369,6 +371,87 @@ void Run_RAssess(MSEBoxModel *bm, int species, FILE *RAssessfp) {
     return;
 }
 
+/**
+ * Run the embedded RAssess for every species flagged for it in one R call, after
+ * Do_RAssess has written their input files. Does nothing when using Rscript.
+ */
+void Run_RAssess_All(MSEBoxModel *bm, int year, FILE *llogfp) {
+    int sp, n, i;
+    int *species;
+    char **inNames, **outNames;
+    double *TAC;
+    SEXP infiles, outfiles, outdir, r_call;
+
+    if (bm->RAssessRuseScript) {
+        return;
+    }
+
+    species = i_alloc1d(bm->K_num_tot_sp);
+    n = 0;
+    for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
+        if (FunctGroupArray[sp].isTAC > 1) {
+            if (FunctGroupArray[sp].speciesParams[whichRAssess_id] < 0) {
+                quit("whichRAssess is negative for %s so can't complete Run_RAssess\n", FunctGroupArray[sp].groupCode);
+            }
+            species[n++] = sp;
+        }
+    }
+    if (!n) {
+        i_free1d(species);
+        return;
+    }
+
+    inNames = (char **) malloc(sizeof(char *) * n);
+    outNames = (char **) malloc(sizeof(char *) * n);
+    for (i = 0; i < n; i++) {
+        inNames[i] = (char *) malloc(sizeof(char) * STRLEN);
+        outNames[i] = (char *) malloc(sizeof(char) * STRLEN);
+        sprintf(inNames[i], "%s_%s", FunctGroupArray[species[i]].groupCode, bm->RAssessRscriptName[0]);
+        sprintf(outNames[i], "%s_%s", FunctGroupArray[species[i]].groupCode, bm->RAssessRoutName);
+    }
+
+    printf("Run_RAssess_All for %d species\n", n);
+
+    infiles = Rlink_String_Vector(inNames, n);
+    outfiles = Rlink_String_Vector(outNames, n);
+    PROTECT(outdir = mkString(bm->destFolder));
+    PROTECT(r_call = lang4(install("atlantisRAssessAll"), infiles, outfiles, outdir));
+
+    TAC = alloc1d(n);
+    if (Rlink_Eval_Real(r_call, TAC, n)) {
+        for (i = 0; i < n; i++)
+            TAC[i] = -1;
+    }
+    UNPROTECT(4);
+
+    // Check interrupts
+    R_CheckUserInterrupt();
+
+    // Assign the TAC values
+    for (i = 0; i < n; i++) {
+        sp = species[i];
+        printf("RRAssess: R returned TAC value for %s of: %0.5f\n", FunctGroupArray[sp].groupCode, TAC[i]);
+        if(TAC[i] > -1) {
+            bm->RBCestimation.RBCspeciesParam[sp][RBCest_id] = TAC[i];
+            fprintf(bm->logFile, "%s RAssessTAC set to %e\n", FunctGroupArray[sp].groupCode, bm->RBCestimation.RBCspeciesParam[sp][RBCest_id]);
+        } else {
+            fprintf(bm->logFile, "%s RAssessTAC not set as had R error\n", FunctGroupArray[sp].groupCode);
+        }
+    }
+    fflush(bm->logFile);
+
+    for (i = 0; i < n; i++) {
+        free(inNames[i]);
+        free(outNames[i]);
+    }
+    free(inNames);
+    free(outNames);
+    free1d(TAC);
+    i_free1d(species);
+
+    return;
+}
+
 /**
  * Initialize R environment and associated arrays
  */
@@ -387,6 +470,7 @@ void RRAssess_Linkage_Start(MSEBoxModel *bm) {
 
         // Load R functions script
         source(bm->RAssessRscriptName[0]);
+        Rlink_Define_Batch_Functions();
     }
     
     bm->RAssess_initiated = (int *) i_alloc1d(bm->K_num_tot_sp);
@@ -50,6 +50,8 @@ void Redus_Linkage_Start(MSEBoxModel *bm) {
     create_r_redus_object(bm->K_num_tot_sp, (const char**)names, numyr);
     printf("Redus_Linkage_Start: Finish creating R objects\n");
 
+    Rlink_Define_Batch_Functions();
+
     return;
 }
 
@@ -262,6 +264,7 @@ int initRedus(int ans)
     
     // Load R functions script
     source("redus.R");
+    Rlink_Define_Batch_Functions();
     
     return 0;
 }
@@ -321,12 +324,15 @@ const char** redus_getRvecObject(char *name, int *length) {
 }
 
 void REDUS_management(MSEBoxModel *bm, FILE *llogfp) {
-    double FTARG, Fcurr, F_rescale;
+    double Fcurr, F_rescale;
     int year = (int)ceil(bm->dayt / 365);
-    int sp, i, nc, k, nf;
+    int sp, i, nc, k, nf, na;
 	double calcF = 0.0;
     double calcM = 0.0;
     double counter = 0.0;
+    double *biomass, *FTARG;
+    char **groupCodes, **assessCodes;
+    int *assessIndex;
 
     /* Conf global (Get from R objects) */
     int collectStart = redus_getRintObject("collectStart");
@@ -339,66 +345,84 @@ void REDUS_management(MSEBoxModel *bm, FILE *llogfp) {
 
 	printf("REDUS: We are at year %d\n", year);
 
-    /* Data collection */
+    groupCodes = (char **) malloc(sizeof(char *) * bm->K_num_tot_sp);
+    for (sp = 0; sp < bm->K_num_tot_sp; sp++)
+        groupCodes[sp] = FunctGroupArray[sp].groupCode;
+
+    /* Data collection - all species go to R in one numeric vector */
     if( year >= collectStart ) {
+        biomass = alloc1d(bm->K_num_tot_sp);
         for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
-            printf("REDUS: Collect biomass for %s at year %d\n", FunctGroupArray[sp].groupCode, year);
-            redus_update_biomass(year, FunctGroupArray[sp].groupCode, bm->totfishpop[sp] * bm->X_CN * mg_2_tonne);
-            fprintf(llogfp, "REDUS: Biomass at Time: %e (year: %d) for %s is %e\n", bm->dayt, year, FunctGroupArray[sp].groupCode,  bm->totfishpop[sp] * bm->X_CN * mg_2_tonne);
+            biomass[sp] = bm->totfishpop[sp] * bm->X_CN * mg_2_tonne;
+            fprintf(llogfp, "REDUS: Biomass at Time: %e (year: %d) for %s is %e\n", bm->dayt, year, FunctGroupArray[sp].groupCode, biomass[sp]);
         }
+        printf("REDUS: Collect biomass for %d groups at year %d\n", bm->K_num_tot_sp, year);
+        redus_update_biomass_all(year, bm->K_num_tot_sp, groupCodes, biomass);
+        free1d(biomass);
     }
 
     /* Do management */
     if( year >= assessStart ) {
+        /* Work out who is assessed, then do all the assessments and HCRs in one call */
+        assessIndex = i_alloc1d(bm->K_num_tot_sp * (assessSPnum > 0 ? assessSPnum : 1));
+        assessCodes = (char **) malloc(sizeof(char *) * bm->K_num_tot_sp * (assessSPnum > 0 ? assessSPnum : 1));
+        na = 0;
         for (sp = 0; sp < bm->K_num_tot_sp; sp++) {
             for (i = 0; i < assessSPnum; i++) {
-                printf("REDUS: Is %s (%s) going to be assessed? %d\n", FunctGroupArray[sp].groupCode, assessSP[i], strncmp(FunctGroupArray[sp].groupCode, assessSP[i], 3));
                 if (!strncmp(FunctGroupArray[sp].groupCode, assessSP[i], 3)) {
-                    printf("REDUS: Doing assessment for %s at year %d\n", FunctGroupArray[sp].groupCode, year);
-                    redus_do_assessment(collectStart, year, FunctGroupArray[sp].groupCode);
-                    printf("REDUS: Doing HCR for %s at year %d\n", FunctGroupArray[sp].groupCode, year);
-                    FTARG = redus_do_hcr(year, FunctGroupArray[sp].groupCode);
-
-                    // Find Fcurr
-                    calcF = 0.0;
-                    calcM = 0.0;
-                    counter = 0.0;
-                    for (nc = 0; nc < FunctGroupArray[sp].numCohorts; nc++) {
-                        for (k = 0; k < FunctGroupArray[sp].numStocks; k++) {
-                            calcM += (bm->calcTrackedMort[sp][nc][k][finalM1_id] + bm->calcTrackedMort[sp][nc][k][finalM2_id]);
-                            calcF += bm->calcTrackedMort[sp][nc][k][finalF_id];
-                            counter++;
-                        }
-                    }
-                     calcM /= counter;
-                    calcF /= counter;
-                    Fcurr = calcF;
-
-                    // Apply F rescale
-                    //FrefA = FunctGroupArray[sp].speciesParams[FrefA_id];
-
-                    if(Fcurr <= 0 || FTARG <= 0) {
-                        F_rescale = 1;
-                    } else {
-                        //this_mFC = FunctGroupArray[sp].speciesParams[maxmFC_id] * 365.0;  // As FrefA is annual but mFC is daily
-                        //Fstep1 = Fcurr / this_mFC;
-                        //F_rescale = Fstep1 * (FTARG / (Fcurr + small_num));
-                        F_rescale = FTARG / Fcurr;
-                        //fprintf(llogfp, "REDUS: FTARG: %e, FrefA: %e, Fcurr: %e, this_mFC: %e, Fstep1: %e\n", FTARG, FrefA, Fcurr, this_mFC, Fstep1);
-                    }
+                    assessIndex[na] = sp;
+                    assessCodes[na] = FunctGroupArray[sp].groupCode;
+                    na++;
+                }
+            }
+        }
 
-                    for (nf = 0; nf < bm->K_num_fisheries; nf++) {
-                        bm->SP_FISHERYprms[sp][nf][mFC_scale_id] = F_rescale;
+        if (na > 0) {
+            printf("REDUS: Doing assessment and HCR for %d groups at year %d\n", na, year);
+            FTARG = alloc1d(na);
+            redus_do_assessment_hcr_all(collectStart, year, na, assessCodes, FTARG);
+
+            for (i = 0; i < na; i++) {
+                sp = assessIndex[i];
+                printf("REDUS: R returned F target value for %s of: %0.5f\n", FunctGroupArray[sp].groupCode, FTARG[i]);
+
+                // Find Fcurr
+                calcF = 0.0;
+                calcM = 0.0;
+                counter = 0.0;
+                for (nc = 0; nc < FunctGroupArray[sp].numCohorts; nc++) {
+                    for (k = 0; k < FunctGroupArray[sp].numStocks; k++) {
+                        calcM += (bm->calcTrackedMort[sp][nc][k][finalM1_id] + bm->calcTrackedMort[sp][nc][k][finalM2_id]);
+                        calcF += bm->calcTrackedMort[sp][nc][k][finalF_id];
+                        counter++;
                     }
+                }
+                calcM /= counter;
+                calcF /= counter;
+                Fcurr = calcF;
+
+                // Apply F rescale
+                if(Fcurr <= 0 || FTARG[i] <= 0) {
+                    F_rescale = 1;
+                } else {
+                    F_rescale = FTARG[i] / Fcurr;
+                }
 
-                    // REDUS log
-                    fprintf(llogfp, "REDUS: HCR at Time: %e for %s F_rescale: %e, FTARG: %e, Fcurr: %e\n", bm->dayt, FunctGroupArray[sp].groupCode, F_rescale, FTARG, Fcurr);
+                for (nf = 0; nf < bm->K_num_fisheries; nf++) {
+                    bm->SP_FISHERYprms[sp][nf][mFC_scale_id] = F_rescale;
                 }
+
+                // REDUS log
+                fprintf(llogfp, "REDUS: HCR at Time: %e for %s F_rescale: %e, FTARG: %e, Fcurr: %e\n", bm->dayt, FunctGroupArray[sp].groupCode, F_rescale, FTARG[i], Fcurr);
             }
+            free1d(FTARG);
         }
+        i_free1d(assessIndex);
+        free(assessCodes);
     }
 
     // Free up memory
+    free(groupCodes);
     free(assessSP);
 }
 
@@ -39,7 +39,8 @@ double Manage_Get_Manage_Index(MSEBoxModel *bm, int nf, int index);
 void Manage_Visit_Council(MSEBoxModel *bm, FILE *llogfp);
 void Manage_Output_Indices(MSEBoxModel *bm);
 
-extern double ***p_fishi, **k_cover, ***Effort_vdistrib, ****p_fish_origi,
+extern int **p_fish_scale_valid, **catch_active_nf, *catch_num_active_nf;
+extern double ***p_fishi, **k_cover, ***Effort_vdistrib, ****p_fish_origi, ****p_fish_scaledi, **p_fish_scale_used,
 	**FC_hdistrib, **MPAendangered, **SEASONAL, **effort_scale, ***qSTOCK,
 	*oldFishEndDay, *scale_effort, *prev_mult, **FC_case, *DistPeak, *FrefAi,
     *FrefHi, *FreStarti, *LeverUsei, *estErrori, *estCVi, *estBiasi, *FrefLimi,
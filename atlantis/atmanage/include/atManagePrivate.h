@@ -49,8 +49,10 @@ Modelling variables for control of processes within the model
 */
 
 int *flagdropeffort = 0, *MPAKeyMap = 0, *checkedbox = 0, need_discard;
+int **p_fish_scale_valid = 0, **catch_active_nf = 0, *catch_num_active_nf = 0;
 
 double ***p_fishi = 0, **k_cover = 0, ***Effort_vdistrib = 0, ****p_fish_origi = 0,
+	****p_fish_scaledi = 0, **p_fish_scale_used = 0,
 	***EFFORTchange = 0, ***qSTOCK = 0,
 	**FC_hdistrib = 0, **MPAendangered = 0, **SEASONAL = 0, **effort_scale = 0,
 	*oldFishEndDay = 0, *scale_effort = 0, *prev_mult = 0,
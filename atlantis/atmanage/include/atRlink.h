@@ -11,6 +11,17 @@ void redus_update_biomass(int year, char* groupCode, double biomass);
 
 double redus_do_hcr(int curyearC, char* groupCodeC);
 
+// Binary, batched exchange (atRlinkData.c)
+void redus_update_biomass_all(int year, int numSP, char **groupCodes, double *biomass);
+void redus_do_assessment_hcr_all(int minyearC, int curyearC, int numSP, char **groupCodes, double *FTARG);
+void Rlink_Define_Batch_Functions(void);
+#ifdef RASSESS_LINK_ENABLED
+#include <Rinternals.h>
+SEXP Rlink_Real_Vector(const double *values, int n, char **names);
+SEXP Rlink_String_Vector(char **strs, int n);
+int Rlink_Eval_Real(SEXP call, double *result, int n);
+#endif
+
 int initRedus(int ans);
 int redus_getRintObject(char *name);
 int exec_r(const char* str);
@@ -13,6 +13,8 @@
 #include <sjwlib.h>
 #include <atlantisboxmodel.h>
 #include <atUtilLib.h>
+#include <string.h>
+#include <atPhysics.h>
 
 void allocatePhysicsModule(MSEBoxModel *bm){
 
@@ -21,6 +23,130 @@ void allocatePhysicsModule(MSEBoxModel *bm){
 	bm->atPhysicsModule->masstosed = NULL;
 	bm->atPhysicsModule->expfp = NULL;
 	bm->atPhysicsModule->totinp = NULL;
+	bm->atPhysicsModule->pssval = NULL;
+	bm->atPhysicsModule->vdiffid = NULL;
+	bm->atPhysicsModule->nvdiff = 0;
+	bm->atPhysicsModule->advid = NULL;
+	bm->atPhysicsModule->nadv = 0;
+	bm->atPhysicsModule->transid = NULL;
+	bm->atPhysicsModule->ntrans = 0;
+	bm->atPhysicsModule->hmixid = NULL;
+	bm->atPhysicsModule->nhmix = 0;
+	bm->atPhysicsModule->settleid = NULL;
+	bm->atPhysicsModule->nsettle = 0;
+	bm->atPhysicsModule->vmixid = NULL;
+	bm->atPhysicsModule->nvmix = 0;
+	bm->atPhysicsModule->vmixO2id = -1;
+}
+
+/* Find the index of the named water column tracer (not water), -1 if not there */
+static int physicsTracerIndex(MSEBoxModel *bm, const char *name)
+{
+	int n;
+
+	for (n = 0; n < bm->ntracer; n++) {
+		if (bm->tinfo[n].inwc && n != bm->waterid && !strcmp(bm->tinfo[n].name, name))
+			return n;
+	}
+	return -1;
+}
+
+/**
+ * Build the lists of tracers used by the physics routines and find the tracers
+ * replenished from the deep ocean. The active group flags must already be set.
+ */
+void setupPhysicsTracerLists(MSEBoxModel *bm)
+{
+	atPhysicsStructure *pm = bm->atPhysicsModule;
+	int n;
+
+	if (pm->vdiffid != NULL)
+		return;
+
+	pm->vdiffid = i_alloc1d(bm->ntracer);
+	pm->vmixid = i_alloc1d(bm->ntracer);
+	pm->advid = i_alloc1d(bm->ntracer);
+	pm->transid = i_alloc1d(bm->ntracer);
+	pm->hmixid = i_alloc1d(bm->ntracer);
+	pm->settleid = i_alloc1d(bm->ntracer);
+	pm->nvdiff = 0;
+	pm->nvmix = 0;
+	pm->nadv = 0;
+	pm->ntrans = 0;
+	pm->nhmix = 0;
+	pm->nsettle = 0;
+	pm->vmixO2id = -1;
+	for (n = 0; n < bm->ntracer; n++) {
+		int fixed = bm->tinfo[n].partic && !bm->tinfo[n].passive;
+		int inactive = bm->do_availflag && !bm->tinfo[n].flagid;
+
+		/* Settling and buoyancy, in the water column or the sediments */
+		if ((bm->tinfo[n].inwc || bm->tinfo[n].insed) && bm->tinfo[n].can_be_moved
+				&& (bm->tinfo[n].svel + bm->tinfo[n].xvel) != 0.0)
+			pm->settleid[pm->nsettle++] = n;
+
+		/* Non passive particulates are not carried by the flows */
+		if (fixed)
+			continue;
+		pm->advid[pm->nadv++] = n;
+
+		if (!bm->tinfo[n].inwc || inactive)
+			continue;
+		if (bm->tinfo[n].can_be_moved && bm->tinfo[n].isUsed)
+			pm->transid[pm->ntrans++] = n;
+		if (n != bm->waterid)
+			pm->hmixid[pm->nhmix++] = n;
+	}
+
+	for (n = 0; n < bm->ntracer; n++) {
+		/* Skip tracers not in water column and don't mix water variable! */
+		if (!bm->tinfo[n].inwc || n == bm->waterid)
+			continue;
+		pm->vdiffid[pm->nvdiff++] = n;
+
+		/* Forced mixing only moves dissolved tracers */
+		if (!bm->tinfo[n].dissol)
+			continue;
+		if (!strcmp(bm->tinfo[n].name, "Oxygen"))
+			pm->vmixO2id = pm->nvmix;
+		pm->vmixid[pm->nvmix++] = n;
+	}
+
+	pm->deepNHid = physicsTracerIndex(bm, "NH3");
+	pm->deepNOid = physicsTracerIndex(bm, "NO3");
+	pm->deepO2id = bm->mix_deep_O2 ? physicsTracerIndex(bm, "Oxygen") : -1;
+	pm->deepSiid = physicsTracerIndex(bm, "Si");
+	pm->deepFeid = physicsTracerIndex(bm, "MicroNut");
+	pm->deepPid = bm->track_atomic_ratio ? physicsTracerIndex(bm, "Phosphorus") : -1;
+	pm->deepCid = bm->track_atomic_ratio ? physicsTracerIndex(bm, "Carbon") : -1;
+}
+
+/* Reset one deep ocean tracer in the bottom water column layer */
+static void deepReplenishTracer(MSEBoxModel *bm, int n, double value, double *botval, int dissol_only)
+{
+	if (n < 0)
+		return;
+	if (dissol_only && !bm->tinfo[n].dissol)
+		return;
+	botval[n] = value;
+}
+
+/**
+ * Replenish the lowest water column layer of a box from the deep ocean.
+ * botval is the tracer vector of the bottom layer, if dissol_only is set only
+ * dissolved tracers are reset.
+ */
+void deepReplenishPhysics(MSEBoxModel *bm, Box *bp, double *botval, int dissol_only)
+{
+	atPhysicsStructure *pm = bm->atPhysicsModule;
+
+	deepReplenishTracer(bm, pm->deepNHid, bp->bottNH, botval, dissol_only);
+	deepReplenishTracer(bm, pm->deepNOid, bp->bottNO, botval, dissol_only);
+	deepReplenishTracer(bm, pm->deepO2id, bp->bottO2, botval, dissol_only);
+	deepReplenishTracer(bm, pm->deepSiid, bp->bottSi, botval, dissol_only);
+	deepReplenishTracer(bm, pm->deepFeid, bp->bottFe, botval, dissol_only);
+	deepReplenishTracer(bm, pm->deepPid, bp->bottP, botval, dissol_only);
+	deepReplenishTracer(bm, pm->deepCid, bp->bottC, botval, dissol_only);
 }
 
 void closePhysicsFile(FILE *fp)
@@ -40,5 +166,26 @@ void freePhysicsStruct(MSEBoxModel *bm){
 	if(bm->atPhysicsModule->totinp != NULL)
 		free1d(bm->atPhysicsModule->totinp);
 
+	if(bm->atPhysicsModule->pssval != NULL)
+		free1d(bm->atPhysicsModule->pssval);
+
+	if(bm->atPhysicsModule->vdiffid != NULL)
+		i_free1d(bm->atPhysicsModule->vdiffid);
+
+	if(bm->atPhysicsModule->vmixid != NULL)
+		i_free1d(bm->atPhysicsModule->vmixid);
+
+	if(bm->atPhysicsModule->advid != NULL)
+		i_free1d(bm->atPhysicsModule->advid);
+
+	if(bm->atPhysicsModule->transid != NULL)
+		i_free1d(bm->atPhysicsModule->transid);
+
+	if(bm->atPhysicsModule->hmixid != NULL)
+		i_free1d(bm->atPhysicsModule->hmixid);
+
+	if(bm->atPhysicsModule->settleid != NULL)
+		i_free1d(bm->atPhysicsModule->settleid);
+
 	free(bm->atPhysicsModule);
 }
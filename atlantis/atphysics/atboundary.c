@@ -28,6 +28,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <sjwlib.h>
 #include <atlantisboxmodel.h>
@@ -53,28 +54,19 @@ void boundaries(MSEBoxModel *bm, double ***newwctr, double ***newsedtr,  double
 			* volume, dz, sediment properties etc
 			*/
 
-			/* Loop over each water column layer and tracer */
-			for(k=0; k<bp->nz; k++){
-				for(n=0; n<bm->ntracer; n++){
-					newwctr[b][k][n] = bp->tr[k][n];
-				}
-			}
+			/* Every tracer is held at its boundary value, so copy
+			 * each layer as one contiguous row */
+			for(k=0; k<bp->nz; k++)
+				memcpy(newwctr[b][k], bp->tr[k], (size_t)bm->ntracer * sizeof(double));
 			
-			/* Loop over each sediment layer and tracer */
-			for(k=0; k<bp->sm.nz; k++){
-				for(n=0; n<bm->ntracer; n++){
-					newsedtr[b][k][n] = bp->sm.tr[k][n];
-				}
-			}
+			/* Each sediment layer */
+			for(k=0; k<bp->sm.nz; k++)
+				memcpy(newsedtr[b][k], bp->sm.tr[k], (size_t)bm->ntracer * sizeof(double));
 
 			if(bm->ice_on == TRUE){
-				/* Loop over each ice layer and tracer */
-				for(k=0; k<bp->ice.nz; k++){
-
-					for(n=0; n<bm->ntracer; n++){
-						newicetr[b][k][n] = bp->ice.tr[k][n];
-					}
-				}
+				/* Each ice layer */
+				for(k=0; k<bp->ice.nz; k++)
+					memcpy(newicetr[b][k], bp->ice.tr[k], (size_t)bm->ntracer * sizeof(double));
 			}
 
 			if(bm->terrestrial_on){
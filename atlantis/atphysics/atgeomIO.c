@@ -45,6 +45,7 @@
 
 void parseProjectionString(MSEBoxModel *bm, FILE *fp);
 static int getUniqueIBox( MSEBoxModel *bm, Box *b);
+static void Build_Box_Graph(MSEBoxModel *bm);
 static void Get_DistID(MSEBoxModel *bm);
 
 static void CopyBGMFile(MSEBoxModel *bm, char *name){
@@ -265,6 +266,9 @@ void readMSEBoxModelGeom(char *name, MSEBoxModel *bm)
 	ydist = maxnorth - maxsouth;
 	bm->width = sqrt(xdist * xdist + ydist * ydist);
     
+    /* Build the adjacency list and box to box distances used by the spatial routines */
+    Build_Box_Graph(bm);
+
     if(verbose){
         printf("Got model width, now do Get_DistID\n");
     }
@@ -847,10 +851,54 @@ static int getUniqueIBox( MSEBoxModel *bm, Box *b){
 	return 1;
 }
 
+/**
+ * \brief Build the box connectivity graph.
+ *
+ * Stores the distance between the centres of every pair of boxes (bm->box_dist) and
+ * a compressed sparse row copy of the unique adjacent boxes of each box with the
+ * distance to each of them (bm->adj_start, bm->adj_box, bm->adj_dist), so the
+ * movement and spreading code can look these up rather than recalculate them.
+ */
+static void Build_Box_Graph(MSEBoxModel *bm) {
+    int ij, k, nb, count;
+    double xdist, ydist;
+
+    bm->box_dist = Util_Alloc_Init_2D_Double(bm->nbox, bm->nbox, 0.0);
+    for (ij = 0; ij < bm->nbox; ij++) {
+        for (k = 0; k < bm->nbox; k++) {
+            xdist = bm->boxes[ij].inside.x - bm->boxes[k].inside.x;
+            ydist = bm->boxes[ij].inside.y - bm->boxes[k].inside.y;
+            bm->box_dist[ij][k] = sqrt(xdist * xdist + ydist * ydist);
+        }
+    }
+
+    count = 0;
+    for (ij = 0; ij < bm->nbox; ij++) {
+        count += bm->boxes[ij].nUniqueAdj;
+    }
+
+    bm->adj_start = Util_Alloc_Init_1D_Int(bm->nbox + 1, 0);
+    bm->adj_box = Util_Alloc_Init_1D_Int(max(count, 1), 0);
+    bm->adj_dist = Util_Alloc_Init_1D_Double(max(count, 1), 0.0);
+
+    count = 0;
+    for (ij = 0; ij < bm->nbox; ij++) {
+        bm->adj_start[ij] = count;
+        for (k = 0; k < bm->boxes[ij].nUniqueAdj; k++) {
+            nb = bm->boxes[ij].uniqueAdjBoxes[k];
+            bm->adj_box[count] = nb;
+            bm->adj_dist[count] = bm->box_dist[ij][nb];
+            count++;
+        }
+    }
+    bm->adj_start[bm->nbox] = count;
+
+    return;
+}
+
 static void Get_DistID(MSEBoxModel *bm) {
     int ij, k;
     double *ax, *bx, *cx, *dx, *ex;
-    double xdist, ydist;
     
     if(verbose) {
         printf("Sorting distances - get DistID\n");
@@ -867,9 +915,7 @@ static void Get_DistID(MSEBoxModel *bm) {
         bm->boxes[ij].distID = (int *)malloc(sizeof(int) * bm->nbox);
 
         for (k=0; k < bm->nbox; k++) {
-            xdist = bm->boxes[ij].inside.x - bm->boxes[k].inside.x;
-            ydist = bm->boxes[ij].inside.y - bm->boxes[k].inside.y;
-            ax[k] = sqrt(xdist * xdist + ydist * ydist);
+            ax[k] = bm->box_dist[ij][k];
             bx[k] = k; // IDs that want sorted based on distance and then load into DistID
             cx[k] = 1.0; // Not needed in this case
             dx[k] = 1.0; // Not needed in this case
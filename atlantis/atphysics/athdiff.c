@@ -13,78 +13,142 @@
 
     Returns:        void
     
-    Revisions:      
+    Revisions:      Horizontal diffusion does all the tracers of a box in one
+                    diffusion1d_multi() call and splits the tracers across threads.
 *********************************************************************/
 
 #include <stdio.h>
 #include <math.h>
 #include <string.h>
 #include <sjwlib.h>
+#include <stdlib.h>
 #include <atlantisboxmodel.h>
+#include <atUtilLib.h>
+#include <atPhysics.h>
 
-/* Horizontal mixing in the water column */
-void hdiffBMwc(MSEBoxModel *bm, double ***newval, FILE *llogfp)
+/* Horizontal diffusion of the nv tracers in vid. The boxes are done in order, as each
+ * box mixes the values of its neighbours in place, but the tracers are independent.
+ */
+static void hdiffTracers(MSEBoxModel *bm, double ***newval, int *vid, int nv)
 {
     int b = 0;
 	int nb = 0;
 	int bb = 0;
     int k = 0;
-    int n = 0;
+    int j = 0;
 	int nnconn = 0;
     double dt = bm->dt;
+    double *hc = alloc1d(bm->max_nconn * bm->ntracer);
+    double *hx = alloc1d(bm->max_nconn);
+    double *work = alloc1d(DIFFUSION1D_MULTI_NWORK(bm->max_nconn, nv));
+    double **hrow = (double **)malloc((size_t)bm->max_nconn * sizeof(double *));
 
-	if( verbose )
-		fprintf(stderr,"Entering hdiffBMwc\n");
+    if( hrow == NULL )
+	quit("hdiffTracers: no memory for neighbour rows\n");
+    for(nb=0; nb<bm->max_nconn; nb++) {
+	hrow[nb] = &hc[nb * bm->ntracer];
+	/* diffusion1d uses one more x value than there are neighbours, so
+	 * start from the coordinates left in bm->hx as the serial code did */
+	hx[nb] = bm->hx[nb];
+    }
 
     /* Loop over each box */
     for(b=0; b<bm->nbox; b++) {
         Box *bp = &bm->boxes[b];
 
         if( bp->type != BOUNDARY && bp->type != LAND) {
-            /* Loop over each tracer */
-            
-            for(n=0; n<bm->ntracer; n++) {
-                /* Skip tracers not in water column */
-                if( !bm->tinfo[n].inwc )
-                    continue;
+            nnconn = bp->nconn;
+            for(nb=0; nb<nnconn; nb++)
+                hx[nb] = bm->boxes[bp->ibox[nb]].inside.x;
 
-                /* Don't mix water variable! */
-                if( n==bm->waterid )
-                    continue;
+            /* Collect tracer values for doing diffusion for each layer in each adjoining box */
+            for(k=0; k<bp->nz; k++){
+                for(nb=0; nb<nnconn; nb++){
+                    double *val = newval[bp->ibox[nb]][k];
 
-                /* Collect tracer values for doing diffusion for each layer in each adjoining box */
-                nnconn = bm->boxes[b].nconn;
-                for(k=0; k<bp->nz; k++){
-                    for(nb=0; nb<bm->boxes[b].nconn; nb++){
-                        bb = bm->boxes[b].ibox[nb];
-                        bm->hc[nb] = newval[bb][k][n];
-                        bm->hx[nb] = bm->boxes[bb].inside.x;
-                    }
+                    for(j=0; j<nv; j++)
+                        hrow[nb][vid[j]] = val[vid[j]];
+                }
 
-                    /* Calculate diffusion */
-                    diffusion1d(nnconn,bm->hc,bm->hx,bm->hk,bm->hx,dt,bm->a_wc);
+                /* Calculate diffusion */
+                diffusion1d_multi(nnconn,hrow,vid,nv,hx,bm->hk,hx,dt,bm->a_wc,work);
 
-                    /* Store new values */
-                    for(nb=0; nb<bm->boxes[b].nconn; nb++){
-                        bb = bm->boxes[b].ibox[nb];
-                        newval[bb][k][n] = bm->hc[nb];
-                    }
+                /* Store new values - in neighbour order, as a box may be listed more than once */
+                for(nb=0; nb<nnconn; nb++){
+                    double *val;
+
+                    bb = bp->ibox[nb];
+                    val = newval[bb][k];
+                    for(j=0; j<nv; j++)
+                        val[vid[j]] = hrow[nb][vid[j]];
                 }
             }
         }
 	}
-    
+
+    free1d(hc);
+    free1d(hx);
+    free1d(work);
+    free(hrow);
+}
+
+/* Horizontal mixing in the water column */
+void hdiffBMwc(MSEBoxModel *bm, double ***newval, FILE *llogfp)
+{
+    atPhysicsStructure *pm = bm->atPhysicsModule;
+    int nchunk = Util_Get_Num_Threads(bm);
+    int c = 0;
+    int b = 0;
+    int nb = 0;
+
+	if( verbose )
+		fprintf(stderr,"Entering hdiffBMwc\n");
+
+    /* Water column tracers that are mixed (not water) */
+    setupPhysicsTracerLists(bm);
+    if( pm->nvdiff < 1 )
+        return;
+
+    /* Split the tracers into one block per thread. Each tracer goes through
+     * the same steps whatever block it is in, so the results do not depend
+     * on the number of threads.
+     */
+    if( nchunk > pm->nvdiff )
+        nchunk = pm->nvdiff;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(nchunk) if(nchunk > 1)
+#endif
+    for(c=0; c<nchunk; c++) {
+        int first = c * pm->nvdiff / nchunk;
+        int last = (c + 1) * pm->nvdiff / nchunk;
+
+        hdiffTracers(bm, newval, &pm->vdiffid[first], last - first);
+    }
+
+    /* Leave bm->hx as the serial code would have */
+    for(b=0; b<bm->nbox; b++) {
+        Box *bp = &bm->boxes[b];
+
+        if( bp->type != BOUNDARY && bp->type != LAND) {
+            for(nb=0; nb<bp->nconn; nb++)
+                bm->hx[nb] = bm->boxes[bp->ibox[nb]].inside.x;
+        }
+    }
+
     return;
 }
 
 /* Horizontal mixing in the water column done as simple weighted averaging */
 void filler_hdiffBMwc(MSEBoxModel *bm, double ***newval, FILE *llogfp)
 {
+    atPhysicsStructure *pm = bm->atPhysicsModule;
     int b = 0;
 	int nb = 0;
 	int bb = 0;
     int k = 0;
     int n = 0;
+    int j = 0;
 	int nnconn = 0;
     double dt = bm->dt;
     double flushin_days, flushout_days, totvol, tot_exvol, new_avg_val, added_tr, removed_tr, hmix;
@@ -92,28 +156,19 @@ void filler_hdiffBMwc(MSEBoxModel *bm, double ***newval, FILE *llogfp)
     
 	if( verbose )
 		fprintf(stderr,"Entering filler_hdiffBMwc\n");
+
+    /* Active water column tracers that can be moved (not water) */
+    setupPhysicsTracerLists(bm);
     
     /* Loop over each box */
     for(b=0; b<bm->nbox; b++) {
         Box *bp = &bm->boxes[b];
         
         if( bp->type != BOUNDARY && bp->type != LAND) {
-            /* Loop over each tracer */
-            
-            for(n=0; n<bm->ntracer; n++) {
-                /* Skip tracers not in water column */
-                if( !bm->tinfo[n].inwc )
-                    continue;
-                
-                if ((bm->do_availflag && !bm->tinfo[n].flagid) || (bm->tinfo[n].partic && !bm->tinfo[n].passive)) {
-                    continue;  // As not allow to move it
-                } else
-                    // Can do these so let the code flow
-                    
-                /* Don't mix water variable! */
-                    if( n==bm->waterid )
-                        continue;
-                
+            /* Loop over each tracer that is allowed to move */
+            for(j=0; j<pm->nhmix; j++) {
+                n = pm->hmixid[j];
+
                 /* Collect tracer values for doing diffusion for each layer in each adjoining box */
                 for(k=0; k<bp->nz; k++){
                     for(nb=0; nb<bm->max_nconn; nb++){
@@ -180,6 +180,15 @@ static int Read_Run_Parameters(MSEBoxModel *bm, char *fileName) {
     if (!bm->fishmove)
         warn("Vertebrate movement has been turned off (fishmove set to 0)\n");
 
+    bm->nthreads = (int) Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 0, groupingNode, integer_check, "nthreads");
+    if (bm->nthreads < 1)
+        bm->nthreads = 1;
+
+    bm->rand_seed = (int) Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 0, groupingNode, integer_check, "rand_seed");
+    if (bm->rand_seed < 0)
+        bm->rand_seed = 0;
+    Util_Rand_Init(bm);
+
 	bm->flaghemisphere = (int) Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 1, groupingNode, binary_check, "flaghemisphere");
 
 	/* Read in information about additional tracers */
@@ -316,6 +325,14 @@ static int Read_Run_Parameters(MSEBoxModel *bm, char *fileName) {
 	bm->flagchecksize = (int) Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 1, groupingNode, binary_check, "flagchecksize");
 	bm->flagagecheck = (int) Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 1, groupingNode, binary_check, "flagagecheck");
     bm->flagdietcheck = (int) Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 1, groupingNode, binary_check, "flagdietcheck");
+
+    /* Optional - the diet check and mortality files are written unless these are set to 0 */
+    bm->flagdietoutput = TRUE;
+    if (Util_XML_Get_Node(ATLANTIS_ATTRIBUTE, groupingNode, "flagdietoutput") != NULL)
+        bm->flagdietoutput = (int) Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 1, groupingNode, binary_check, "flagdietoutput");
+    bm->flagmortoutput = TRUE;
+    if (Util_XML_Get_Node(ATLANTIS_ATTRIBUTE, groupingNode, "flagmortoutput") != NULL)
+        bm->flagmortoutput = (int) Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 1, groupingNode, binary_check, "flagmortoutput");
     bm->flagenviro_warn = (int) Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 1, groupingNode, binary_check, "flagenviro_warn");
 
     bm->flag_mig_in_bioindx = (int) Util_XML_Read_Value(fileName, ATLANTIS_ATTRIBUTE, bm->ecotest, 1, groupingNode, binary_check, "flag_mig_in_bioindx");
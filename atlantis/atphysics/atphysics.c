@@ -363,6 +363,14 @@ void initPhysics(MSEBoxModel *bm) {
 		 */
 		readkeyprm_i(pfp, "vert_mix", &bm->vert_mix);
 
+		/* Read optional switch to solve the forced vertical mixing implicitly,
+		 * which stays stable for long physics time steps. Default is slab mixing.
+		 */
+		bm->vert_mix_implicit = 0;
+		set_keyprm_errfn(quiet);
+		readkeyprm_i(pfp, "vert_mix_implicit", &bm->vert_mix_implicit);
+		set_keyprm_errfn(quit);
+
 		/* Read switch indicating whether or not to use transport model
 		 */
 		readkeyprm_i(pfp, "advect_diffusion", &bm->advect_diffusion);
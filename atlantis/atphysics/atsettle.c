@@ -32,6 +32,9 @@
 					28/Nov/2008 Bec Gorton
 					Moved the static variable masstosed into the atPhysicsModule
 					so it can be freed at the end of the model run.
+
+					Settle and deposit box by box (settleBox) so the boxes
+					can be spread across threads.
 *********************************************************************/
 
 #include <stdio.h>
@@ -40,57 +43,44 @@
 #include <sjwlib.h>
 #include <atlantisboxmodel.h>
 #include <atUtilLib.h>
+#include <atPhysics.h>
 
 /* Prototypes for routines used here */
 void    advect_up(Box *bp, double dist, int n, double **newwc);
 double  advect_down(Box *bp, double dist, int n, double **newwc);
 
-void settleBMwc(MSEBoxModel *bm, double ***newwc, double ***newsed, FILE *llogfp)
+/* Settle all the tracers of one box and deposit the sinking material to its
+ * sediments. Everything here only touches box b, so boxes can be done in parallel.
+ */
+static void settleBox(MSEBoxModel *bm, int b, double **newwc, double **newsed, FILE *llogfp)
 {
-    int b = 0;
+    Box *bp = &bm->boxes[b];
+    atPhysicsStructure *pm = bm->atPhysicsModule;
+    double *masstosed = pm->masstosed[b];
     int n = 0;
+    int j = 0;
 
-	if( verbose )
-		fprintf(stderr,"Entering settleBMk\n");
+    /* Set mass to be deposited to sediments to zero. Only tracers in the
+     * settling list are ever set so the rest stay zero */
+    for(j=0; j<pm->nsettle; j++)
+        masstosed[pm->settleid[j]] = 0.0;
 
-    /* Allocate memory for mass to be deposited to sediments.
-     * WARNING - this is only done once, so may fail
-     * if several different MSEBoxModels are active
-     */
-    if( bm->atPhysicsModule->masstosed == NULL ){
-    	bm->atPhysicsModule->masstosed = (double **)alloc2d(bm->ntracer,bm->nbox);
-	}
-
-    /* Set mass to be deposited to sediments to zero */
-    for(b=0; b<bm->nbox; b++)
-    	for(n=0; n<bm->ntracer; n++)
-    		bm->atPhysicsModule->masstosed[b][n] = 0.0;
+    /* Loop over each tracer that can be moved and has a non zero settling
+     * velocity - diagnostic and neutrally buoyant tracers are not in the list */
+    for(j=0; j<pm->nsettle; j++) {
+		double v;
 
-    /* Loop over each tracer */
-    for(n=0; n<bm->ntracer; n++) {
-		double v = bm->tinfo[n].svel + bm->tinfo[n].xvel;
-
-        //fprintf(bm->logFile,"Time: %e doing %s with v: %e\n", bm->dayt, bm->tinfo[n].name, v);
-        
-        
-		/* Skip diagnostic tracers */
-		if( (!bm->tinfo[n].inwc && !bm->tinfo[n].insed) || !bm->tinfo[n].can_be_moved)
-			continue;
-
-		/* Skip tracers with zero settling velocity */
-        if( v == 0.0 )
-			continue;
+		n = pm->settleid[j];
+		v = bm->tinfo[n].svel + bm->tinfo[n].xvel;
 
 			/* If settling velocity is positive,
 			 * particles are buoyant and rise up through
 			 * the water column. There is no exchange with
 			 * the sediments in this case
 			 */
-		else if( v > 0.0 ) {
-			/* Loop over each box */
-			for(b=0; b<bm->nbox; b++)
-			if( bm->boxes[b].type != BOUNDARY && bm->boxes[b].type)
-				advect_up(&bm->boxes[b],v*bm->dt,n,newwc[b]);
+		if( v > 0.0 ) {
+			if( bp->type != BOUNDARY && bp->type)
+				advect_up(bp,v*bm->dt,n,newwc);
 		}
 
 			/* If settling velocity is negative,
@@ -107,10 +97,8 @@ void settleBMwc(MSEBoxModel *bm, double ***newwc, double ***newsed, FILE *llogfp
 		 * J Hydraulic Res.
 			 */
 		else if( v < 0.0 ) {  /* Sinking particles */
-			/* Loop over each box */
-			for(b=0; b<bm->nbox; b++) {
-			if( bm->boxes[b].type != BOUNDARY && bm->boxes[b].type != LAND) {
-				double m = advect_down(&bm->boxes[b],-v*bm->dt,n,newwc[b]);
+			if( bp->type != BOUNDARY && bp->type != LAND) {
+				double m = advect_down(bp,-v*bm->dt,n,newwc);
 
 
 				if((bm->debug == debug_deposit) && (bm->dayt > bm->checkstart)){
@@ -119,20 +107,53 @@ void settleBMwc(MSEBoxModel *bm, double ***newwc, double ***newsed, FILE *llogfp
 
 				if( bm->tinfo[n].insed ){
 					/* Store mass to be deposited to sediment layer */
-					bm->atPhysicsModule->masstosed[b][n] = m;
+					masstosed[n] = m;
 				}
 				else
 				/* Retain in lowest water column layer */
-				newwc[b][0][n] += m/bm->boxes[b].volume[0];
-			}
+				newwc[0][n] += m/bp->volume[0];
 			}
 		}
     }
 
-	 /* Loop over each box, depositing material to sediments */
+	/* Deposit material to sediments */
+	if( bp->type != BOUNDARY && bp->type != LAND)
+		deposit(bm,bp,masstosed,newwc,newsed,llogfp);
+}
+
+void settleBMwc(MSEBoxModel *bm, double ***newwc, double ***newsed, FILE *llogfp)
+{
+    int b = 0;
+#ifdef _OPENMP
+    int settle_threads = Util_Get_Num_Threads(bm);
+#endif
+
+	if( verbose )
+		fprintf(stderr,"Entering settleBMk\n");
+
+    /* Allocate memory for mass to be deposited to sediments.
+     * WARNING - this is only done once, so may fail
+     * if several different MSEBoxModels are active
+     */
+    if( bm->atPhysicsModule->masstosed == NULL ){
+    	bm->atPhysicsModule->masstosed = (double **)alloc2d(bm->ntracer,bm->nbox);
+	}
+
+    /* Tracers that settle or rise */
+    setupPhysicsTracerLists(bm);
+
+    /* Loop over each box. Each tracer in each box settles independently of the
+     * others, so the results are the same whatever the number of threads.
+     */
+#ifdef _OPENMP
+    /* Keep the deposition debugging output in box order */
+    if((bm->debug == debug_deposit) && (bm->dayt > bm->checkstart))
+        settle_threads = 1;
+
+#pragma omp parallel for schedule(dynamic) num_threads(settle_threads) if(settle_threads > 1)
+#endif
     for(b=0; b<bm->nbox; b++)
-		if( bm->boxes[b].type != BOUNDARY && bm->boxes[b].type != LAND)
-			deposit(bm,&bm->boxes[b],bm->atPhysicsModule->masstosed[b],newwc[b],newsed[b],llogfp);
+        settleBox(bm, b, newwc[b], newsed[b], llogfp);
 
     /* Re-calculate layer coordinates */
     layer_coords(bm, llogfp);
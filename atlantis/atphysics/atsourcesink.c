@@ -65,6 +65,7 @@
 #include <atlantisboxmodel.h>
 #include <atEcologyLib.h>
 #include <atUtilLib.h>
+#include <atPhysics.h>
 
 /* Prototypes */
 double fw_area_input(MSEBoxModel *bm, TimeSeries *ts, int id, double scale, double ***newwattr);
@@ -84,6 +85,7 @@ void sourceSink(MSEBoxModel *bm, double ***newwattr, FILE *llogfp)
 	int s = 0;
 	int i = 0;
 	int index;
+	int maxnv;
 	int variableIndex; /* The index of the point source variable in the change arrays. This allows for the
 	 fact that we are not going to scale the time variable - so there is no space for it in the change arrays */
 	double vol = 0;
@@ -103,8 +105,19 @@ void sourceSink(MSEBoxModel *bm, double ***newwattr, FILE *llogfp)
 	if (!bm->atPhysicsModule->inpfp) {
 		bm->atPhysicsModule->inpfp = initInputsFile(bm);
 		bm->atPhysicsModule->totinp = alloc1d(bm->ntracer);
+
+		/* One buffer for the point source/sink values, big enough for any of the series */
+		maxnv = 1;
+		for (s = 0; s < bm->npss; s++) {
+			if (bm->pss[s].ts.nv > maxnv)
+				maxnv = bm->pss[s].ts.nv;
+		}
+		bm->atPhysicsModule->pssval = alloc1d(maxnv);
 	}
 
+	/* Water column tracers (not water) diluted by inflows */
+	setupPhysicsTracerLists(bm);
+
 	/* Set total inputs to zero */
 	for (i = 0; i < bm->ntracer; i++)
 		bm->atPhysicsModule->totinp[i] = 0;
@@ -116,13 +129,17 @@ void sourceSink(MSEBoxModel *bm, double ***newwattr, FILE *llogfp)
 		int k = pss->e3;
 		Box *bp = &bm->boxes[b];
 		double vol = bp->volume[k];
+		double *pssval = bm->atPhysicsModule->pssval;
         
         if (bp->type == BOUNDARY || bp->type == LAND)
 			continue;
 
+		/* Evaluate all of the point source/sink variables at once */
+		tsEvalAllR(&pss->ts, ask_t, pss->rewindid, pssval);
+
 		if (pss->watertsid >= 0) {
 			/* Water is associated with this source/sink. */
-			double val = tsEvalR(&pss->ts, pss->watertsid, ask_t, pss->rewindid);
+			double val = pssval[pss->watertsid];
 
 			double wvol = bm->dt * val;
 
@@ -144,17 +161,16 @@ void sourceSink(MSEBoxModel *bm, double ***newwattr, FILE *llogfp)
 					int n = pss->vid[i];
 					/* Add mass if it is a valid index */
 					if (n >= 0 && bm->tinfo[n].inwc && n != bm->waterid) {
-						double mass = wvol * tsEvalR(&pss->ts, i, ask_t, pss->rewindid);
+						double mass = wvol * pssval[i];
 						bm->atPhysicsModule->totinp[n] += mass;
 						newwattr[b][k][n] += mass / vol;
 					}
 				}
-				/* Now loop over all model tracers to correct concentrations
+				/* Now loop over all water column tracers to correct concentrations
 				 * due to change in volume
 				 */
-				for (n = 0; n < bm->ntracer; n++)
-					if (bm->tinfo[n].inwc && n != bm->waterid)
-						newwattr[b][k][n] *= vol / (vol + wvol);
+				for (n = 0; n < bm->atPhysicsModule->nvdiff; n++)
+					newwattr[b][k][bm->atPhysicsModule->vdiffid[n]] *= vol / (vol + wvol);
 			}
 			/* Adjust box volumes and dz. Note that if water is flowing
 			 * out (a sink), then this is all that needs to be done, as
@@ -176,7 +192,7 @@ void sourceSink(MSEBoxModel *bm, double ***newwattr, FILE *llogfp)
 				int n = pss->vid[i];
 				/* Add source/sink if it is a valid index */
 				if (n >= 0 && bm->tinfo[n].inwc && n != bm->waterid) {
-					double val = tsEvalR(&pss->ts, i, ask_t, pss->rewindid);
+					double val = pssval[i];
 
 					double mass = bm->dt * val;
 
@@ -263,15 +279,21 @@ void sourceSink(MSEBoxModel *bm, double ***newwattr, FILE *llogfp)
 	 */
 	if (bm->tr_areainp) {
 		int *tsid = i_alloc1d(bm->ntracer);
+		int *trid = i_alloc1d(bm->ntracer);
+		int ninp = 0;
 		int b;
-		int n;
-
-		/* Make list of tracers in input time series */
-		for (n = 0; n < bm->ntracer; n++) {
-			if (bm->tinfo[n].inwc && n != bm->waterid)
-				tsid[n] = tsIndex(bm->tr_areainp, bm->tinfo[n].name);
-			else
-				tsid[n] = -1;
+		int j;
+
+		/* Make list of water column tracers in input time series */
+		for (j = 0; j < bm->atPhysicsModule->nvdiff; j++) {
+			int n = bm->atPhysicsModule->vdiffid[j];
+			int id = tsIndex(bm->tr_areainp, bm->tinfo[n].name);
+
+			if (id >= 0) {
+				trid[ninp] = n;
+				tsid[ninp] = id;
+				ninp++;
+			}
 		}
 
 		/* Loop over each box */
@@ -286,18 +308,17 @@ void sourceSink(MSEBoxModel *bm, double ***newwattr, FILE *llogfp)
 			if (bm->boxes[b].type == BOUNDARY || bm->boxes[b].type == LAND)
 				continue;
 
-			/* Loop over each tracer */
-			for (n = 0; n < bm->ntracer; n++) {
-				if (tsid[n] >= 0) {
-					double mass = a * bm->dt * tsEvalXY(bm->tr_areainp, tsid[n], ask_t, x, y);
-					bm->atPhysicsModule->totinp[n] += mass;
-					newwattr[b][k][n] += mass / vol;
-				}
+			/* Loop over each tracer with an input */
+			for (j = 0; j < ninp; j++) {
+				double mass = a * bm->dt * tsEvalXY(bm->tr_areainp, tsid[j], ask_t, x, y);
+				bm->atPhysicsModule->totinp[trid[j]] += mass;
+				newwattr[b][k][trid[j]] += mass / vol;
 			}
 		}
 
-		/* Free tracer id list */
+		/* Free tracer id lists */
 		i_free1d(tsid);
+		i_free1d(trid);
 	}
     
     /* Re-calculate layer coordinates */
@@ -335,8 +356,11 @@ void solarIrradiance(MSEBoxModel *bm, double ***newwattr, FILE *llogfp) {
 				}
 			}
 		} else {
+			/* Not spatial, so the same value for every box */
+			double swr = tsEvalR(bm->swr, bm->swr_id, ask_t, bm->swr_rewindid);
+
 			for (b = 0; b < bm->nbox; b++) {
-				bm->boxes[b].swr = tsEvalR(bm->swr, bm->swr_id, ask_t, bm->swr_rewindid);
+				bm->boxes[b].swr = swr;
 				if (!(_finite(bm->boxes[b].swr))) {
 					quit("sourceSink - box: %d, Invalid value calculated for solar radiation 2 - ask_t: %e x: %e y: %e swr_id: %d\n", b, ask_t, bm->boxes[b].inside.x, bm->boxes[b].inside.y, bm->swr_id);
 				}
@@ -372,6 +396,8 @@ double fw_area_input(MSEBoxModel *bm, TimeSeries *ts, int id, double scale, doub
 	if (!bm || !ts)
 		return (0.0);
 
+	setupPhysicsTracerLists(bm);
+
 	for (b = 0; b < bm->nbox; b++) {
 		Box *bp = &bm->boxes[b];
 		int k = bp->nz - 1;
@@ -379,7 +405,9 @@ double fw_area_input(MSEBoxModel *bm, TimeSeries *ts, int id, double scale, doub
 		double y = bp->inside.y;
 		double vol = bp->volume[k];
 		double wvol = bp->area * bm->dt * tsEvalXY(ts, id, ask_t, x, y) * scale;
-		int n;
+		double *val = newwattr[b][k];
+		int *vid = bm->atPhysicsModule->vdiffid;
+		int j;
 
 		/* Skip boundary boxes */
 		if (bm->boxes[b].type == BOUNDARY || bm->boxes[b].type == LAND)
@@ -389,10 +417,9 @@ double fw_area_input(MSEBoxModel *bm, TimeSeries *ts, int id, double scale, doub
 		if (wvol <= -vol)
 			quit("fw_area_input: Top layer would dry due to %s in box %d\n", ts->varname[id], b);
 
-		for (n = 0; n < bm->ntracer; n++) {
-			if (bm->tinfo[n].inwc && n != bm->waterid)
-				newwattr[b][k][n] *= vol / (vol + wvol);
-		}
+		/* Dilute the water column tracers (not water) */
+		for (j = 0; j < bm->atPhysicsModule->nvdiff; j++)
+			val[vid[j]] *= vol / (vol + wvol);
 
 		bp->volume[k] += wvol;
 		bp->dz[k] = bp->volume[k] / bp->area;
@@ -46,6 +46,7 @@
 #include <sjwlib.h>
 #include <atlantisboxmodel.h>
 #include <atUtilLib.h>
+#include <atPhysics.h>
 
 /* Prototypes */
 void get_hydro(MSEBoxModel *bm);
@@ -54,11 +55,12 @@ void writeExports(FILE *fp, MSEBoxModel *bm, double ***dtr);
 
 /*********************************************************************/
 void transportBM(MSEBoxModel *bm, double ***newwc, FILE *llogfp) {
+	atPhysicsStructure *pm = bm->atPhysicsModule;
 	int totnz, diffnz;
 	int b;
 	int k, startk;
 	long d;
-	int n;
+	int n, j;
 	double k_transcale, k_transcale_final, exchange_amt, e;
 	double tleft = bm->dt;
 
@@ -72,6 +74,9 @@ void transportBM(MSEBoxModel *bm, double ***newwc, FILE *llogfp) {
 	if (!bm->atPhysicsModule->expfp)
 		bm->atPhysicsModule->expfp = initExportFile(bm);
 
+	/* Tracers carried by the exchanges and those whose concentration is updated */
+	setupPhysicsTracerLists(bm);
+
 	/* Loop while more time remains in this transport time step */
 	while (tleft > 0) {
 		double dt;
@@ -83,17 +88,21 @@ void transportBM(MSEBoxModel *bm, double ***newwc, FILE *llogfp) {
 		/* Calculate time step allowed */
 		dt = min(tleft, bm->hd.tleft);
 
-		/* Set tracer and volume changes to zero and reset source sink info */
+		/* Set tracer and volume changes to zero and reset source sink info.
+		 * Tracers not in the advected list are never changed so stay zero.
+		 */
 		for (b = 0; b < bm->nbox; b++) {
 			for (k = 0; k < bm->wcnz; k++) {
+				double *dtrk = dtr[b][k];
+
 				dvol[b][k] = 0.0;
 				bm->boxes[b].hdsource[k] = 0.0;
 				bm->boxes[b].hdsink[k] = 0.0;
 				bm->boxes[b].eflux[k] = 0.0;
                 if (bm->vert_mix != 1)
                     bm->boxes[b].vflux[k] = 0.0;  // Note zeroed in vertical_mixing() if vert_mix == 1
-				for (n = 0; n < bm->ntracer; n++)
-					dtr[b][k][n] = 0.0;
+				for (j = 0; j < pm->nadv; j++)
+					dtrk[pm->advid[j]] = 0.0;
 			}
 		}
 
@@ -252,6 +261,10 @@ void transportBM(MSEBoxModel *bm, double ***newwc, FILE *llogfp) {
                                 /* This destination cell doesn't exist - log an error and continue */
                                 fprintf(llogfp,"WARNING - trying to advect water (amt: %e) to nonexistent box-layer combination (%d, %d) from box-layer (%d, %d) at time: %e (TofY: %d)\n", exchange_amt, bb, kk, b, k, bm->dayt, bm->TofY);
                             } else {
+                                double *src = newwc[b][startk];
+                                double *dtrdest = dtr[bb][kk];
+                                double *dtrsrc = dtr[b][startk];
+
                                 dvol[bb][kk] += e;
                                 dvol[b][startk] -= e;
 
@@ -260,14 +273,11 @@ void transportBM(MSEBoxModel *bm, double ***newwc, FILE *llogfp) {
                                     fprintf(llogfp,"Time: %e box%d-%d sending %.10g to box%d-%d so source vol %.10g and sink vol %.10g exchange_amt: %.10g k_transcale_final: %.10g dt: %.10g bm->hd.dt: %.10g\n", bm->dayt, b, startk, e, bb, kk, dvol[b][startk], dvol[bb][kk], exchange_amt, k_transcale_final, dt, bm->hd.dt);
                                 **/
                             
-                                /* Do the same for each tracer */
-                                for (n = 0; n < bm->ntracer; n++) {
-                                    if (bm->tinfo[n].partic && !bm->tinfo[n].passive) {
-                                        /* Do nothng */
-                                    } else {
-                                        dtr[bb][kk][n] += e * newwc[b][startk][n];
-                                        dtr[b][startk][n] -= e * newwc[b][startk][n];
-                                    }
+                                /* Do the same for each tracer carried by the flow */
+                                for (j = 0; j < pm->nadv; j++) {
+                                    n = pm->advid[j];
+                                    dtrdest[n] += e * src[n];
+                                    dtrsrc[n] -= e * src[n];
 
                                     /**
                                     if((bb == bm->checkbox || b == bm->checkbox)) {
@@ -335,57 +345,41 @@ void transportBM(MSEBoxModel *bm, double ***newwc, FILE *llogfp) {
                 }
                 */
 
-				/* New concentration for each water column tracer */
-				for (n = 0; n < bm->ntracer; n++) {
-					if (bm->tinfo[n].inwc) {
-						int can_be_moved = 1;
-						double newwat = 0;
-
-						/* Check if flag sensitive and then if actually active */
-						if ((bm->do_availflag && !bm->tinfo[n].flagid) || (bm->tinfo[n].partic && !bm->tinfo[n].passive) || !bm->tinfo[n].can_be_moved || !bm->tinfo[n].isUsed){
-							can_be_moved = 0;
-						}
-
-						//if(strcmp(bm->tinfo[n].name, "Rugosity") == 0)
-                        //    fprintf(bm->logFile, "Time %e %d-%d Rugosity starts %e ", bm->dayt, b, k, newwc[b][k][n]);
-						//	printf("trying to transport %s with flagid %d\n", bm->tinfo[n].name, bm->tinfo[n].flagid);
-
-						if (can_be_moved) {
-							//if(strcmp(bm->tinfo[n].name, "MicroNut") == 0)
-							//	printf("transporting %s\n", bm->tinfo[n].name);
-
-							newwat = (newwc[b][k][n] * oldvol + dtr[b][k][n]) / newvol;
-							if (newwat < 0 && newwc[b][k][n] != bm->min_pool) {
-								//printf("transport: %s negative (was %.10g, now %.10g) at box %d layer %d\noldvol = %.10g, newvol = %.10g, dtr = %.10g\n",bm->tinfo[n].name,newwc[b][k][n],newwat,b,k,oldvol,newvol,dtr[b][k][n]);
-								warn("transport: %s negative (was %.10g, now %.10g so zeroing out) at box %d layer %d\noldvol = %.10g, newvol = %.10g, dtr = %.10g\n",
-										bm->tinfo[n].name, newwc[b][k][n], newwat, b, k, oldvol, newvol, dtr[b][k][n]);
-                                
-                                /*
-                                fprintf(llogfp, "transport: %s was %.10g, now %.10g at box %d layer %d oldvol = %.10g, newvol = %.10g, dtr = %.10g, dvol = %.10g\n", bm->tinfo[n].name, newwc[b][k][n], newwat, b, k, oldvol, newvol, dtr[b][k][n], dvol[b][k]);
-                                */
-                                newwat = 0.0;
-							}
-                            
-                            /**
-                            if((b == bm->checkbox) && (strcmp(bm->tinfo[n].name, "SED") == 0)) {
-                                fprintf(llogfp, "Time: %e box %d-%d tracer: %d transport of %s was %f, now %f at oldvol = %f, newvol = %f, dtr = %f, dvol = %f\n", bm->dayt, b, k, n, bm->tinfo[n].name, newwc[b][k][n], newwat, oldvol, newvol, dtr[b][k][n], dvol[b][k]);
-                            }
-                            **/
-
-							/**
-                            if(b == bm->checkbox)
-                                fprintf(bm->logFile, "transport: %s was %.10g, now %.10g at box %d layer %d\noldvol = %.10g, newvol = %.10g, dtr = %.10g (can_be_moved: %d)\n",
-                                       bm->tinfo[n].name,newwc[b][k][n],newwat,b,k,oldvol,newvol,dtr[b][k][n], bm->tinfo[n].can_be_moved);
-							 **/
-						} else{
-							newwat = newwc[b][k][n];
-						}
-                        
-                        //if(strcmp(bm->tinfo[n].name, "Rugosity") == 0)
-                        //    fprintf(bm->logFile, "ends %e\n", newwc[b][k][n]);
+				/* New concentration for each water column tracer that can be moved
+				 * (active, in use and not a non passive particulate). The others keep
+				 * their concentration.
+				 */
+				for (j = 0; j < pm->ntrans; j++) {
+					double newwat = 0;
+
+					n = pm->transid[j];
+
+					//if(strcmp(bm->tinfo[n].name, "Rugosity") == 0)
+					//    fprintf(bm->logFile, "Time %e %d-%d Rugosity starts %e ", bm->dayt, b, k, newwc[b][k][n]);
+					//	printf("trying to transport %s with flagid %d\n", bm->tinfo[n].name, bm->tinfo[n].flagid);
+
+					newwat = (newwc[b][k][n] * oldvol + dtr[b][k][n]) / newvol;
+					if (newwat < 0 && newwc[b][k][n] != bm->min_pool) {
+						//printf("transport: %s negative (was %.10g, now %.10g) at box %d layer %d\noldvol = %.10g, newvol = %.10g, dtr = %.10g\n",bm->tinfo[n].name,newwc[b][k][n],newwat,b,k,oldvol,newvol,dtr[b][k][n]);
+						warn("transport: %s negative (was %.10g, now %.10g so zeroing out) at box %d layer %d\noldvol = %.10g, newvol = %.10g, dtr = %.10g\n",
+								bm->tinfo[n].name, newwc[b][k][n], newwat, b, k, oldvol, newvol, dtr[b][k][n]);
+
+						/*
+						fprintf(llogfp, "transport: %s was %.10g, now %.10g at box %d layer %d oldvol = %.10g, newvol = %.10g, dtr = %.10g, dvol = %.10g\n", bm->tinfo[n].name, newwc[b][k][n], newwat, b, k, oldvol, newvol, dtr[b][k][n], dvol[b][k]);
+						*/
+						newwat = 0.0;
+					}
 
-						newwc[b][k][n] = newwat;
+					/**
+					if((b == bm->checkbox) && (strcmp(bm->tinfo[n].name, "SED") == 0)) {
+						fprintf(llogfp, "Time: %e box %d-%d tracer: %d transport of %s was %f, now %f at oldvol = %f, newvol = %f, dtr = %f, dvol = %f\n", bm->dayt, b, k, n, bm->tinfo[n].name, newwc[b][k][n], newwat, oldvol, newvol, dtr[b][k][n], dvol[b][k]);
 					}
+					**/
+
+					//if(strcmp(bm->tinfo[n].name, "Rugosity") == 0)
+					//    fprintf(bm->logFile, "ends %e\n", newwc[b][k][n]);
+
+					newwc[b][k][n] = newwat;
 				}
 				/* Store new volume and dz values */
 				bp->volume[k] = newvol;
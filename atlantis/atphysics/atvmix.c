@@ -29,6 +29,10 @@
 
  void routine_name(int blah, double blahblah)
 
+ Mix all the dissolved tracers of a box in one sweep and spread
+ the boxes across threads. Added the optional implicit (backward
+ Euler) mixing mode, switched on by vert_mix_implicit.
+
  *********************************************************************/
 
 #include <stdio.h>
@@ -38,22 +42,195 @@
 #include <sjwlib.h>
 #include <atlantisboxmodel.h>
 #include <atUtilLib.h>
+#include <atPhysics.h>
+
+/* Number of work arrays (each wcnz+1 long) used per thread */
+#define VMIX_NWORK 5
+
+/* Explicit slab mixing of all the dissolved tracers in a box. Each tracer goes
+ * through exactly the same steps as when it was mixed on its own, the layers are
+ * just the outer loop so each step is applied to every tracer in turn.
+ */
+static void vmixBoxSlab(MSEBoxModel *bm, Box *bp, double **wc, double *mrate, double *work)
+{
+	atPhysicsStructure *pm = bm->atPhysicsModule;
+	int k, j;
+	int o2j = pm->vmixO2id;
+	double *cvolup = work;						/* Exchange volume when mixing up */
+	double *cvoldown = &work[bm->wcnz + 1];		/* Exchange volume when Oxygen is richer above */
+	double *o2down = &work[2 * (bm->wcnz + 1)];	/* 1 if Oxygen was richer above */
+	double cvol, wvol, lvol;
+
+	/* Calculate exchanges  - ignoring bottom most water column
+	 layer as obviously can't have upwelling through the seafloor */
+	for (k = 1; k < bp->nz; k++) {
+		/* Volume of current cell */
+		wvol = bp->volume[k];
+		/* Volume of cell below */
+		lvol = bp->volume[k - 1];
+		/* Volume injected */
+		cvol = mrate[k] * bm->dt;
+
+		/* Check amount to exchange is not more than in the cells - the
+		 Oxygen special case checks the two cells in the other order */
+		cvolup[k] = cvol;
+		if (lvol < cvolup[k])
+			cvolup[k] = lvol - small_num;
+		if (wvol < cvolup[k])
+			cvolup[k] = wvol - small_num;
+
+		cvoldown[k] = cvol;
+		if (wvol < cvoldown[k])
+			cvoldown[k] = wvol - small_num;
+		if (lvol < cvoldown[k])
+			cvoldown[k] = lvol - small_num;
+
+		o2down[k] = 0.0;
+
+		/* Slab mixing - crude but necessary unless
+		 refined vertical fluxes are available */
+		for (j = 0; j < pm->nvmix; j++) {
+			int n = pm->vmixid[j];
+			double *cu = &wc[k][n];
+			double *cl = &wc[k - 1][n];
+
+			if ((j == o2j) && (*cu > *cl)) {
+				cvol = cvoldown[k];
+				o2down[k] = 1.0;
+
+				/* New concentration in current cell
+				 (average of what's there and what's mixed back) */
+				*cu = ((wvol - cvol) * (*cu) + (*cl) * cvol) / (wvol + small_num);
+			} else {
+				cvol = cvolup[k];
+
+				/* New concentration in current cell
+				 (average of what's there and what's mixed back) */
+				*cu = (cvol * (*cl) + (wvol - cvol) * (*cu)) / (wvol + small_num);
+			}
+
+			/* New concentration in sink cell
+			 (average of what's there and what's transferred amount added) */
+			*cl = ((lvol - cvol) * (*cl) + cvol * (*cu)) / (lvol + small_num);
+		}
+	}
+
+	/* Update vertical flux trackers - tracer by tracer as the exchanges were originally added */
+	for (j = 0; j < pm->nvmix; j++) {
+		for (k = 1; k < bp->nz; k++) {
+			if ((j == o2j) && o2down[k]) {
+				bp->vflux[k - 1] += cvoldown[k];
+				bp->vflux[k] -= cvoldown[k];
+			} else {
+				bp->vflux[k] += cvolup[k];
+				bp->vflux[k - 1] -= cvolup[k];
+			}
+		}
+	}
+}
+
+/* Implicit (backward Euler) mixing of all the dissolved tracers in a box.
+ *
+ * The exchange volume q[k] = mrate[k] * dt is swapped between layers k-1 and k,
+ * with the new concentrations used for the exchanged water:
+ *
+ *   V[k] c'[k] = V[k] c[k] + q[k] (c'[k-1] - c'[k]) + q[k+1] (c'[k+1] - c'[k])
+ *
+ * This conserves mass and stays stable whatever the size of q, so long time steps
+ * don't need the exchange to be capped by the cell volumes. The tri-diagonal matrix
+ * is the same for every tracer, so it is factorised once and all the tracers are
+ * then solved together.
+ */
+static void vmixBoxImplicit(MSEBoxModel *bm, Box *bp, double **wc, double *mrate, double *work)
+{
+	atPhysicsStructure *pm = bm->atPhysicsModule;
+	int k, j;
+	int nz = bp->nz;
+	int o2j = pm->vmixO2id;
+	double *q = work;							/* Exchange volume across the bottom of layer k */
+	double *ud = &work[bm->wcnz + 1];			/* Factorised upper diagonal */
+	double *div = &work[2 * (bm->wcnz + 1)];	/* Factorised diagonal */
+	double *o2down = &work[3 * (bm->wcnz + 1)];	/* 1 if Oxygen was richer above */
+	double vol;
+
+	if (nz < 2)
+		return;
+
+	/* Nothing is exchanged across the seafloor or the surface */
+	q[0] = 0.0;
+	for (k = 1; k < nz; k++)
+		q[k] = mrate[k] * bm->dt;
+	q[nz] = 0.0;
+
+	/* Factorise the matrix. Rows are in volume units: the diagonal is
+	 V[k] + q[k] + q[k+1] and the off diagonals -q[k] and -q[k+1] */
+	div[0] = bp->volume[0] + small_num + q[1];
+	for (k = 1; k < nz; k++) {
+		ud[k] = -q[k] / div[k - 1];
+		div[k] = bp->volume[k] + small_num + q[k] + q[k + 1] + q[k] * ud[k];
+	}
+
+	/* Direction of the Oxygen exchange for the flux trackers, before mixing */
+	if (o2j >= 0) {
+		for (k = 1; k < nz; k++)
+			o2down[k] = (wc[k][pm->vmixid[o2j]] > wc[k - 1][pm->vmixid[o2j]]) ? 1.0 : 0.0;
+	}
+
+	/* Forward sweep - the right hand side is the old mass in each layer */
+	vol = bp->volume[0] + small_num;
+	for (j = 0; j < pm->nvmix; j++)
+		wc[0][pm->vmixid[j]] = vol * wc[0][pm->vmixid[j]] / div[0];
+	for (k = 1; k < nz; k++) {
+		double *cu = wc[k];
+		double *cl = wc[k - 1];
+
+		vol = bp->volume[k] + small_num;
+		for (j = 0; j < pm->nvmix; j++) {
+			int n = pm->vmixid[j];
+			cu[n] = (vol * cu[n] + q[k] * cl[n]) / div[k];
+		}
+	}
+
+	/* Back substitution */
+	for (k = nz - 2; k >= 0; k--) {
+		double *cu = wc[k + 1];
+		double *cl = wc[k];
+
+		for (j = 0; j < pm->nvmix; j++) {
+			int n = pm->vmixid[j];
+			cl[n] -= ud[k + 1] * cu[n];
+		}
+	}
+
+	/* Update vertical flux trackers */
+	for (j = 0; j < pm->nvmix; j++) {
+		for (k = 1; k < nz; k++) {
+			if ((j == o2j) && o2down[k]) {
+				bp->vflux[k - 1] += q[k];
+				bp->vflux[k] -= q[k];
+			} else {
+				bp->vflux[k] += q[k];
+				bp->vflux[k - 1] -= q[k];
+			}
+		}
+	}
+}
 
 /* Forced vertical mixing in the water column -
  to simulate enhanced mixing due to upwelling */
 void vertical_mixing(MSEBoxModel *bm, double ***newval) {
 	int b = 0;
 	int k = 0;
-	int n = 0;
-	double eddy_scale = 0;
-	double *c = alloc1d(bm->wcnz);
-	double *mrate = alloc1d(bm->wcnz); /* Temporary storage of rates */
-	double cvol, wvol, lvol, seasonal_scale, vertmix_scale;
+	double **work;
+	double seasonal_scale;
 	double nowtime = bm->t / 86400.0;
+	int nthreads = Util_Get_Num_Threads(bm);
 
 	if (verbose)
 		fprintf(stderr, "Entering vertical_mixing\n");
 
+	setupPhysicsTracerLists(bm);
+
 	seasonal_scale = max(1.0, bm->mix_season_kz*sin(2.0*3.1415926*(nowtime-31.0)/365.0));
 
 	/* Initialise vertical flux tracker */
@@ -63,9 +240,20 @@ void vertical_mixing(MSEBoxModel *bm, double ***newval) {
 		}
 	}
 
-	/* Loop over each box */
+	/* Temporary storage of rates and work arrays for each thread */
+	work = Util_Alloc_Init_2D_Double(VMIX_NWORK * (bm->wcnz + 1), nthreads, 0.0);
+
+	/* Loop over each box - each box only updates its own tracers and flux trackers */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads) if(nthreads > 1) private(k)
+#endif
 	for (b = 0; b < bm->nbox; b++) {
 		Box *bp = &bm->boxes[b];
+		double *mrate = work[Util_Get_Thread_Num()];
+		double eddy_scale, vertmix_scale;
+
+		if (bp->type == BOUNDARY || bp->type == LAND)
+			continue;
 
 		/* Eddy scalar - including scaling the eddy contribution by the
 		 * scalar reflecting the weighting of eddy contribution
@@ -78,13 +266,12 @@ void vertical_mixing(MSEBoxModel *bm, double ***newval) {
 		if(eddy_scale < 0.0)
 			eddy_scale = 0.0;
 
-		
         /* Get vertical mixing scalar - if variable through time */
         vertmix_scale = 1.0;
         if (bm->use_VertMixfiles) {
             vertmix_scale = bp->vmix_scale;
         }
-        
+
         /* Calculate total mixing rate (m3 s-1) from lower layer up */
         for (k = 0; k < bp->nz; k++){
 			mrate[k] = bm->mix_injection * bp->vertmix * vertmix_scale * eddy_scale * seasonal_scale * bp->volume[k];
@@ -93,122 +280,16 @@ void vertical_mixing(MSEBoxModel *bm, double ***newval) {
 		/* Reset bottom rate to zero as can't upwell from the sediments here */
 		mrate[0] = 0.0;
 
-		if (bp->type != BOUNDARY && bp->type != LAND) {
-			/* Loop over each tracer */
-			for (n = 0; n < bm->ntracer; n++) {
-				/* Skip tracers not in water column and not dissolved */
-				if (!(bm->tinfo[n].dissol) || !(bm->tinfo[n].inwc) || (n == bm->waterid))
-					continue;
-
-				/* Collect tracer values for each layer */
-				for (k = 0; k < bp->nz; k++) {
-					c[k] = newval[b][k][n];
-
-					//if(strcmp(bm->tinfo[n].name, "NH3") == 0)
-					//	printf("day: %e, box: %d starting conc[%d]: %e\n", bm->dayt, b, k, c[k]);
-				}
-				/* Calculate exchanges  - ignoring bottom most water column
-				 layer as obviously can't have upwelling through the seafloor */
-				for (k = 1; k < bp->nz; k++) {
-					/* Volume of current cell */
-					wvol = bp->volume[k];
-					/* Volume of cell below */
-					lvol = bp->volume[k - 1];
-					/* Volume injected */
-					cvol = mrate[k] * bm->dt;
-
-					/* Slab mixing - crude but necessary unless
-					 refined vertical fluxes are available */
-					if ((strcmp(bm->tinfo[n].name, "Oxygen") == 0) && (c[k] > c[k - 1])) {
-						/* Check amount to exchange is not more than in the cells */
-						if (wvol < cvol)
-							cvol = wvol - small_num;
-						if (lvol < cvol)
-							cvol = lvol - small_num;
-
-						/* New concentration in current cell
-						 (average of what's there and what's mixed back) */
-						c[k] = ((wvol - cvol) * c[k] + c[k - 1] * cvol) / (wvol + small_num);
-
-						/* New concentration in sink cell
-						 (average of what's there and what's transferred amount added) */
-						c[k - 1] = ((lvol - cvol) * c[k - 1] + cvol * c[k]) / (lvol + small_num);
-
-						/* Update vertical flux trackers */
-						bp->vflux[k - 1] += cvol;
-						bp->vflux[k] -= cvol;
-
-						/**
-                        if(( b == 47 ) && (bm->newmonth))
-                            fprintf(bm->logFile,"day: %e, box: %d, %s conc[%d]: %e, conc[%d]: %e, cvol: %e, lvol: %e, wvol: %e, mrate: %e, vflux-%d: %e\n",
-                                    bm->dayt, b, bm->tinfo[n].name, k, c[k], k-1, c[k-1], cvol, lvol, wvol, mrate[k], k - 1, bp->vflux[k - 1]);
-						 **/
-					} else {
-						/* Check amount to exchange is not more than in the cells */
-						if (lvol < cvol)
-							cvol = lvol - small_num;
-						if (wvol < cvol)
-							cvol = wvol - small_num;
-
-						/* New concentration in current cell
-						 (average of what's there and what's mixed back) */
-						c[k] = (cvol * c[k - 1] + (wvol - cvol) * c[k]) / (wvol + small_num);
-
-						/* New concentration in sink cell
-						 (average of what's there and what's transferred amount added) */
-						c[k - 1] = ((lvol - cvol) * c[k - 1] + cvol * c[k]) / (lvol + small_num);
-
-						/* Update vertical flux trackers */
-						bp->vflux[k] += cvol;
-						bp->vflux[k - 1] -= cvol;
-
-						/**
-                        //if(!strcmp(bm->tinfo[n].name, "NH3"))
-                        //if(b == bm->checkbox)
-                        if(( b == 47 ) && (bm->newmonth))
-                            fprintf(bm->logFile, "day: %e, box: %d, %s conc[%d]: %e, conc[%d]: %e, cvol: %e, lvol: %e, wvol: %e, mrate: %e, vflux-%d: %e\n",
-                                    bm->dayt, b, bm->tinfo[n].name, k, c[k], k-1, c[k-1], cvol, lvol, wvol, mrate[k], k, bp->vflux[k]);
-                         **/
-						 
-					}
-
-					/**
-					 if(b == bm->checkbox)
-                         fprintf(bm->logFile, "day: %e, box: %d, %s conc[%d]: %e, conc[%d]: %e, cvol: %e, mrate: %e, \n",
-                              bm->dayt, b, bm->tinfo[n].name, k, c[k], k-1, c[k-1], cvol, mrate[k]);
-					 **/
-
-				}
-
-				/* If mixing with deep ocean allow replenishment lowest water column box */
-				if (bm->mix_deep && (bm->mix_deep_depth > bm->boxes[b].botz)) {
-					if (!strcmp(bm->tinfo[n].name, "NH3"))
-						c[0] = bp->bottNH;
-					else if (!strcmp(bm->tinfo[n].name, "NO3"))
-						c[0] = bp->bottNO;
-                    else if ((!strcmp(bm->tinfo[n].name, "Oxygen")) && bm->mix_deep_O2)
-                        c[0] = bp->bottO2;
-                    else if (!strcmp(bm->tinfo[n].name, "Si"))
-						c[0] = bp->bottSi;
-					else if (!strcmp(bm->tinfo[n].name, "MicroNut"))
-						c[0] = bp->bottFe;
-					else if (bm->track_atomic_ratio && (strcmp(bm->tinfo[n].name, "Phosphorus") == 0))
-						c[0] = bp->bottP;
-					else if (bm->track_atomic_ratio && (strcmp(bm->tinfo[n].name, "Carbon") == 0))
-						c[0] = bp->bottC;
-
-					/* Old code - used to just reset the value without mixing, could lead to overaccumulation
-					 c[0] = newval[b][0][n];
-					 */
-				}
-
-				/* Store new values */
-				for (k = 0; k < bp->nz; k++)
-					newval[b][k][n] = c[k];
-			}
-		}
+		if (bm->vert_mix_implicit)
+			vmixBoxImplicit(bm, bp, newval[b], mrate, &mrate[bm->wcnz + 1]);
+		else
+			vmixBoxSlab(bm, bp, newval[b], mrate, &mrate[bm->wcnz + 1]);
+
+		/* If mixing with deep ocean allow replenishment lowest water column box.
+		 Old code - used to just reset the value without mixing, could lead to overaccumulation */
+		if (bm->mix_deep && (bm->mix_deep_depth > bp->botz))
+			deepReplenishPhysics(bm, bp, newval[b][0], 1);
 	}
 
-	free1d(c);
-	free1d(mrate);
+	free2d(work);
 }
@@ -23,6 +23,8 @@
 /* Functions to deal with the allocation and freeing of the atPhysicsStructure */
 void allocatePhysicsModule(MSEBoxModel *bm);
 void freePhysicsStruct(MSEBoxModel *bm);
+void setupPhysicsTracerLists(MSEBoxModel *bm);
+void deepReplenishPhysics(MSEBoxModel *bm, Box *bp, double *botval, int dissol_only);
 
 void freeTempSalt(MSEBoxModel *bm);
 
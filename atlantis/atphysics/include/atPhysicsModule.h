@@ -14,6 +14,7 @@ typedef struct {
 	//@{
 	FILE *inpfp;
 	double *totinp;
+	double *pssval;		/* Point source/sink values for one source, sized for the largest series */
 	//@}
 
 	/**
@@ -24,4 +25,32 @@ typedef struct {
 	/* Transport files*/
 	FILE *expfp;
 
+	/**
+	 * @name Physics tracer lists. Set by setupPhysicsTracerLists() on the first call
+	 * to one of the physics routines, so the tracer flags and names are only checked
+	 * once and each routine only loops over the tracers it acts on.
+	 */
+	//@{
+	int *vdiffid;		/* Water column tracers that are diffused and diluted by inflows (not water) */
+	int nvdiff;
+	int *advid;			/* Tracers carried by the hydrodynamic exchanges (not non passive particulates) */
+	int nadv;
+	int *transid;		/* Water column tracers whose concentration is updated by transportBM() */
+	int ntrans;
+	int *hmixid;		/* Water column tracers mixed by filler_hdiffBMwc() */
+	int nhmix;
+	int *settleid;		/* Tracers that can be moved and have a non zero settling velocity */
+	int nsettle;
+	int *vmixid;		/* Dissolved water column tracers that are mixed by vertical_mixing() */
+	int nvmix;
+	int vmixO2id;		/* Position of Oxygen in vmixid, -1 if not there */
+	int deepNHid;		/* Tracers replenished from the deep ocean, -1 if not used */
+	int deepNOid;
+	int deepO2id;
+	int deepSiid;
+	int deepFeid;
+	int deepPid;
+	int deepCid;
+	//@}
+
 }atPhysicsStructure;
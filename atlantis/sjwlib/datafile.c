@@ -200,6 +200,7 @@ void dfSetRecord(Datafile *df, int varid) {
 
 	/* Copy over the record information. */
 	df->records = rv->data;
+	dfResetCursor(df);
 	df->nrecords = (int) df->dimensions[recdimid].size;
 	df->rec_name = rv->name;
 	df->rec_units = rv->units;
@@ -234,9 +235,18 @@ void dfSetRecord(Datafile *df, int varid) {
 	}
 }
 
+/* Number of intervals dfFindRecord steps forward from the last bracket
+ * before falling back on a binary chop */
+#define DF_CURSOR_STEPS 8
+
 /**
  * Find record indices which bracket a requested record value.
  *
+ * The last bracket found is kept in the datafile, so repeated requests
+ * for the same record value, or for a value a little further on, do not
+ * need a full search. The records are strictly increasing (see
+ * dfCheckRecords) so the bracket is the same whichever way it is found.
+ *
  * @param df pointer to datafile structure
  * @param r specified sample record
  * @param before index value just before record specified
@@ -247,6 +257,7 @@ int dfFindRecord(Datafile *df, double r, int *before, int *after, double *frac)
 	int imid;
 	int ilow = 0;
 	int ihigh = (int)df->nrecords - 1;
+	int ret = 1;
 
 	if (df->records == NULL) {
 		*before = 0;
@@ -254,35 +265,72 @@ int dfFindRecord(Datafile *df, double r, int *before, int *after, double *frac)
 		*frac = 0.0;
 		return (0);
 	}
-    
+
+	/* Same record value as last time */
+	if (df->cursor_ok && (r == df->cursor_r)) {
+		*before = df->cursor_before;
+		*after = df->cursor_after;
+		*frac = df->cursor_frac;
+		return (df->cursor_ret);
+	}
+
 	/* first check whether t is within the table range */
 	if (r <= df->records[ilow]) {
-		*before = ilow;
-		*after = ilow;
-		*frac = 0.0;
-		return (0);
-	}
-	if (r >= df->records[ihigh]) {
-		*before = ihigh;
-		*after = ihigh;
-		*frac = 0.0;
-		return (0);
-	}
+		ihigh = ilow;
+		ret = 0;
+	} else if (r >= df->records[ihigh]) {
+		ilow = ihigh;
+		ret = 0;
+	} else {
+		/* Step forward from the last bracket if r is at or after it */
+		if (df->cursor_ok && (df->cursor_ret == 1) && (df->cursor_before < ihigh) && (r >= df->records[df->cursor_before])) {
+			int steps = 0;
+
+			ilow = df->cursor_before;
+			while ((steps < DF_CURSOR_STEPS) && (ilow + 1 < ihigh) && (r >= df->records[ilow + 1])) {
+				ilow++;
+				steps++;
+			}
+			if (r < df->records[ilow + 1])
+				ihigh = ilow + 1;
+		}
 
-	/* perform binary chop to determine values either side of t */
-	while (ihigh - ilow > 1) {
-		imid = (ilow + ihigh) / 2;
-		if (r >= df->records[imid])
-			ilow = imid;
-		else
-			ihigh = imid;
+		/* perform binary chop to determine values either side of t */
+		while (ihigh - ilow > 1) {
+			imid = (ilow + ihigh) / 2;
+			if (r >= df->records[imid])
+				ilow = imid;
+			else
+				ihigh = imid;
+		}
 	}
 
 	/* Store results and return */
 	*before = ilow;
 	*after = ihigh;
-	*frac = (r - df->records[ilow]) / (df->records[ihigh] - df->records[ilow]);
-	return (1);
+	if (ret)
+		*frac = (r - df->records[ilow]) / (df->records[ihigh] - df->records[ilow]);
+	else
+		*frac = 0.0;
+
+	df->cursor_ok = 1;
+	df->cursor_r = r;
+	df->cursor_before = *before;
+	df->cursor_after = *after;
+	df->cursor_frac = *frac;
+	df->cursor_ret = ret;
+
+	return (ret);
+}
+
+/**
+ * Forget the last record bracket found by dfFindRecord. This must be
+ * called if the record values are changed.
+ *
+ * @param df pointer to datafile structure
+ */
+void dfResetCursor(Datafile *df) {
+	df->cursor_ok = 0;
 }
 
 /**
@@ -15,6 +15,9 @@
  original timeseries.c (see the CVS archive prior to
  18/06/97.
 
+ Added dfEvalAll to evaluate every variable for one record
+ value with a single record search.
+
  $Id: dfeval.c 3369 2012-08-29 06:16:46Z gor171 $
  */
 
@@ -29,6 +32,24 @@
 double df_interp_1d_inv_weight(Datafile *df, Variable *v, int record, double coords[]);
 double df_interp_linear(Datafile *df, Variable *v, int record, double coords[]);
 
+/* Interpolate a zero dimension variable between two records, allowing for missing values */
+static double df_eval_records(Variable *v, int before, int after, double frac) {
+	double val = v->missing;
+
+	/* Value exactly at before record */
+	if (frac == 0.0 && (fabs(v->data[before] - v->missing) > 1e-10)) {
+		val = v->data[before];
+		/* Value exactly at after record */
+	} else if (frac == 1.0 && (fabs(v->data[after] - v->missing) > 1e-10)) {
+		val = v->data[after];
+		/* Value inbetween - need to interpolate */
+	} else if ((fabs(v->data[after] - v->missing) > 1e-10) && (fabs(v->data[before] - v->missing) > 1e-10)) {
+		val = v->data[before] * (1.0 - frac) + v->data[after] * frac;
+	}
+
+	return (val);
+}
+
 /** Evaluate a zero dimension datafile variable for
  * a particular record value.
  *
@@ -43,7 +64,6 @@ double dfEval(Datafile *df, Variable *v, double r) {
 	double frac;
 	int before;
 	int after;
-	double val;
 
 	/* Sanity checks */
 	if (df == NULL)
@@ -64,20 +84,45 @@ double dfEval(Datafile *df, Variable *v, double r) {
 	}
 	dfReadRecords(df, v, before, after - before + 1);
 
-	val = v->missing;
+	return df_eval_records(v, before, after, frac);
+}
 
-	/* Value exactly at before record */
-	if (frac == 0.0 && (fabs(v->data[before] - v->missing) > 1e-10)) {
-		val = v->data[before];
-		/* Value exactly at after record */
-	} else if (frac == 1.0 && (fabs(v->data[after] - v->missing) > 1e-10)) {
-		val = v->data[after];
-		/* Value inbetween - need to interpolate */
-	} else if ((fabs(v->data[after] - v->missing) > 1e-10) && (fabs(v->data[before] - v->missing) > 1e-10)) {
-		val = v->data[before] * (1.0 - frac) + v->data[after] * frac;
-	}
+/** Evaluate all the zero dimension variables of a datafile for
+ * a particular record value. The record bracket is only found
+ * once, and each value is the same as dfEval() would give.
+ *
+ * @param df pointer to data file structure
+ * @param r record value
+ * @param vals returned values, one per variable. Variables
+ * with dimensions, or with no data, are given their missing value.
+ *
+ * @see quit() If anything goes wrong.
+ */
+void dfEvalAll(Datafile *df, double r, double *vals) {
+	double frac = 0.0;
+	int before = 0;
+	int after = 0;
+	int i;
 
-	return (val);
+	if (df == NULL)
+		quit("dfEvalAll: NULL Datafile pointer\n");
+
+	/* Find nearest records in table */
+	if (df->records != NULL)
+		dfFindRecord(df, r, &before, &after, &frac);
+
+	for (i = 0; i < df->nv; i++) {
+		Variable *v = &df->variables[i];
+
+		if ((v->nd > 0) || (v->data == NULL && ((df->records == NULL) || (!v->dim_as_record))))
+			vals[i] = v->missing;
+		else if ((df->records == NULL) || (!v->dim_as_record))
+			vals[i] = v->data[0];
+		else {
+			dfReadRecords(df, v, before, after - before + 1);
+			vals[i] = df_eval_records(v, before, after, frac);
+		}
+	}
 }
 
 double dfEvalEx(Datafile *df, Variable *v, double r) {
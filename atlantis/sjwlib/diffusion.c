@@ -9,7 +9,8 @@
 
     Returns:        void
     
-    Revisions:      none
+    Revisions:      Added diffusion1d_multi() which factorises the
+                    matrix once for several variables on the same grid.
 
     $Id: diffusion.c 2761 2011-07-01 04:35:25Z gor171 $
 
@@ -35,6 +36,10 @@ static double *Cp1;
 static double *rhs;
 static double *ud;
 
+/* Local temporary storage for diffusion1d_multi */
+static int max_mwork = -1;
+static double *mwork;
+
 
 /** Calculates 1 time step for the diffusion equation.
   *
@@ -152,6 +157,155 @@ diffusion1d(int n, double *c, double *xc, double *k,
 }
 
 
+/** Calculates 1 time step of the diffusion equation for several
+  * variables that share the same grid and diffusion coefficients.
+  *
+  * This is the same calculation as diffusion1d(), but the tri-diagonal
+  * matrix is only built and factorised once and then all nv variables
+  * are back substituted together, so each variable gives exactly the
+  * same values as a separate call to diffusion1d().
+  *
+  * @param n number of concentration values (layers)
+  * @param c concentration values, c[i][vid[j]] is variable j in layer i
+  * @param vid indices of the variables to diffuse in each c[i]
+  * @param nv number of variables
+  * @param work work array of at least DIFFUSION1D_MULTI_NWORK(n,nv)
+  *	 values, or NULL to use local storage. Each thread calling this
+  *	 routine at the same time must pass its own work array.
+  *
+  * The remaining arguments are as for diffusion1d().
+  */
+void
+diffusion1d_multi(int n, double **c, int *vid, int nv, double *xc, double *k,
+	    double *xk, double dt, double a, double *work)
+{
+    int i, j;
+    double dx;
+    double v;
+    double div;
+    double src_top, src_bot;
+    double *ri;
+    double *mCm1, *mC, *mCp1, *mdiv, *mud, *mlo, *mdi, *mup, *mrhs;
+
+    /* Sanity checks */
+    if( n < 1 )
+	quit("diffusion1d_multi: n < 1 (no points!)\n");
+    if( a < 0.0 || a > 1.0 )
+	quit("diffusion1d_multi: weight value must be in range [0,1]\n");
+    if( nv < 1 )
+	return;
+
+    /* Only 1 layer - simple calculation */
+    if( n == 1 ) {
+	for(j=0; j<nv; j++)
+	    c[0][vid[j]] += dt*(k[0]-k[1])/(xk[1]-xk[0] + small_num);
+	return;
+    }
+
+    /* Allocate temporary storage if necessary */
+    if( work == NULL ) {
+	if( DIFFUSION1D_MULTI_NWORK(n,nv) > max_mwork ) {
+	    if( mwork != NULL )
+		free1d(mwork);
+	    max_mwork = DIFFUSION1D_MULTI_NWORK(n,nv);
+	    mwork = alloc1d(max_mwork);
+	}
+	work = mwork;
+    }
+    mCm1 = work;
+    mC = &work[n+1];
+    mCp1 = &work[2*(n+1)];
+    mdiv = &work[3*(n+1)];
+    mud = &work[4*(n+1)];
+    mlo = &work[5*(n+1)];
+    mdi = &work[6*(n+1)];
+    mup = &work[7*(n+1)];
+    mrhs = &work[8*(n+1)];
+
+    /* Build the explicit weights and matrix for each row. The
+     * explicit weights mlo, mdi and mup are kept so the right hand
+     * side of every variable is formed in the same order as in
+     * diffusion1d().
+     */
+    i = 0;
+    dx = xk[i+1]-xk[i] + small_num;
+    v = dt*k[i+1]/((xc[i+1]-xc[i] + small_num)*dx);
+    mCm1[i] = 0.0;
+    mC[i] = 1 + a*v;
+    mCp1[i] = -a*v;
+    mlo[i] = 0.0;
+    mdi[i] = 1-(1-a)*v;
+    mup[i] = (1-a)*v;
+    src_top = dt*k[i]/dx;
+
+    for(i=1; i<n-1; i++) {
+	double dxi = xk[i+1]-xk[i] + small_num;
+	double vm = dt*k[i]/((xc[i]-xc[i-1] + small_num)*dxi);
+	double vp = dt*k[i+1]/((xc[i+1]-xc[i] + small_num)*dxi);
+
+	mCm1[i] = -a*vm;
+	mC[i] = 1.0 + a*(vm+vp);
+	mCp1[i] = -a*vp;
+	mlo[i] = (1-a)*vm;
+	mdi[i] = 1 - (1-a)*(vm+vp);
+	mup[i] = (1-a)*vp;
+    }
+
+    i = n-1;
+    dx = xk[i+1]-xk[i] + small_num;
+    v = dt*k[i]/((xc[i]-xc[i-1] + small_num)*dx);
+    mCm1[i] = -a*v;
+    mC[i] = 1 + a*v;
+    mCp1[i] = 0.0;
+    mlo[i] = (1-a)*v;
+    mdi[i] = 1-(1-a)*v;
+    mup[i] = 0.0;
+    src_bot = dt*k[i+1]/dx;
+
+    /* Factorise the matrix once */
+    div = mC[0];
+    if( div == 0.0 )
+	quit("diffusion1d_multi: zero first coefficient\n");
+    mdiv[0] = div;
+    for(i=1; i<n; i++) {
+	mud[i] = mCp1[i-1]/div;
+	div = mC[i]-mCm1[i]*mud[i];
+	if( div == 0.0 )
+	    quit("diffusion1d_multi: zero divisor\n");
+	mdiv[i] = div;
+    }
+
+    /* Right hand sides, from the old values of every variable */
+    ri = mrhs;
+    for(j=0; j<nv; j++)
+	ri[j] = mdi[0]*c[0][vid[j]] + mup[0]*c[1][vid[j]] + src_top;
+    for(i=1; i<n-1; i++) {
+	ri = &mrhs[i*nv];
+	for(j=0; j<nv; j++)
+	    ri[j] = mlo[i]*c[i-1][vid[j]]
+		+ mdi[i]*c[i][vid[j]]
+		+ mup[i]*c[i+1][vid[j]];
+    }
+    i = n-1;
+    ri = &mrhs[i*nv];
+    for(j=0; j<nv; j++)
+	ri[j] = mlo[i]*c[i-1][vid[j]] + mdi[i]*c[i][vid[j]] - src_bot;
+
+    /* Forward and back substitution for all variables */
+    for(j=0; j<nv; j++)
+	c[0][vid[j]] = mrhs[j]/mdiv[0];
+    for(i=1; i<n; i++) {
+	ri = &mrhs[i*nv];
+	for(j=0; j<nv; j++)
+	    c[i][vid[j]] = (ri[j]-mCm1[i]*c[i-1][vid[j]])/mdiv[i];
+    }
+    for(i=n-2; i>=0; i--) {
+	for(j=0; j<nv; j++)
+	    c[i][vid[j]] -= mud[i+1]*c[i+1][vid[j]];
+    }
+}
+
+
 /*
   Routine to solve tridiagonal system of equations
   Arguments:
@@ -210,4 +364,7 @@ void free_diffusion1d(int dummy) {
 		free1d(rhs);
 		free1d(ud);
 	}
+
+	if (mwork != NULL)
+		free1d(mwork);
 }
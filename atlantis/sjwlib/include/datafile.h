@@ -334,6 +334,16 @@ struct Datafile {
     Dimension *dimensions; /* Dimensions */
     int na;		/* Number of attributes */
     Attribute *attributes;	/* Unsupported attributes */
+
+    /* Last record bracket found by dfFindRecord. Model time moves
+     * forward, so the next request is usually for the same time or
+     * in the same or next interval. */
+    int cursor_ok;	/* Non-zero if the values below are valid */
+    double cursor_r;	/* Record value last asked for */
+    int cursor_before;	/* Record index before cursor_r */
+    int cursor_after;	/* Record index after cursor_r */
+    double cursor_frac;	/* Fraction of the record interval */
+    int cursor_ret;	/* dfFindRecord return value for cursor_r */
 };
 
 
@@ -343,6 +353,7 @@ void    dfSetRecord(Datafile *df, int varid);
 double  dfEval(Datafile *df, Variable *v, double r);
 double  dfEvalEx(Datafile *df, Variable *v, double r);
 double  dfEvalCoords(Datafile *df, Variable *v, double r, double coords[]);
+void    dfEvalAll(Datafile *df, double r, double *vals);
 int	dfGetNumVariables(Datafile *df);
 Variable *dfGetVariable(Datafile *df, int varid);
 Variable *dfGetVariableByName(Datafile *df, const char *name);
@@ -355,6 +366,7 @@ int     dfIndex(Datafile *df, const char *varname);
 void    dfCheckRecords(Datafile *df);
 void    dfPrintInfo(Datafile *df, FILE *fp, int level);
 int     dfFindRecord(Datafile *df, double r, int *before, int *after, double *frac);
+void    dfResetCursor(Datafile *df);
 int     dfFindTime(Datafile *df, double r, int rwind, double *newt);
 void    dfReadRecords(Datafile *df, Variable *v, int start_rec, int nrecs);
 void    dfReadRecord(Datafile *df, Variable *v, int start_rec);
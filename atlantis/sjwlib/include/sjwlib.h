@@ -141,6 +141,9 @@ double  decay_centered(double c,double k,double dt);
 double  decay_backward(double c,double k,double dt);
 double  decay_exact(double c,double k,double dt);
 void    diffusion1d(int n, double *c, double *xc, double *k, double *xk, double dt, double a);
+void    diffusion1d_multi(int n, double **c, int *vid, int nv, double *xc, double *k, double *xk, double dt, double a, double *work);
+/* Size of the work array needed by diffusion1d_multi */
+#define DIFFUSION1D_MULTI_NWORK(n,nv) (8*((n)+1) + (n)*(nv))
 
 void    free_diffusion1d(int dummy);
 
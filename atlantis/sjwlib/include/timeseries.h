@@ -59,6 +59,8 @@ void    tsSetDefaultGeoType(char *type);
 double  tsEval(TimeSeries *ts, int varid, double t);
 double  tsEvalEx(TimeSeries *ts, int varid, double t);
 double  tsEvalR(TimeSeries *ts, int varid, double t, int rwindid);
+void    tsEvalAll(TimeSeries *ts, double t, double *vals);
+void    tsEvalAllR(TimeSeries *ts, double t, int rwindid, double *vals);
 double  tsEvalXY(TimeSeries *ts, int varid, double t, double x, double y);
 double  tsEvalXYR(TimeSeries *ts, int varid, double t, double x, double y, int rwindid);
 double  tsEvalXYZ(TimeSeries *ts, int varid, double t, double x, double y, double z);
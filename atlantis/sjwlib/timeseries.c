@@ -71,6 +71,10 @@
  Changed tsEvalXYR to store the value ATT_TEXT(gt) to a local
  char * variable before calling strcmpcase to remove a complier warning.
 
+ Added tsEvalAll and tsEvalAllR to evaluate all the variables
+ of a series at one time. Record searches now start from the
+ last bracket found (see dfFindRecord).
+
  $Id: timeseries.c 3417 2012-09-24 04:34:46Z gor171 $
  */
 
@@ -244,6 +248,34 @@ double tsEvalR(TimeSeries *ts, int id, double t, int rwindid) {
 		return dfEval(ts->df, v, t);
 }
 
+/** Evaluate every variable of a time series at a specified time.
+ * The time records are only searched once, rather than once per
+ * variable, and each value is the same as tsEvalR() gives.
+ *
+ * @param ts pointer to time series structure
+ * @param t time value
+ * @param rwindid non-zero to recycle the series if t is past its end
+ * @param vals returned values, one per variable (ts->nv values)
+ *
+ * Calls quit() if something goes wrong.
+ */
+void tsEvalAllR(TimeSeries *ts, double t, int rwindid, double *vals) {
+	double newt = t;
+
+	if (ts == NULL)
+		quit("tsEvalAllR: NULL TimeSeries pointer\n");
+
+	if (rwindid && (dfFindTime(ts->df, t, rwindid, &newt) == 1))
+		dfEvalAll(ts->df, newt, vals);
+	else
+		dfEvalAll(ts->df, t, vals);
+}
+
+void tsEvalAll(TimeSeries *ts, double t, double *vals) {
+	/* As no rewinding specified, assume none wanted */
+	tsEvalAllR(ts, t, 0, vals);
+}
+
 double tsEvalEx(TimeSeries *ts, int id, double t)
 /* When do not want interpolation */
 {
@@ -602,6 +634,7 @@ void tsNewTimeUnits(TimeSeries *ts, char *newunits) {
 	Datafile *df = ts->df;
 
 	ChangeTimeUnits(ts->t_units, newunits, df->records, (int)df->nrecords);
+	dfResetCursor(df);
 
 	/* Store new units in time series */
 	if ((ts->t_units = (char *) realloc((void *) ts->t_units, strlen(newunits) + 1)) == NULL)